@@ -72,6 +72,9 @@ def _get_cache_opts(level, options):
     if hasattr(options, prefetcher_attr):
         opts["prefetcher"] = _get_hwp(getattr(options, prefetcher_attr))
 
+    if getattr(options, "warm_cache_checkpoints", False):
+        opts["warm_checkpoint"] = True
+
     return opts
 
 
@@ -197,6 +197,12 @@ def addNoISAOptions(parser):
     parser.add_argument("--l2_assoc", type=int, default=8)
     parser.add_argument("--l3_assoc", type=int, default=16)
     parser.add_argument("--cacheline_size", type=int, default=64)
+    parser.add_argument(
+        "--warm-cache-checkpoints",
+        action="store_true",
+        help="Record the clean contents of the classic caches in checkpoints "
+        "and refill them on restore, so that simulation resumes warm",
+    )
 
     # Enable Ruby
     parser.add_argument("--ruby", action="store_true")
@@ -59,11 +59,15 @@ def config_cache(args, system):
     """
     from common.CacheConfig import _get_cache_opts
 
-    system.l1i = L1_ICache(**_get_cache_opts("l1i", args))
-    system.l1d = L1_DCache(**_get_cache_opts("l1d", args))
+    # The L1s of a single Trace CPU stay at the system level, where their
+    # stats have always been, while several Trace CPUs each hold their own
+    l1_parents = [system] if len(system.cpu) == 1 else system.cpu
+    for cpu, parent in zip(system.cpu, l1_parents):
+        parent.l1i = L1_ICache(**_get_cache_opts("l1i", args))
+        parent.l1d = L1_DCache(**_get_cache_opts("l1d", args))
 
-    system.cpu.dcache_port = system.l1d.cpu_side
-    system.cpu.icache_port = system.l1i.cpu_side
+        cpu.dcache_port = parent.l1d.cpu_side
+        cpu.icache_port = parent.l1i.cpu_side
 
     if args.l2cache:
         # Provide a clock for the L2 and the L1-to-L2 bus here as they
@@ -77,73 +81,134 @@ def config_cache(args, system):
         system.l2.cpu_side = system.tol2bus.mem_side_ports
         system.l2.mem_side = system.membus.cpu_side_ports
 
-        system.l1i.mem_side = system.tol2bus.cpu_side_ports
-        system.l1d.mem_side = system.tol2bus.cpu_side_ports
+        l1_bus = system.tol2bus
     else:
-        system.l1i.mem_side = system.membus.cpu_side_ports
-        system.l1d.mem_side = system.membus.cpu_side_ports
+        l1_bus = system.membus
 
+    for parent in l1_parents:
+        parent.l1i.mem_side = l1_bus.cpu_side_ports
+        parent.l1d.mem_side = l1_bus.cpu_side_ports
 
-parser = argparse.ArgumentParser()
-Options.addCommonOptions(parser)
 
-if "--ruby" in sys.argv:
-    print(
-        "This script does not support Ruby configuration, mainly"
-        " because Trace CPU has been tested only with classic memory system"
+def trace_files(trace_list, np):
+    """
+    Split a semicolon separated list of trace files into one file per
+    Trace CPU.
+    """
+    files = trace_list.split(";")
+    if len(files) != np:
+        fatal(f"{np} Trace CPUs need {np} trace files, got '{trace_list}'.")
+    return files
+
+
+def build_system(args, inst_traces, data_traces):
+    """
+    Build a system with a Trace CPU for each pair of instruction and data
+    trace files, sharing a classic cache hierarchy and memory.
+    """
+    system = System(
+        mem_mode=TraceCPU.memory_mode(),
+        mem_ranges=[AddrRange(args.mem_size)],
+        cache_line_size=args.cacheline_size,
     )
-    sys.exit(1)
 
-args = parser.parse_args()
+    # Generate the Trace CPUs, replaying one pair of per-core traces each
+    system.cpu = [TraceCPU() for _ in inst_traces]
 
-if args.num_cpus > 1:
-    fatal("This script does not support multi-processor trace replay.\n")
+    # Create a top-level voltage domain
+    system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
 
-system = System(
-    mem_mode=TraceCPU.memory_mode(),
-    mem_ranges=[AddrRange(args.mem_size)],
-    cache_line_size=args.cacheline_size,
-)
+    # Create a source clock for the system. This is used as the clock period
+    # for xbar and memory
+    system.clk_domain = SrcClockDomain(
+        clock=args.sys_clock, voltage_domain=system.voltage_domain
+    )
 
-# Generate the TraceCPU
-system.cpu = TraceCPU()
+    # Create a CPU voltage domain
+    system.cpu_voltage_domain = VoltageDomain()
 
-# Create a top-level voltage domain
-system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
+    # Create a separate clock domain for the CPUs. In case of Trace CPUs this
+    # clock is actually used only by the caches connected to the CPU.
+    system.cpu_clk_domain = SrcClockDomain(
+        clock=args.cpu_clock, voltage_domain=system.cpu_voltage_domain
+    )
 
-# Create a source clock for the system. This is used as the clock period for
-# xbar and memory
-system.clk_domain = SrcClockDomain(
-    clock=args.sys_clock, voltage_domain=system.voltage_domain
-)
+    # All cpus belong to a common cpu_clk_domain, therefore running at a
+    # common frequency.
+    for cpu in system.cpu:
+        cpu.clk_domain = system.cpu_clk_domain
 
-# Create a CPU voltage domain
-system.cpu_voltage_domain = VoltageDomain()
+    # Assign input trace files to the Trace CPUs
+    for cpu, inst_trace, data_trace in zip(
+        system.cpu, inst_traces, data_traces
+    ):
+        cpu.instTraceFile = inst_trace
+        cpu.dataTraceFile = data_trace
 
-# Create a separate clock domain for the CPUs. In case of Trace CPUs this clock
-# is actually used only by the caches connected to the CPU.
-system.cpu_clk_domain = SrcClockDomain(
-    clock=args.cpu_clock, voltage_domain=system.cpu_voltage_domain
+    # Configure the classic memory system args
+    system.membus = SystemXBar()
+    system.system_port = system.membus.cpu_side_ports
+
+    # Configure the classic cache hierarchy
+    config_cache(args, system)
+
+    MemConfig.config_mem(args, system)
+
+    return system
+
+
+parser = argparse.ArgumentParser()
+Options.addCommonOptions(parser)
+
+if "--ruby" in sys.argv:
+    print(
+        "This script does not support Ruby configuration, mainly"
+        " because Trace CPU has been tested only with classic memory system"
+    )
+    sys.exit(1)
+
+parser.add_argument(
+    "--parallel-replay",
+    action="store_true",
+    help="""Give each Trace CPU a private system, with its own caches and
+                      memory, on a separate event queue, and thus a separate
+                      thread.""",
 )
 
-# All cpus belong to a common cpu_clk_domain, therefore running at a common
-# frequency.
-for cpu in system.cpu:
-    cpu.clk_domain = system.cpu_clk_domain
+args = parser.parse_args()
+np = args.num_cpus
 
-# Assign input trace files to the Trace CPU
-system.cpu.instTraceFile = args.inst_trace_file
-system.cpu.dataTraceFile = args.data_trace_file
+inst_traces = trace_files(args.inst_trace_file, np)
+data_traces = trace_files(args.data_trace_file, np)
 
-# Configure the classic memory system args
+# Set the memory class once, for every system built below
 MemClass = Simulation.setMemClass(args)
-system.membus = SystemXBar()
-system.system_port = system.membus.cpu_side_ports
 
-# Configure the classic cache hierarchy
-config_cache(args, system)
-
-MemConfig.config_mem(args, system)
+if args.parallel_replay and np > 1:
+    # The classic caches, crossbars and memory controllers are not thread
+    # safe, so the Trace CPUs don't share any of them. Each one replays its
+    # traces in a system of its own, with a private copy of the cache
+    # hierarchy and memory, simulated on its own event queue. The systems
+    # never communicate, and the quantum only bounds how far apart their
+    # local times drift.
+    if args.prog_interval or args.maxinsts:
+        fatal(
+            "--parallel-replay doesn't support --prog-interval or "
+            "--maxinsts."
+        )
 
-root = Root(full_system=False, system=system)
-Simulation.run(args, root, system, None)
+    systems = [
+        build_system(args, [inst_trace], [data_trace])
+        for inst_trace, data_trace in zip(inst_traces, data_traces)
+    ]
+    for i, system in enumerate(systems):
+        system.eventq_index = i
+
+    root = Root(full_system=False, system=systems)
+    root.sim_quantum = int(1e6)  # 1 us
+    Simulation.run(args, root, systems[0], None)
+else:
+    system = build_system(args, inst_traces, data_traces)
+
+    root = Root(full_system=False, system=system)
+    Simulation.run(args, root, system, None)
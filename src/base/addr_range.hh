@@ -294,7 +294,7 @@ class AddrRange
     granularity() const
     {
         if (interleaved()) {
-            auto combined_mask = 0;
+            Addr combined_mask = 0;
             for (auto mask: masks) {
                 combined_mask |= mask;
             }
@@ -412,6 +412,25 @@ TEST(AddrRangeTest, TwoInterleavingMasks)
     EXPECT_EQ("[0:0xffff] a[0]^\b=1 a[1]^\b=1", r.to_string());
 }
 
+TEST(AddrRangeTest, HighInterleavingMasks)
+{
+    Addr start = 0x000000000;
+    Addr end   = 0x800000000;
+    std::vector<Addr> masks;
+    /*
+     * The mask only has bits above the lower 32 bits of an address.
+     */
+    masks.push_back(1ULL << 33);
+    uint8_t intlv_match = 0;
+
+    AddrRange r(start, end, masks, intlv_match);
+    EXPECT_TRUE(r.interleaved());
+    /*
+     * The stripes created by bit 33 are 8GiB wide.
+     */
+    EXPECT_EQ(1ULL << 33, r.granularity());
+}
+
 TEST(AddrRangeTest, ComplexInterleavingMasks)
 {
     Addr start = 0x0000;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/async_writer.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+AsyncWriter::AsyncWriter(std::ostream &_stream, size_t ring_size)
+    : stream(_stream),
+      ringSize(size_t(1) << ceilLog2(std::max<size_t>(ring_size, 4096))),
+      head(0), tail(0), flushed(0), stopping(false)
+{
+    ring.reset(new char[ringSize]);
+    writer = std::thread([this]() { writerMain(); });
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    stopping = true;
+    wake.notify_one();
+    writer.join();
+}
+
+void
+AsyncWriter::push(const char *data, size_t len)
+{
+    uint64_t pos = head.load(std::memory_order_relaxed);
+
+    while (len) {
+        const size_t space =
+            ringSize - (pos - tail.load(std::memory_order_acquire));
+        if (!space) {
+            // the writer is behind, wait for it
+            wake.notify_one();
+            std::this_thread::yield();
+            continue;
+        }
+
+        const size_t n = std::min(len, space);
+        const size_t offset = pos & (ringSize - 1);
+        const size_t first = std::min(n, ringSize - offset);
+        std::memcpy(&ring[offset], data, first);
+        std::memcpy(&ring[0], data + first, n - first);
+
+        pos += n;
+        data += n;
+        len -= n;
+        head.store(pos, std::memory_order_release);
+    }
+
+    // the writer polls the ring, only wake it early if it fills up
+    if (pos - tail.load(std::memory_order_relaxed) > ringSize / 2)
+        wake.notify_one();
+}
+
+void
+AsyncWriter::writerMain()
+{
+    uint64_t pos = tail.load(std::memory_order_relaxed);
+
+    while (true) {
+        const uint64_t end = head.load(std::memory_order_acquire);
+        if (end == pos) {
+            if (flushed.load(std::memory_order_relaxed) != pos) {
+                stream.flush();
+                flushed.store(pos, std::memory_order_release);
+            }
+            if (stopping.load(std::memory_order_acquire) &&
+                    head.load(std::memory_order_acquire) == pos) {
+                break;
+            }
+
+            std::unique_lock<std::mutex> lock(wakeLock);
+            wake.wait_for(lock, std::chrono::milliseconds(1));
+            continue;
+        }
+
+        const size_t offset = pos & (ringSize - 1);
+        const size_t n = std::min<uint64_t>(end - pos, ringSize - offset);
+        stream.write(&ring[offset], n);
+
+        pos += n;
+        tail.store(pos, std::memory_order_release);
+    }
+}
+
+void
+AsyncWriter::flush()
+{
+    const uint64_t end = head.load(std::memory_order_acquire);
+    while (flushed.load(std::memory_order_acquire) < end) {
+        wake.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_ASYNC_WRITER_HH__
+#define __BASE_ASYNC_WRITER_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+namespace gem5
+{
+
+/**
+ * Writes data to a stream from a background thread. Data is copied
+ * to a lock-free ring buffer that a writer thread drains into the
+ * stream, so the caller doesn't wait for the stream unless the ring
+ * is full. The ring has a single producer: callers that push from
+ * several threads must serialize themselves.
+ */
+class AsyncWriter
+{
+  public:
+    /**
+     * @param stream The stream to write to.
+     * @param ring_size Size of the ring buffer in bytes, rounded up to
+     * a power of two.
+     */
+    AsyncWriter(std::ostream &stream, size_t ring_size = 4 << 20);
+
+    /** Write all remaining data and stop the writer thread. */
+    ~AsyncWriter();
+
+    /** Copy data to the ring, waiting for space if it is full. */
+    void push(const char *data, size_t len);
+
+    /**
+     * Wait until all data pushed so far has been written to the
+     * stream, and flush it.
+     */
+    void flush();
+
+    /** @return The size of the ring buffer in bytes. */
+    size_t size() const { return ringSize; }
+
+  private:
+    /** The main loop of the writer thread. */
+    void writerMain();
+
+    std::ostream &stream;
+
+    /** The ring buffer, indexed by positions modulo its size. */
+    std::unique_ptr<char[]> ring;
+    const size_t ringSize;
+    /** Position the next data will be written to. */
+    std::atomic<uint64_t> head;
+    /** Position the writer thread will read from next. */
+    std::atomic<uint64_t> tail;
+    /** Position up to which the output stream has been flushed. */
+    std::atomic<uint64_t> flushed;
+
+    /** Set when the writer thread should exit once the ring is empty. */
+    std::atomic<bool> stopping;
+    std::mutex wakeLock;
+    std::condition_variable wake;
+    std::thread writer;
+};
+
+} // namespace gem5
+
+#endif // __BASE_ASYNC_WRITER_HH__
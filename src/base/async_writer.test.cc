@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "base/async_writer.hh"
+
+using namespace gem5;
+
+TEST(AsyncWriterTest, Flush)
+{
+    std::ostringstream out;
+    AsyncWriter writer(out);
+    writer.push("abc", 3);
+    writer.flush();
+    EXPECT_EQ(out.str(), "abc");
+
+    writer.push("def", 3);
+    writer.flush();
+    EXPECT_EQ(out.str(), "abcdef");
+}
+
+TEST(AsyncWriterTest, Size)
+{
+    std::ostringstream out;
+    EXPECT_EQ(AsyncWriter(out, 0).size(), 4096u);
+    EXPECT_EQ(AsyncWriter(out, 5000).size(), 8192u);
+    EXPECT_EQ(AsyncWriter(out, 1 << 20).size(), 1u << 20);
+}
+
+/** Data larger than the ring is written in order when the ring wraps. */
+TEST(AsyncWriterTest, Wrap)
+{
+    std::string expected;
+    std::ostringstream out;
+    {
+        AsyncWriter writer(out, 4096);
+        for (int i = 0; i < 10000; ++i) {
+            const std::string chunk = std::to_string(i) + ",";
+            writer.push(chunk.data(), chunk.size());
+            expected += chunk;
+        }
+        const std::string big(10000, 'z');
+        writer.push(big.data(), big.size());
+        expected += big;
+    }
+    EXPECT_EQ(out.str(), expected);
+}
@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_inifile.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include "base/inifile.hh"
+#include "base/logging.hh"
+#include "base/str.hh"
+
+namespace gem5
+{
+
+const char BinaryIniFile::magic[8] = {'g', 'e', 'm', '5', 'c', 'p', 't', 'b'};
+
+namespace
+{
+
+/** Fixed file header, see BinaryIniFile for the layout. */
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numSections;
+    uint64_t dirOffset;
+    uint64_t dirSize;
+};
+
+static_assert(sizeof(Header) == 32, "Unexpected binary ini header size");
+
+/** Bounds checked sequential reader over the mapped file. */
+class Cursor
+{
+  private:
+    const char *pos;
+    const char *end;
+
+  public:
+    Cursor(const char *_pos, size_t size) : pos(_pos), end(_pos + size) {}
+
+    bool done() const { return pos == end; }
+
+    template <class T>
+    bool
+    get(T &value)
+    {
+        if (end - pos < (ptrdiff_t)sizeof(T))
+            return false;
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool
+    skip(uint64_t bytes, const char *&start)
+    {
+        if ((uint64_t)(end - pos) < bytes)
+            return false;
+        start = pos;
+        pos += bytes;
+        return true;
+    }
+};
+
+template <class T>
+void
+put(std::string &buf, const T &value)
+{
+    buf.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Parse a value made of space separated decimal integers. The value is
+ * only accepted if rendering the integers back yields the exact same
+ * text, so that find() on the typed value is indistinguishable from the
+ * original string.
+ */
+bool
+parseIntArray(const std::string &value, std::vector<int64_t> &ints)
+{
+    ints.clear();
+    if (value.empty())
+        return false;
+
+    size_t pos = 0;
+    while (true) {
+        size_t next = value.find(' ', pos);
+        size_t len = (next == std::string::npos ? value.size() : next) - pos;
+        if (len == 0 || len > 20)
+            return false;
+
+        const char *tok = value.data() + pos;
+        bool neg = tok[0] == '-';
+        if (neg && len == 1)
+            return false;
+        // No leading zeros (except "0" itself), no "-0".
+        if (tok[neg] == '0' && (len > 1 || neg))
+            return false;
+
+        uint64_t mag = 0;
+        for (size_t i = neg; i < len; i++) {
+            if (tok[i] < '0' || tok[i] > '9')
+                return false;
+            uint64_t digit = tok[i] - '0';
+            if (mag > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+                return false;
+            mag = mag * 10 + digit;
+        }
+
+        const uint64_t limit = (uint64_t)std::numeric_limits<int64_t>::max();
+        if (mag > limit + (neg ? 1 : 0))
+            return false;
+        ints.push_back(neg ? (int64_t)(0 - mag) : (int64_t)mag);
+
+        if (next == std::string::npos)
+            return true;
+        pos = next + 1;
+    }
+}
+
+} // anonymous namespace
+
+std::string
+BinaryIniFile::Entry::str() const
+{
+    if (type == ValueType::String)
+        return std::string(payload, count);
+
+    std::string value;
+    value.reserve(count * 4);
+    for (uint32_t i = 0; i < count; i++) {
+        int64_t v;
+        std::memcpy(&v, payload + i * sizeof(v), sizeof(v));
+        if (i)
+            value += ' ';
+        value += std::to_string(v);
+    }
+    return value;
+}
+
+void
+BinaryIniFile::Entry::ints(std::vector<int64_t> &values) const
+{
+    values.resize(count);
+    if (count)
+        std::memcpy(values.data(), payload, count * sizeof(int64_t));
+}
+
+BinaryIniFile::BinaryIniFile()
+{}
+
+BinaryIniFile::~BinaryIniFile()
+{
+    unmap();
+}
+
+void
+BinaryIniFile::unmap()
+{
+    table.clear();
+    if (data)
+        munmap(const_cast<char *>(data), dataSize);
+    data = nullptr;
+    dataSize = 0;
+}
+
+bool
+BinaryIniFile::isBinary(const std::string &file)
+{
+    std::ifstream f(file, std::ios::binary);
+    char buf[sizeof(magic)];
+    return f.read(buf, sizeof(buf)) &&
+        std::memcmp(buf, magic, sizeof(magic)) == 0;
+}
+
+bool
+BinaryIniFile::load(const std::string &file)
+{
+    unmap();
+
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+
+    void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return false;
+
+    data = static_cast<const char *>(map);
+    dataSize = st.st_size;
+
+    Header hdr;
+    std::memcpy(&hdr, data, sizeof(hdr));
+    if (std::memcmp(hdr.magic, magic, sizeof(magic)) != 0 ||
+            hdr.version != version || hdr.dirOffset > dataSize ||
+            hdr.dirSize > dataSize - hdr.dirOffset) {
+        unmap();
+        return false;
+    }
+
+    table.reserve(hdr.numSections);
+    Cursor dir(data + hdr.dirOffset, hdr.dirSize);
+    for (uint32_t i = 0; i < hdr.numSections; i++) {
+        uint32_t name_len;
+        const char *name;
+        Section section;
+        if (!dir.get(name_len) || !dir.skip(name_len, name) ||
+                !dir.get(section.offset) || !dir.get(section.size) ||
+                section.offset > dataSize ||
+                section.size > dataSize - section.offset) {
+            unmap();
+            return false;
+        }
+        table.emplace(std::string_view(name, name_len), std::move(section));
+    }
+
+    return true;
+}
+
+bool
+BinaryIniFile::indexSection(Section &section)
+{
+    Cursor cur(data + section.offset, section.size);
+    uint32_t num_entries;
+    if (!cur.get(num_entries))
+        return false;
+
+    section.order.reserve(num_entries);
+    section.table.reserve(num_entries);
+    for (uint32_t i = 0; i < num_entries; i++) {
+        uint8_t type;
+        uint32_t key_len;
+        Entry entry;
+        const char *key;
+        if (!cur.get(type) || !cur.get(key_len) || !cur.get(entry.count) ||
+                !cur.skip(key_len, key)) {
+            return false;
+        }
+
+        uint64_t payload_size;
+        if (type == (uint8_t)ValueType::String)
+            payload_size = entry.count;
+        else if (type == (uint8_t)ValueType::IntArray)
+            payload_size = (uint64_t)entry.count * sizeof(int64_t);
+        else
+            return false;
+
+        entry.type = (ValueType)type;
+        if (!cur.skip(payload_size, entry.payload))
+            return false;
+
+        // As in IniFile, a repeated key overrides the earlier value
+        std::string_view name(key, key_len);
+        section.order.emplace_back(name, entry);
+        section.table.insert_or_assign(name, entry);
+    }
+
+    section.indexed = true;
+    return true;
+}
+
+const BinaryIniFile::Section *
+BinaryIniFile::findSection(const std::string &sectionName)
+{
+    auto i = table.find(sectionName);
+    if (i == table.end())
+        return nullptr;
+
+    Section &section = i->second;
+    fatal_if(!section.indexed && !indexSection(section),
+             "Corrupt binary checkpoint section %s\n", sectionName);
+    return &section;
+}
+
+const BinaryIniFile::Entry *
+BinaryIniFile::findEntry(const std::string &sectionName,
+                         const std::string &entryName)
+{
+    const Section *section = findSection(sectionName);
+    if (!section)
+        return nullptr;
+
+    auto i = section->table.find(entryName);
+    return i == section->table.end() ? nullptr : &i->second;
+}
+
+bool
+BinaryIniFile::find(const std::string &section, const std::string &entry,
+                    std::string &value)
+{
+    const Entry *e = findEntry(section, entry);
+    if (!e)
+        return false;
+
+    value = e->str();
+    return true;
+}
+
+bool
+BinaryIniFile::findArray(const std::string &section, const std::string &entry,
+                         std::vector<int64_t> &values)
+{
+    const Entry *e = findEntry(section, entry);
+    if (!e || e->type != ValueType::IntArray)
+        return false;
+
+    e->ints(values);
+    return true;
+}
+
+bool
+BinaryIniFile::entryExists(const std::string &section,
+                           const std::string &entry)
+{
+    return findEntry(section, entry) != nullptr;
+}
+
+bool
+BinaryIniFile::sectionExists(const std::string &section) const
+{
+    return table.find(section) != table.end();
+}
+
+void
+BinaryIniFile::getSectionNames(std::vector<std::string> &list) const
+{
+    for (const auto &section : table)
+        list.emplace_back(section.first);
+}
+
+void
+BinaryIniFile::visitSection(const std::string &sectionName,
+                            VisitSectionCallback cb)
+{
+    const Section *section = findSection(sectionName);
+    if (!section)
+        return;
+
+    for (const auto &pair : section->order)
+        cb(std::string(pair.first), pair.second.str());
+}
+
+bool
+BinaryIniFile::write(IniFile &ini, const std::string &file)
+{
+    Writer writer;
+    if (!writer.open(file))
+        return false;
+
+    std::vector<std::string> names;
+    ini.getSectionNames(names);
+    std::sort(names.begin(), names.end());
+
+    std::vector<std::pair<std::string, std::string>> entries;
+    for (const auto &name : names) {
+        entries.clear();
+        ini.visitSection(name,
+            [&entries](const std::string &key, const std::string &value)
+            {
+                entries.emplace_back(key, value);
+            });
+        std::sort(entries.begin(), entries.end());
+
+        writer.section(name);
+        for (const auto &[key, value] : entries)
+            writer.entry(key, value);
+    }
+
+    return writer.close();
+}
+
+void
+BinaryIniFile::Writer::fail(const std::string &msg)
+{
+    if (errorMsg.empty())
+        errorMsg = fileName + ": " + msg;
+}
+
+bool
+BinaryIniFile::Writer::open(const std::string &file)
+{
+    fileName = file;
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        fail("could not create file");
+        return false;
+    }
+
+    // The header is rewritten with the directory location by close()
+    Header hdr = {};
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    offset = sizeof(hdr);
+    return true;
+}
+
+void
+BinaryIniFile::Writer::section(const std::string &name)
+{
+    finishSection();
+
+    if (!written.insert(name).second)
+        fail("section " + name + " appears more than once");
+
+    inSection = true;
+    sectionName = name;
+    body.clear();
+    put(body, (uint32_t)0);
+    numEntries = 0;
+}
+
+void
+BinaryIniFile::Writer::entry(const std::string &key, const std::string &value)
+{
+    if (!inSection) {
+        fail("entry " + key + " outside of a section");
+        return;
+    }
+
+    bool typed = parseIntArray(value, ints);
+    put(body, (uint8_t)(typed ? ValueType::IntArray : ValueType::String));
+    put(body, (uint32_t)key.size());
+    put(body, (uint32_t)(typed ? ints.size() : value.size()));
+    body += key;
+    if (typed) {
+        body.append(reinterpret_cast<const char *>(ints.data()),
+                    ints.size() * sizeof(int64_t));
+    } else {
+        body += value;
+    }
+    numEntries++;
+}
+
+void
+BinaryIniFile::Writer::finishSection()
+{
+    if (!inSection)
+        return;
+
+    std::memcpy(body.data(), &numEntries, sizeof(numEntries));
+    out.write(body.data(), body.size());
+
+    put(dir, (uint32_t)sectionName.size());
+    dir += sectionName;
+    put(dir, offset);
+    put(dir, (uint64_t)body.size());
+    offset += body.size();
+    numSections++;
+
+    inSection = false;
+}
+
+void
+BinaryIniFile::Writer::parseLine()
+{
+    // Mirror IniFile::load(): leading whitespace and trailing spaces are
+    // not part of the line, and lines before the first section are
+    // ignored
+    size_t start = 0;
+    while (start < line.size() && std::isspace((unsigned char)line[start]))
+        start++;
+    line.erase(0, start);
+    eat_end_white(line);
+    if (line.empty())
+        return;
+
+    if (line.front() == '[' && line.back() == ']') {
+        std::string name = line.substr(1, line.size() - 2);
+        eat_white(name);
+        section(name);
+        return;
+    }
+
+    if (!inSection)
+        return;
+
+    size_t eq = line.find('=');
+    if (eq == std::string::npos) {
+        fail("can't parse line " + line);
+        return;
+    }
+    if (eq > 0 && line[eq - 1] == '+') {
+        fail("appending to entries is not supported: " + line);
+        return;
+    }
+
+    std::string key = line.substr(0, eq);
+    std::string value = line.substr(eq + 1);
+    eat_white(key);
+    eat_white(value);
+    entry(key, value);
+}
+
+BinaryIniFile::Writer::int_type
+BinaryIniFile::Writer::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+
+    char ch = traits_type::to_char_type(c);
+    xsputn(&ch, 1);
+    return c;
+}
+
+std::streamsize
+BinaryIniFile::Writer::xsputn(const char *s, std::streamsize n)
+{
+    const char *end = s + n;
+    while (s != end) {
+        const char *nl = static_cast<const char *>(
+            std::memchr(s, '\n', end - s));
+        if (!nl) {
+            line.append(s, end);
+            break;
+        }
+        line.append(s, nl);
+        parseLine();
+        line.clear();
+        s = nl + 1;
+    }
+    return n;
+}
+
+bool
+BinaryIniFile::Writer::close()
+{
+    if (!line.empty()) {
+        parseLine();
+        line.clear();
+    }
+    finishSection();
+
+    out.write(dir.data(), dir.size());
+
+    Header hdr;
+    std::memcpy(hdr.magic, magic, sizeof(magic));
+    hdr.version = version;
+    hdr.numSections = numSections;
+    hdr.dirOffset = offset;
+    hdr.dirSize = dir.size();
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    out.close();
+
+    if (!out)
+        fail("write error");
+    return errorMsg.empty();
+}
+
+} // namespace gem5
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_INIFILE_HH__
+#define __BASE_BINARY_INIFILE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file
+ * Declaration of BinaryIniFile, a memory-mapped binary alternative to
+ * the text based IniFile used for checkpoints.
+ */
+
+namespace gem5
+{
+
+class IniFile;
+
+/**
+ * A read-only, memory-mapped binary representation of an IniFile.
+ *
+ * The file starts with a fixed header followed by the section bodies
+ * and a section directory. Opening a file only maps it and reads the
+ * directory; the entries of a section are indexed the first time the
+ * section is looked up, so restoring a checkpoint only touches the
+ * sections that are actually unserialized.
+ *
+ * Values are either plain strings or typed arrays of 64 bit integers.
+ * Typed arrays are created by the writer for values that consist only
+ * of space separated decimal integers (e.g. the output of
+ * arrayParamOut()), and can be read back without any text parsing
+ * through findArray(). When read through find() they are rendered to
+ * the exact text they were created from.
+ *
+ * Layout (all integers are stored in host byte order):
+ *
+ * @verbatim
+ *   header:    magic[8] version:u32 num_sections:u32
+ *              dir_offset:u64 dir_size:u64
+ *   section:   num_entries:u32
+ *              { type:u8 key_len:u32 count:u32 key[key_len] payload }*
+ *   directory: { name_len:u32 name[name_len] offset:u64 size:u64 }*
+ * @endverbatim
+ *
+ * The payload of a string entry is count bytes of text; the payload of
+ * an integer array is count 64 bit signed integers.
+ */
+class BinaryIniFile
+{
+  public:
+    /** Type tag of an entry value. */
+    enum class ValueType : uint8_t
+    {
+        String = 0,
+        IntArray = 1,
+    };
+
+    /** Magic identifying a binary ini file. */
+    static const char magic[8];
+
+    /** Format version written by this implementation. */
+    static constexpr uint32_t version = 1;
+
+  protected:
+    /** A single key/value pair, pointing into the mapped file. */
+    struct Entry
+    {
+        ValueType type;
+        uint32_t count;
+        const char *payload;
+
+        /** Render the value as the text IniFile would have stored. */
+        std::string str() const;
+
+        /** Copy out the value of an integer array. */
+        void ints(std::vector<int64_t> &values) const;
+    };
+
+    /** EntryTable type. Keys point into the mapped file. */
+    typedef std::unordered_map<std::string_view, Entry> EntryTable;
+
+    /** A section, decoded lazily on first use. */
+    struct Section
+    {
+        uint64_t offset;
+        uint64_t size;
+
+        /** Entries in file order, valid once indexed is set. */
+        std::vector<std::pair<std::string_view, Entry>> order;
+        EntryTable table;
+        bool indexed = false;
+    };
+
+    /** SectionTable type. Keys point into the mapped file. */
+    typedef std::unordered_map<std::string_view, Section> SectionTable;
+
+    SectionTable table;
+
+    /** Base address and size of the mapping. */
+    const char *data = nullptr;
+    size_t dataSize = 0;
+
+    /** Look up a section and index its entries if needed. */
+    const Section *findSection(const std::string &sectionName);
+
+    /** Look up an entry in the given section. */
+    const Entry *findEntry(const std::string &sectionName,
+                           const std::string &entryName);
+
+    /** Build the entry index of a section from the mapped data. */
+    bool indexSection(Section &section);
+
+    /** Release the mapping and all tables. */
+    void unmap();
+
+  public:
+    /**
+     * Writer for the binary format. Each section is encoded as it is
+     * produced and written out when the next one starts, so only the
+     * section directory is kept in memory.
+     *
+     * The writer is also a stream buffer that accepts the text written
+     * by checkpointing, i.e., "[section]" headers followed by "key=value"
+     * lines, so an std::ostream on top of it can be used directly as a
+     * CheckpointOut. Unlike IniFile, a section may only appear once and
+     * "key+=value" lines are not supported.
+     */
+    class Writer : public std::streambuf
+    {
+      private:
+        std::ofstream out;
+        std::string fileName;
+
+        /** Partial text line received through the stream interface. */
+        std::string line;
+
+        /** Whether a section is open, and its encoded entries. */
+        bool inSection = false;
+        std::string sectionName;
+        std::string body;
+        uint32_t numEntries = 0;
+        std::vector<int64_t> ints;
+
+        /** Directory of the sections written so far. */
+        std::string dir;
+        uint32_t numSections = 0;
+        uint64_t offset = 0;
+        std::unordered_set<std::string> written;
+
+        /** Description of the first error, empty if there was none. */
+        std::string errorMsg;
+
+        /** Handle a complete text line. */
+        void parseLine();
+
+        /** Write out the open section, if any. */
+        void finishSection();
+
+        /** Record an error, keeping the first one. */
+        void fail(const std::string &msg);
+
+      protected:
+        int_type overflow(int_type c) override;
+        std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+      public:
+        Writer() = default;
+        Writer(const Writer &) = delete;
+        Writer &operator=(const Writer &) = delete;
+
+        /// Create the file and reserve space for the header.
+        /// @retval True if successful.
+        bool open(const std::string &file);
+
+        /// Start a new section, finishing the previous one.
+        void section(const std::string &name);
+
+        /// Add an entry to the current section.
+        void entry(const std::string &key, const std::string &value);
+
+        /// Finish the last section and write the directory and header.
+        /// @retval True if the whole file was written successfully.
+        bool close();
+
+        /// Description of the first error encountered, if any.
+        const std::string &error() const { return errorMsg; }
+    };
+
+    BinaryIniFile();
+    ~BinaryIniFile();
+
+    BinaryIniFile(const BinaryIniFile &) = delete;
+    BinaryIniFile &operator=(const BinaryIniFile &) = delete;
+
+    /// Map the specified file and read its section directory.
+    /// @param file The path of the file to load.
+    /// @retval True if successful, false if the file could not be
+    /// mapped or is not a valid binary ini file.
+    bool load(const std::string &file);
+
+    /// Check whether the given file starts with the binary ini magic.
+    static bool isBinary(const std::string &file);
+
+    /// Write the contents of an IniFile in binary form.
+    /// @param ini The file to convert.
+    /// @param file The path of the file to write.
+    /// @retval True if successful.
+    static bool write(IniFile &ini, const std::string &file);
+
+    /// Find value corresponding to given section and entry names.
+    /// @retval True if found, false if not.
+    bool find(const std::string &section, const std::string &entry,
+              std::string &value);
+
+    /// Find an integer array stored as a typed value. Plain string
+    /// values are not converted, the caller should fall back to find().
+    /// @retval True if a typed array was found, false if not.
+    bool findArray(const std::string &section, const std::string &entry,
+                   std::vector<int64_t> &values);
+
+    /// Determine whether the entry exists within named section.
+    bool entryExists(const std::string &section, const std::string &entry);
+
+    /// Determine whether the named section exists.
+    bool sectionExists(const std::string &section) const;
+
+    /// Push all section names into the given vector.
+    void getSectionNames(std::vector<std::string> &list) const;
+
+    /// Visitor callback that receives key/value pairs.
+    using VisitSectionCallback = std::function<void(
+        const std::string&, const std::string&)>;
+
+    /// Iterate over key/value pairs of the given section.
+    void visitSection(const std::string &sectionName, VisitSectionCallback cb);
+};
+
+} // namespace gem5
+
+#endif // __BASE_BINARY_INIFILE_HH__
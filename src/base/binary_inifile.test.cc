@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/binary_inifile.hh"
+#include "base/inifile.hh"
+
+using namespace gem5;
+
+namespace {
+
+std::istringstream iniFile(R"ini_file(
+[General]
+   Test1=BARasdf
+   Test2=bar
+
+[Junk]
+Test3=yo
+Test4=mama
+
+[Foo]
+Foo1=89
+Foo2=384
+Foo3=1 -2 3 9223372036854775807 -9223372036854775808
+Foo4=18446744073709551615
+Foo5=007
+Foo6=1  2
+Foo7=
+
+[General]
+Test3=89
+
+[Junk]
+Test4+=mia
+)ini_file");
+
+class BinaryIniTest : public testing::Test
+{
+  protected:
+    std::string path;
+    BinaryIniFile bin;
+
+    void
+    SetUp() override
+    {
+        char name[] = "/tmp/binary_inifile.test.XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+
+        IniFile ini;
+        iniFile.clear();
+        iniFile.seekg(0);
+        ASSERT_TRUE(ini.load(iniFile));
+        ASSERT_TRUE(BinaryIniFile::write(ini, path));
+        ASSERT_TRUE(BinaryIniFile::isBinary(path));
+        ASSERT_TRUE(bin.load(path));
+    }
+
+    void TearDown() override { std::remove(path.c_str()); }
+};
+
+} // anonymous namespace
+
+TEST_F(BinaryIniTest, MatchFound)
+{
+    std::string value;
+
+    ASSERT_TRUE(bin.find("General", "Test2", value));
+    EXPECT_EQ(value, "bar");
+
+    ASSERT_TRUE(bin.find("General", "Test3", value));
+    EXPECT_EQ(value, "89");
+
+    ASSERT_TRUE(bin.find("Junk", "Test4", value));
+    EXPECT_EQ(value, "mama mia");
+}
+
+TEST_F(BinaryIniTest, MatchNotFound)
+{
+    std::string value;
+    EXPECT_FALSE(bin.find("Junk", "test3", value));
+    EXPECT_FALSE(bin.find("Nope", "Test3", value));
+    EXPECT_FALSE(bin.entryExists("Foo", "Foo8"));
+    EXPECT_TRUE(bin.entryExists("Foo", "Foo1"));
+}
+
+TEST_F(BinaryIniTest, Sections)
+{
+    EXPECT_TRUE(bin.sectionExists("General"));
+    EXPECT_TRUE(bin.sectionExists("Junk"));
+    EXPECT_FALSE(bin.sectionExists("junk"));
+
+    std::vector<std::string> names;
+    bin.getSectionNames(names);
+    EXPECT_EQ(names.size(), 3u);
+}
+
+TEST_F(BinaryIniTest, TypedArrays)
+{
+    std::vector<int64_t> ints;
+    ASSERT_TRUE(bin.findArray("Foo", "Foo3", ints));
+    EXPECT_EQ(ints, std::vector<int64_t>({1, -2, 3, INT64_MAX, INT64_MIN}));
+
+    std::string value;
+    ASSERT_TRUE(bin.find("Foo", "Foo3", value));
+    EXPECT_EQ(value, "1 -2 3 9223372036854775807 -9223372036854775808");
+
+    // Values that would not render back identically stay strings.
+    EXPECT_FALSE(bin.findArray("Foo", "Foo4", ints));
+    EXPECT_FALSE(bin.findArray("Foo", "Foo5", ints));
+    EXPECT_FALSE(bin.findArray("Foo", "Foo6", ints));
+    EXPECT_FALSE(bin.findArray("Foo", "Foo7", ints));
+    EXPECT_FALSE(bin.findArray("General", "Test1", ints));
+
+    ASSERT_TRUE(bin.find("Foo", "Foo4", value));
+    EXPECT_EQ(value, "18446744073709551615");
+    ASSERT_TRUE(bin.find("Foo", "Foo5", value));
+    EXPECT_EQ(value, "007");
+    ASSERT_TRUE(bin.find("Foo", "Foo7", value));
+    EXPECT_EQ(value, "");
+}
+
+TEST_F(BinaryIniTest, VisitSection)
+{
+    std::vector<std::string> seen;
+    bin.visitSection("Foo",
+        [&seen](const std::string &key, const std::string &value)
+        {
+            seen.push_back(key + "=" + value);
+        });
+    ASSERT_EQ(seen.size(), 7u);
+    EXPECT_EQ(seen[0], "Foo1=89");
+    EXPECT_EQ(seen[2], "Foo3=1 -2 3 9223372036854775807 "
+                       "-9223372036854775808");
+}
+
+TEST(BinaryIni, RejectText)
+{
+    char name[] = "/tmp/binary_inifile.test.XXXXXX";
+    int fd = mkstemp(name);
+    ASSERT_GE(fd, 0);
+    const char text[] = "[General]\nTest1=foo\n";
+    ASSERT_EQ(write(fd, text, sizeof(text) - 1), (ssize_t)sizeof(text) - 1);
+    close(fd);
+
+    BinaryIniFile bin;
+    EXPECT_FALSE(BinaryIniFile::isBinary(name));
+    EXPECT_FALSE(bin.load(name));
+    std::remove(name);
+}
+
+TEST(BinaryIni, StreamWriter)
+{
+    char name[] = "/tmp/binary_inifile.test.XXXXXX";
+    int fd = mkstemp(name);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    BinaryIniFile::Writer writer;
+    ASSERT_TRUE(writer.open(name));
+    std::ostream os(&writer);
+    os << "## comment before any section\n"
+       << "\n[system.cpu]\n" << "tick=1000\n" << "  name = cpu0  \n"
+       << "\n[system.cpu.isa]\n" << "regs=1 2 3\n" << "regs=4 5";
+    ASSERT_TRUE(writer.close()) << writer.error();
+
+    BinaryIniFile bin;
+    ASSERT_TRUE(bin.load(name));
+    std::string value;
+    ASSERT_TRUE(bin.find("system.cpu", "tick", value));
+    EXPECT_EQ(value, "1000");
+    ASSERT_TRUE(bin.find("system.cpu", "name", value));
+    EXPECT_EQ(value, "cpu0");
+
+    // The last line needs no newline, and a repeated key overrides the
+    // earlier value like in IniFile.
+    std::vector<int64_t> ints;
+    ASSERT_TRUE(bin.findArray("system.cpu.isa", "regs", ints));
+    EXPECT_EQ(ints, std::vector<int64_t>({4, 5}));
+    std::remove(name);
+}
+
+TEST(BinaryIni, StreamWriterRejectsRepeatedSection)
+{
+    char name[] = "/tmp/binary_inifile.test.XXXXXX";
+    int fd = mkstemp(name);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    BinaryIniFile::Writer writer;
+    ASSERT_TRUE(writer.open(name));
+    std::ostream os(&writer);
+    os << "[a]\nx=1\n[b]\ny=2\n[a]\nz=3\n";
+    EXPECT_FALSE(writer.close());
+    EXPECT_NE(writer.error().find("section a"), std::string::npos);
+    std::remove(name);
+}
+
+TEST_F(BinaryIniTest, CorruptSectionIsFatal)
+{
+    // Make the first section claim more entries than it holds; the file
+    // still maps, but looking the section up must not silently return
+    // an empty section.
+    FILE *f = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(f, nullptr);
+    ASSERT_EQ(std::fseek(f, 32, SEEK_SET), 0);
+    const uint32_t bogus = 0xffffffff;
+    ASSERT_EQ(std::fwrite(&bogus, sizeof(bogus), 1, f), 1u);
+    std::fclose(f);
+
+    BinaryIniFile corrupt;
+    ASSERT_TRUE(corrupt.load(path));
+    std::vector<std::string> names;
+    corrupt.getSectionNames(names);
+    std::sort(names.begin(), names.end());
+    // Sections are written in sorted order, so "Foo" is the first one.
+    ASSERT_EQ(names.front(), "Foo");
+
+    std::string value;
+    EXPECT_ANY_THROW(corrupt.find("Foo", "Foo1", value));
+    EXPECT_TRUE(corrupt.find("General", "Test2", value));
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_logger.hh"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "debug/FmtFlag.hh"
+#include "debug/FmtTicksOff.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+// The loggers are never deleted, so they are flushed at exit
+std::mutex registryLock;
+std::vector<BinaryLogger *> loggers;
+
+void
+flushLoggers()
+{
+    std::lock_guard<std::mutex> lock(registryLock);
+    for (auto *logger : loggers)
+        logger->flush();
+}
+
+} // anonymous namespace
+
+BinaryLogger::BinaryLogger(std::ostream &_stream, size_t ring_size)
+    : writer(_stream, ring_size), textBuffer(*this), textStream(&textBuffer)
+{
+    raw = true;
+
+    writer.push(magic, sizeof(magic));
+    writer.push(reinterpret_cast<const char *>(&version), sizeof(version));
+
+    static const bool registered = std::atexit(flushLoggers) == 0;
+    warn_if(!registered, "Binary debug traces won't be flushed at exit.\n");
+
+    std::lock_guard<std::mutex> lock(registryLock);
+    loggers.push_back(this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(registryLock);
+        loggers.erase(std::find(loggers.begin(), loggers.end(), this));
+    }
+
+    textStream.flush();
+}
+
+uint8_t
+BinaryLogger::formatBits()
+{
+    return (debug::FmtTicksOff ? TicksOff : 0) |
+           (debug::FmtFlag ? ShowFlag : 0);
+}
+
+uint32_t
+BinaryLogger::stringId(std::string_view str)
+{
+    auto it = stringIds.find(str);
+    if (it != stringIds.end())
+        return it->second;
+
+    const uint32_t id = strings.size();
+    strings.emplace_back(str);
+    stringIds.emplace(strings.back(), id);
+
+    put<uint8_t>(StringRecord);
+    put<uint32_t>(id);
+    put<uint32_t>(str.size());
+    put(str.data(), str.size());
+    commit();
+
+    return id;
+}
+
+void
+BinaryLogger::logRaw(Tick when, const std::string &name,
+                     const std::string &flag, const char *fmt,
+                     const RawArg *args, size_t num_args)
+{
+    std::lock_guard<UncontendedMutex> guard(producerLock);
+
+    const uint32_t fmt_id = stringId(fmt);
+    const uint32_t name_id = stringId(name);
+    const uint32_t flag_id = stringId(flag);
+
+    put<uint8_t>(MessageRecord);
+    put<uint8_t>(formatBits());
+    put<uint64_t>(when);
+    put<uint32_t>(fmt_id);
+    put<uint32_t>(name_id);
+    put<uint32_t>(flag_id);
+    put<uint16_t>(num_args);
+
+    for (size_t i = 0; i < num_args; ++i) {
+        const RawArg &arg = args[i];
+        put<uint8_t>(arg.type);
+        switch (arg.type) {
+          case RawArg::Bool:
+          case RawArg::Char:
+          case RawArg::SChar:
+          case RawArg::UChar:
+            put<uint8_t>(arg.bits);
+            break;
+          case RawArg::Int16:
+          case RawArg::UInt16:
+            put<uint16_t>(arg.bits);
+            break;
+          case RawArg::Int32:
+          case RawArg::UInt32:
+            put<uint32_t>(arg.bits);
+            break;
+          case RawArg::Int64:
+          case RawArg::UInt64:
+          case RawArg::Double:
+          case RawArg::Pointer:
+            put<uint64_t>(arg.bits);
+            break;
+          case RawArg::String:
+            put<uint32_t>(arg.len);
+            put(arg.str, arg.len);
+            break;
+          default:
+            panic("Unexpected raw argument type %d.", arg.type);
+        }
+    }
+
+    commit();
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    std::lock_guard<UncontendedMutex> guard(producerLock);
+
+    const uint32_t name_id = stringId(name);
+    const uint32_t flag_id = stringId(flag);
+
+    put<uint8_t>(TextRecord);
+    put<uint8_t>(formatBits());
+    put<uint64_t>(when);
+    put<uint32_t>(name_id);
+    put<uint32_t>(flag_id);
+    put<uint32_t>(message.size());
+    put(message.data(), message.size());
+    commit();
+}
+
+int
+BinaryLogger::TextBuffer::sync()
+{
+    if (!str().empty()) {
+        logger.logMessage(MaxTick, "", "", str());
+        str("");
+    }
+    return 0;
+}
+
+void
+BinaryLogger::commit()
+{
+    writer.push(record.data(), record.size());
+    record.clear();
+}
+
+void
+BinaryLogger::flush()
+{
+    textStream.flush();
+    writer.flush();
+}
+
+} // namespace trace
+} // namespace gem5
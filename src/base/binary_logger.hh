@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_LOGGER_HH__
+#define __BASE_BINARY_LOGGER_HH__
+
+#include <cstdint>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "base/async_writer.hh"
+#include "base/trace.hh"
+#include "base/types.hh"
+#include "base/uncontended_mutex.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * A debug logger that records messages in a compact binary form
+ * instead of formatting them. The format string, object name and
+ * flag of a message are replaced by IDs, and its arguments are kept
+ * unformatted. Records are written by an AsyncWriter, so the
+ * simulation threads neither format nor write anything.
+ *
+ * Messages with arguments that can't be kept unformatted (see
+ * RawArg), hex dumps and text written to the logger stream are
+ * recorded as preformatted text. util/decode_debug_trace.py turns a
+ * trace back into the usual text output. Stack traces
+ * (FmtStackTrace) are not supported.
+ *
+ * The file starts with the magic string "gem5dlog" and a 32 bit
+ * version, followed by records in host byte order:
+ *   - String: u8 type, u32 id, u32 length, characters. Defines the
+ *     ID of a format string, name or flag before its first use.
+ *   - Message: u8 type, u8 format, u64 tick, u32 format string ID,
+ *     u32 name ID, u32 flag ID, u16 argument count, then each
+ *     argument as a u8 RawArg type and its value. Values are stored
+ *     in 1, 2, 4 or 8 bytes depending on their type, and strings as
+ *     a u32 length followed by their characters.
+ *   - Text: u8 type, u8 format, u64 tick, u32 name ID, u32 flag ID,
+ *     u32 length, characters.
+ * The format byte holds the state of the FmtTicksOff and FmtFlag
+ * debug flags when the message was logged.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    /** The record types. */
+    enum RecordType : uint8_t
+    {
+        StringRecord = 1,
+        MessageRecord = 2,
+        TextRecord = 3
+    };
+
+    /** Bits of the format byte. */
+    enum FormatBits : uint8_t
+    {
+        TicksOff = 0x1,
+        ShowFlag = 0x2
+    };
+
+    static constexpr char magic[8] = {
+        'g', 'e', 'm', '5', 'd', 'l', 'o', 'g' };
+    static constexpr uint32_t version = 1;
+
+    /**
+     * @param stream The stream to write the trace to, which should be
+     * opened in binary mode.
+     * @param ring_size Size of the ring buffer in bytes, rounded up to
+     * a power of two.
+     */
+    BinaryLogger(std::ostream &stream, size_t ring_size = 4 << 20);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    /**
+     * Text written to this stream is recorded as a message without
+     * tick, name or flag when the stream is flushed.
+     */
+    std::ostream &getOstream() override { return textStream; }
+
+    /**
+     * Wait until all messages logged so far have been written to the
+     * output stream, and flush it.
+     */
+    void flush();
+
+  protected:
+    void logRaw(Tick when, const std::string &name, const std::string &flag,
+                const char *fmt, const RawArg *args,
+                size_t num_args) override;
+
+  private:
+    /** A string buffer that records its contents when synced. */
+    class TextBuffer : public std::stringbuf
+    {
+      private:
+        BinaryLogger &logger;
+
+      public:
+        TextBuffer(BinaryLogger &_logger) : logger(_logger) {}
+
+      protected:
+        int sync() override;
+    };
+
+    /** @return The ID of a string, defining it if it's new. */
+    uint32_t stringId(std::string_view str);
+
+    /** @return The current state of the format debug flags. */
+    static uint8_t formatBits();
+
+    /** Append a value to the record being built. */
+    template <typename T>
+    void
+    put(const T &val)
+    {
+        const char *p = reinterpret_cast<const char *>(&val);
+        record.insert(record.end(), p, p + sizeof(T));
+    }
+
+    /** Append characters to the record being built. */
+    void
+    put(const char *data, size_t len)
+    {
+        record.insert(record.end(), data, data + len);
+    }
+
+    /** Pass the record being built to the writer, and clear it. */
+    void commit();
+
+    AsyncWriter writer;
+
+    /**
+     * Serializes the simulation threads. The writer only has a single
+     * producer.
+     */
+    UncontendedMutex producerLock;
+
+    /** The record being built. */
+    std::vector<char> record;
+    /** The strings with an ID, which the map keys point to. */
+    std::deque<std::string> strings;
+    std::unordered_map<std::string_view, uint32_t> stringIds;
+
+    TextBuffer textBuffer;
+    std::ostream textStream;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_LOGGER_HH__
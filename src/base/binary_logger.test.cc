@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "base/binary_logger.hh"
+#include "base/cprintf.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/gtest/logging.hh"
+#include "base/trace.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** Reads values from a binary trace. */
+class Reader
+{
+  private:
+    const std::string data;
+    size_t pos = 0;
+
+  public:
+    Reader(const std::string &_data) : data(_data) {}
+
+    bool done() const { return pos == data.size(); }
+
+    template <typename T>
+    T
+    get()
+    {
+        T val;
+        EXPECT_LE(pos + sizeof(T), data.size());
+        std::memcpy(&val, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return val;
+    }
+
+    std::string
+    getString(size_t len)
+    {
+        EXPECT_LE(pos + len, data.size());
+        std::string str = data.substr(pos, len);
+        pos += len;
+        return str;
+    }
+};
+
+/** Format a raw argument with its original type. */
+void
+addArg(cp::Print &print, Reader &reader)
+{
+    using trace::RawArg;
+    switch (reader.get<uint8_t>()) {
+      case RawArg::Bool:
+        print.addArg((bool)reader.get<uint8_t>());
+        break;
+      case RawArg::Char:
+        print.addArg((char)reader.get<uint8_t>());
+        break;
+      case RawArg::SChar:
+        print.addArg((signed char)reader.get<uint8_t>());
+        break;
+      case RawArg::UChar:
+        print.addArg((unsigned char)reader.get<uint8_t>());
+        break;
+      case RawArg::Int16:
+        print.addArg(reader.get<int16_t>());
+        break;
+      case RawArg::UInt16:
+        print.addArg(reader.get<uint16_t>());
+        break;
+      case RawArg::Int32:
+        print.addArg(reader.get<int32_t>());
+        break;
+      case RawArg::UInt32:
+        print.addArg(reader.get<uint32_t>());
+        break;
+      case RawArg::Int64:
+        print.addArg(reader.get<int64_t>());
+        break;
+      case RawArg::UInt64:
+        print.addArg(reader.get<uint64_t>());
+        break;
+      case RawArg::Double:
+        print.addArg(reader.get<double>());
+        break;
+      case RawArg::String:
+        print.addArg(reader.getString(reader.get<uint32_t>()));
+        break;
+      case RawArg::Pointer:
+        print.addArg((const void *)reader.get<uint64_t>());
+        break;
+      default:
+        ADD_FAILURE() << "Bad argument type";
+    }
+}
+
+/**
+ * Decode a binary trace the way util/decode_debug_trace.py does, but
+ * format the messages with cprintf itself.
+ */
+std::string
+decode(const std::string &trace, int *num_messages = nullptr,
+       int *num_texts = nullptr)
+{
+    Reader reader(trace);
+    EXPECT_EQ(reader.getString(8), "gem5dlog");
+    EXPECT_EQ(reader.get<uint32_t>(), trace::BinaryLogger::version);
+
+    std::map<uint32_t, std::string> strings;
+    std::ostringstream out;
+    while (!reader.done()) {
+        const uint8_t type = reader.get<uint8_t>();
+        if (type == trace::BinaryLogger::StringRecord) {
+            const uint32_t id = reader.get<uint32_t>();
+            strings[id] = reader.getString(reader.get<uint32_t>());
+            continue;
+        }
+
+        const uint8_t format = reader.get<uint8_t>();
+        const Tick when = reader.get<uint64_t>();
+        std::string fmt, message;
+        if (type == trace::BinaryLogger::MessageRecord)
+            fmt = strings.at(reader.get<uint32_t>());
+        const std::string &name = strings.at(reader.get<uint32_t>());
+        const std::string &flag = strings.at(reader.get<uint32_t>());
+
+        if (type == trace::BinaryLogger::MessageRecord) {
+            std::ostringstream line;
+            cp::Print print(line, fmt);
+            const uint16_t num_args = reader.get<uint16_t>();
+            for (int i = 0; i < num_args; ++i)
+                addArg(print, reader);
+            print.endArgs();
+            message = line.str();
+            if (num_messages)
+                ++*num_messages;
+        } else {
+            EXPECT_EQ(type, trace::BinaryLogger::TextRecord);
+            message = reader.getString(reader.get<uint32_t>());
+            if (num_texts)
+                ++*num_texts;
+        }
+
+        if (!(format & trace::BinaryLogger::TicksOff) && when != MaxTick)
+            ccprintf(out, "%7d: ", when);
+        if ((format & trace::BinaryLogger::ShowFlag) && !flag.empty())
+            out << flag << ": ";
+        if (!name.empty())
+            out << name << ": ";
+        out << message;
+    }
+    return out.str();
+}
+
+/** A type that is formatted by its stream operator. */
+struct Custom
+{
+    int val;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Custom &c)
+{
+    return os << "custom(" << c.val << ")";
+}
+
+/** Log the same messages with a logger. */
+void
+logMessages(trace::Logger &logger)
+{
+    const std::string str("text");
+    const char *cstr = "ctext";
+    char array[] = "array";
+    int val = 42;
+
+    logger.dprintf_flag(10, "sys.cpu", "Exec", "plain message\n");
+    logger.dprintf_flag(11, "sys.cpu", "Exec", "%d %i %u %x %#x %o %#o\n",
+                        -5, 17, 3u, -1, 255, 8, 8);
+    logger.dprintf_flag(12, "sys.mem", "Cache", "%08x %#010x %-6d| %+d\n",
+                        0xbeefULL, (uint16_t)0x42, (short)-3, 7L);
+    logger.dprintf_flag(13, "sys.mem", "Cache", "%c%c%c %s %d %s %d\n",
+                        'a', (signed char)'b', (unsigned char)'c', 'd',
+                        (uint8_t)200, true, false);
+    logger.dprintf_flag(14, "", "Cache", "%s|%10s|%-10s|%s|%x\n",
+                        str, cstr, array, "literal", str);
+    logger.dprintf_flag(15, "sys", "", "%f %.2f %e %.3e %g %10.4g %s\n",
+                        1.5, 2.0 / 3.0, 12345.678, 0.5f, 1e-10, 3.14159,
+                        2.5);
+    logger.dprintf_flag(16, "sys", "", "%p %s %*d %.*f %c %f\n", &val, &val,
+                        6, 9, 2, 1.0 / 3.0, 1.5, 3);
+    logger.dprintf_flag(17, "sys", "", "%d %d%%\n", 1);
+    logger.dprintf_flag(18, "sys", "", "%d\n", 1, 2);
+    logger.dprintf_flag(MaxTick, "sys", "", "%s %d\n", Custom{3}, 4);
+    logger.dump(19, "sys", "0123456789abcdefghij", 20, "Dump");
+    logger.getOstream() << "raw " << 5 << std::endl;
+}
+
+} // anonymous namespace
+
+/**
+ * Test that decoding a binary trace gives the same output as the text
+ * logger.
+ */
+TEST(BinaryLoggerTest, SameAsText)
+{
+    std::ostringstream text;
+    trace::OstreamLogger text_logger(text);
+    logMessages(text_logger);
+
+    std::ostringstream binary;
+    {
+        trace::BinaryLogger logger(binary);
+        logMessages(logger);
+    }
+
+    int num_messages = 0, num_texts = 0;
+    EXPECT_EQ(decode(binary.str(), &num_messages, &num_texts), text.str());
+    // the message with a custom argument, the dump and the raw text
+    // are recorded as text
+    EXPECT_EQ(num_messages, 9);
+    EXPECT_EQ(num_texts, 4);
+}
+
+/** Test the layout of the records. */
+TEST(BinaryLoggerTest, Records)
+{
+    std::ostringstream binary;
+    {
+        trace::BinaryLogger logger(binary);
+        logger.dprintf_flag(100, "obj", "Flag", "%d %s", 7, "x");
+        logger.dprintf_flag(200, "obj", "Flag", "%d %s", 8, "y");
+    }
+
+    Reader reader(binary.str());
+    EXPECT_EQ(reader.getString(8), "gem5dlog");
+    EXPECT_EQ(reader.get<uint32_t>(), 1u);
+
+    // the format string, name and flag are defined once
+    const std::string defs[] = { "%d %s", "obj", "Flag" };
+    for (uint32_t id = 0; id < 3; ++id) {
+        EXPECT_EQ(reader.get<uint8_t>(), trace::BinaryLogger::StringRecord);
+        EXPECT_EQ(reader.get<uint32_t>(), id);
+        EXPECT_EQ(reader.getString(reader.get<uint32_t>()), defs[id]);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(reader.get<uint8_t>(), trace::BinaryLogger::MessageRecord);
+        EXPECT_EQ(reader.get<uint8_t>(), 0);
+        EXPECT_EQ(reader.get<uint64_t>(), 100u * (i + 1));
+        EXPECT_EQ(reader.get<uint32_t>(), 0u);
+        EXPECT_EQ(reader.get<uint32_t>(), 1u);
+        EXPECT_EQ(reader.get<uint32_t>(), 2u);
+        EXPECT_EQ(reader.get<uint16_t>(), 2);
+        EXPECT_EQ(reader.get<uint8_t>(), trace::RawArg::Int32);
+        EXPECT_EQ(reader.get<int32_t>(), 7 + i);
+        EXPECT_EQ(reader.get<uint8_t>(), trace::RawArg::String);
+        EXPECT_EQ(reader.getString(reader.get<uint32_t>()),
+                  i ? "y" : "x");
+    }
+    EXPECT_TRUE(reader.done());
+}
+
+/** Test that flush writes everything logged so far. */
+TEST(BinaryLoggerTest, Flush)
+{
+    std::ostringstream binary;
+    trace::BinaryLogger logger(binary);
+    logger.dprintf_flag(1, "obj", "", "%s\n", "first");
+    logger.flush();
+    EXPECT_EQ(decode(binary.str()), "      1: obj: first\n");
+}
+
+/**
+ * Test that messages that don't fit in the ring are written out as the
+ * writer thread drains it.
+ */
+TEST(BinaryLoggerTest, Wrap)
+{
+    const std::string big(10000, 'z');
+    std::ostringstream text;
+    trace::OstreamLogger text_logger(text);
+    std::ostringstream binary;
+    {
+        trace::BinaryLogger logger(binary, 4096);
+        for (int i = 0; i < 2000; ++i) {
+            logger.dprintf_flag(i, "obj", "", "message %d %#x\n", i, i * 3);
+            text_logger.dprintf_flag(i, "obj", "", "message %d %#x\n", i,
+                                     i * 3);
+        }
+        logger.dprintf_flag(2000, "obj", "", "%s\n", big);
+        text_logger.dprintf_flag(2000, "obj", "", "%s\n", big);
+    }
+    EXPECT_EQ(decode(binary.str()), text.str());
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SLAB_POOL_HH__
+#define __BASE_SLAB_POOL_HH__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define GEM5_SLAB_POOL_BYPASS
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define GEM5_SLAB_POOL_BYPASS
+#endif
+#endif
+
+namespace gem5
+{
+
+/**
+ * A pool of fixed-size memory chunks for objects that are allocated and
+ * freed at a high rate, such as packets and requests. Chunks are carved
+ * out of large slabs owned by a per-thread heap, so allocating and
+ * freeing on the same thread is a couple of pointer operations without
+ * any locking.
+ *
+ * Slabs are aligned to their size, and start with a header pointing at
+ * the heap that owns them. A chunk freed by another thread than the
+ * owner is pushed on a lock-free list of its owning heap, which the
+ * owner drains before carving a new slab. Memory thus always flows back
+ * to the thread that allocated it, and a producer/consumer pair of
+ * threads reuses the same chunks rather than growing the pool. When a
+ * thread exits its heap is kept, along with its slabs, and handed to the
+ * next thread that starts using the pool.
+ *
+ * When built with AddressSanitizer the pool forwards to the global
+ * allocator, so that use-after-free errors are still caught.
+ *
+ * @tparam Size Size of the chunks in bytes
+ * @tparam Align Alignment of the chunks
+ */
+template <std::size_t Size, std::size_t Align = alignof(std::max_align_t)>
+class SlabPool
+{
+  private:
+    struct Chunk
+    {
+        Chunk *next;
+    };
+
+    struct Heap
+    {
+        /** Chunks freed by the owning thread */
+        Chunk *head = nullptr;
+        /** Chunks freed by other threads */
+        std::atomic<Chunk *> remote{nullptr};
+    };
+
+    struct SlabHeader
+    {
+        Heap *owner;
+    };
+
+    static constexpr std::size_t
+    roundUp(std::size_t val, std::size_t align)
+    {
+        return (val + align - 1) / align * align;
+    }
+
+    static constexpr std::size_t
+    ceilPow2(std::size_t val)
+    {
+        std::size_t pow2 = 1;
+        while (pow2 < val)
+            pow2 <<= 1;
+        return pow2;
+    }
+
+    /** Space before the first chunk of a slab */
+    static constexpr std::size_t headerSize =
+        roundUp(sizeof(SlabHeader), Align);
+
+  public:
+    /** Size of a chunk, large enough to link it in the free list */
+    static constexpr std::size_t chunkSize =
+        roundUp(std::max(Size, sizeof(void *)), Align);
+
+    /** Size and alignment of a slab, 64KiB unless a chunk needs more */
+    static constexpr std::size_t slabSize =
+        ceilPow2(std::max<std::size_t>(65536, headerSize + chunkSize));
+
+    /** Number of chunks in a slab */
+    static constexpr std::size_t slabChunks =
+        (slabSize - headerSize) / chunkSize;
+
+    /** Get a chunk of memory. */
+    static void *
+    allocate()
+    {
+#ifdef GEM5_SLAB_POOL_BYPASS
+        return ::operator new(chunkSize, std::align_val_t(Align));
+#else
+        Heap &heap = localHeap();
+        if (!heap.head) {
+            heap.head = heap.remote.exchange(nullptr,
+                                             std::memory_order_acquire);
+            if (!heap.head)
+                refill(heap);
+        }
+        Chunk *chunk = heap.head;
+        heap.head = chunk->next;
+        return chunk;
+#endif
+    }
+
+    /** Return a chunk obtained from allocate(), on any thread. */
+    static void
+    deallocate(void *p)
+    {
+#ifdef GEM5_SLAB_POOL_BYPASS
+        ::operator delete(p, std::align_val_t(Align));
+#else
+        Chunk *chunk = static_cast<Chunk *>(p);
+        Heap *owner = reinterpret_cast<SlabHeader *>(
+            reinterpret_cast<std::uintptr_t>(p) & ~(slabSize - 1))->owner;
+        if (owner == localHeapPtr()) {
+            chunk->next = owner->head;
+            owner->head = chunk;
+            return;
+        }
+
+        chunk->next = owner->remote.load(std::memory_order_relaxed);
+        while (!owner->remote.compare_exchange_weak(chunk->next, chunk,
+                    std::memory_order_release, std::memory_order_relaxed)) {
+        }
+#endif
+    }
+
+  private:
+    /** The heaps of threads that have exited, waiting to be reused. */
+    struct Orphans
+    {
+        std::mutex lock;
+        std::vector<Heap *> heaps;
+    };
+
+    static Orphans &
+    orphans()
+    {
+        // Never destroyed, as threads may exit after static destruction
+        static Orphans *orphans = new Orphans;
+        return *orphans;
+    }
+
+    /**
+     * The heap of this thread, if it has one. This is a plain pointer
+     * so that chunks can still be freed while the thread is exiting.
+     */
+    static Heap *&
+    localHeapPtr()
+    {
+        static thread_local Heap *heap = nullptr;
+        return heap;
+    }
+
+    /** Orphans the heap of a thread when the thread exits. */
+    struct HeapRelease
+    {
+        ~HeapRelease()
+        {
+            Heap *&heap = localHeapPtr();
+            Orphans &o = orphans();
+            std::lock_guard<std::mutex> guard(o.lock);
+            o.heaps.push_back(heap);
+            heap = nullptr;
+        }
+    };
+
+    /** The heap of this thread, adopting or creating one if needed. */
+    static Heap &
+    localHeap()
+    {
+        Heap *&heap = localHeapPtr();
+        if (heap)
+            return *heap;
+
+        {
+            Orphans &o = orphans();
+            std::lock_guard<std::mutex> guard(o.lock);
+            if (o.heaps.empty()) {
+                heap = new Heap;
+            } else {
+                heap = o.heaps.back();
+                o.heaps.pop_back();
+            }
+        }
+
+        // Hand the heap back when the thread exits. A thread which only
+        // allocates again while exiting keeps its heap for good.
+        static thread_local HeapRelease release;
+        return *heap;
+    }
+
+    /** Carve a new slab into chunks and put them on the free list. */
+    static void
+    refill(Heap &heap)
+    {
+        char *slab = static_cast<char *>(
+            ::operator new(slabSize, std::align_val_t(slabSize)));
+        new (slab) SlabHeader{&heap};
+        for (std::size_t i = slabChunks; i-- > 0;) {
+            Chunk *chunk = reinterpret_cast<Chunk *>(
+                slab + headerSize + i * chunkSize);
+            chunk->next = heap.head;
+            heap.head = chunk;
+        }
+    }
+};
+
+/**
+ * A standard allocator drawing single objects from a SlabPool, for use
+ * with containers and std::allocate_shared. Requests for more than one
+ * object go to the global allocator.
+ */
+template <typename T>
+class SlabAllocator
+{
+  public:
+    typedef T value_type;
+
+    SlabAllocator() = default;
+
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        if (n == 1)
+            return static_cast<T *>(Pool::allocate());
+        return static_cast<T *>(
+            ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void
+    deallocate(T *p, std::size_t n)
+    {
+        if (n == 1)
+            Pool::deallocate(p);
+        else
+            ::operator delete(p, std::align_val_t(alignof(T)));
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U> &) const { return true; }
+
+    template <typename U>
+    bool operator!=(const SlabAllocator<U> &) const { return false; }
+
+  private:
+    typedef SlabPool<sizeof(T),
+        std::max(alignof(T), alignof(std::max_align_t))> Pool;
+};
+
+} // namespace gem5
+
+#endif // __BASE_SLAB_POOL_HH__
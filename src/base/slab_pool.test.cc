@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/slab_pool.hh"
+
+using namespace gem5;
+
+TEST(SlabPoolTest, ChunkSize)
+{
+    EXPECT_EQ(SlabPool<1>::chunkSize, alignof(std::max_align_t));
+    EXPECT_EQ((SlabPool<24, 8>::chunkSize), 24u);
+    EXPECT_EQ((SlabPool<20, 8>::chunkSize), 24u);
+    EXPECT_EQ((SlabPool<2, 2>::chunkSize), sizeof(void *));
+}
+
+TEST(SlabPoolTest, DistinctAligned)
+{
+    typedef SlabPool<48, 16> Pool;
+    std::set<void *> chunks;
+    // Cover more than one slab
+    for (size_t i = 0; i < Pool::slabChunks * 2 + 1; i++) {
+        void *p = Pool::allocate();
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 16, 0u);
+        EXPECT_TRUE(chunks.insert(p).second);
+    }
+    for (void *p : chunks)
+        Pool::deallocate(p);
+}
+
+TEST(SlabPoolTest, Reuse)
+{
+#ifdef GEM5_SLAB_POOL_BYPASS
+    GTEST_SKIP() << "Pool is bypassed";
+#endif
+    typedef SlabPool<64> Pool;
+    void *p = Pool::allocate();
+    Pool::deallocate(p);
+    // The last chunk freed is the first handed out again
+    void *q = Pool::allocate();
+    EXPECT_EQ(q, p);
+    Pool::deallocate(q);
+}
+
+TEST(SlabPoolTest, CrossThreadFree)
+{
+#ifdef GEM5_SLAB_POOL_BYPASS
+    GTEST_SKIP() << "Pool is bypassed";
+#endif
+    typedef SlabPool<32> Pool;
+    std::vector<void *> chunks;
+    for (int i = 0; i < 100; i++)
+        chunks.push_back(Pool::allocate());
+
+    // Chunks freed by another thread go back to the allocating thread
+    std::set<void *> freed(chunks.begin(), chunks.end());
+    std::thread([&chunks, &freed]() {
+        for (void *p : chunks)
+            Pool::deallocate(p);
+        for (size_t i = 0; i < chunks.size(); i++) {
+            void *p = Pool::allocate();
+            EXPECT_EQ(freed.count(p), 0u);
+            Pool::deallocate(p);
+        }
+    }).join();
+
+    // Drain whatever is left of the current slab, after which the pool
+    // hands out the chunks freed by the other thread
+    std::set<void *> reused;
+    std::vector<void *> drained;
+    for (size_t i = 0; i < Pool::slabChunks * 2; i++) {
+        void *p = Pool::allocate();
+        drained.push_back(p);
+        if (freed.count(p))
+            reused.insert(p);
+    }
+    EXPECT_EQ(reused.size(), freed.size());
+    for (void *p : drained)
+        Pool::deallocate(p);
+}
+
+TEST(SlabPoolTest, ProducerConsumer)
+{
+#ifdef GEM5_SLAB_POOL_BYPASS
+    GTEST_SKIP() << "Pool is bypassed";
+#endif
+    typedef SlabPool<96> Pool;
+    const size_t batch = Pool::slabChunks / 2;
+    std::set<void *> seen;
+
+    // One thread allocates and another frees, over and over. The freed
+    // chunks flow back to the producer, so it never needs more than
+    // the chunks of two batches in flight.
+    for (int round = 0; round < 50; round++) {
+        std::vector<void *> chunks;
+        for (size_t i = 0; i < batch; i++) {
+            chunks.push_back(Pool::allocate());
+            seen.insert(chunks.back());
+        }
+        std::thread([&chunks]() {
+            for (void *p : chunks)
+                Pool::deallocate(p);
+        }).join();
+    }
+    EXPECT_LE(seen.size(), Pool::slabChunks * 2);
+}
+
+TEST(SlabPoolTest, ExitedThreadHeapReused)
+{
+#ifdef GEM5_SLAB_POOL_BYPASS
+    GTEST_SKIP() << "Pool is bypassed";
+#endif
+    typedef SlabPool<160> Pool;
+    std::vector<void *> chunks;
+
+    // A thread allocates and exits, leaving its chunks in use
+    std::thread([&chunks]() {
+        for (int i = 0; i < 10; i++)
+            chunks.push_back(Pool::allocate());
+    }).join();
+
+    // Freeing them after the owner has gone is still fine, and the next
+    // thread to use the pool takes over the exited thread's heap
+    for (void *p : chunks)
+        Pool::deallocate(p);
+    std::set<void *> freed(chunks.begin(), chunks.end());
+    std::thread([&freed]() {
+        std::vector<void *> chunks;
+        size_t reused = 0;
+        for (size_t i = 0; i < Pool::slabChunks; i++) {
+            chunks.push_back(Pool::allocate());
+            reused += freed.count(chunks.back());
+        }
+        EXPECT_EQ(reused, freed.size());
+        for (void *p : chunks)
+            Pool::deallocate(p);
+    }).join();
+}
+
+TEST(SlabPoolTest, AllocateShared)
+{
+    struct Obj
+    {
+        int &live;
+        Obj(int &_live) : live(_live) { live++; }
+        ~Obj() { live--; }
+    };
+
+    int live = 0;
+    {
+        auto a = std::allocate_shared<Obj>(SlabAllocator<Obj>(), live);
+        auto b = a;
+        EXPECT_EQ(live, 1);
+        EXPECT_EQ(a.use_count(), 2);
+        auto c = std::allocate_shared<Obj>(SlabAllocator<Obj>(), live);
+        EXPECT_EQ(live, 2);
+        EXPECT_NE(a.get(), c.get());
+    }
+    EXPECT_EQ(live, 0);
+}
+
+TEST(SlabPoolTest, AllocatorArrays)
+{
+    std::vector<uint64_t, SlabAllocator<uint64_t>> v;
+    for (uint64_t i = 0; i < 1000; i++)
+        v.push_back(i);
+    for (uint64_t i = 0; i < 1000; i++)
+        EXPECT_EQ(v[i], i);
+}
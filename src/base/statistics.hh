@@ -71,6 +71,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "base/cast.hh"
@@ -120,6 +121,8 @@ class ScalarInfoProxy : public InfoProxy<Stat, ScalarInfo>
   public:
     ScalarInfoProxy(Stat &stat) : InfoProxy<Stat, ScalarInfo>(stat) {}
 
+    bool shard(size_type shards) { return this->s.shard(shards); }
+
     Counter value() const { return this->s.value(); }
     Result result() const { return this->s.result(); }
     Result total() const { return this->s.total(); }
@@ -135,6 +138,8 @@ class VectorInfoProxy : public InfoProxy<Stat, VectorInfo>
   public:
     VectorInfoProxy(Stat &stat) : InfoProxy<Stat, VectorInfo>(stat) {}
 
+    bool shard(size_type shards) { return this->s.shard(shards); }
+
     size_type size() const { return this->s.size(); }
 
     VCounter &
@@ -159,6 +164,8 @@ class DistInfoProxy : public InfoProxy<Stat, DistInfo>
 {
   public:
     DistInfoProxy(Stat &stat) : InfoProxy<Stat, DistInfo>(stat) {}
+
+    bool shard(size_type shards) { return this->s.shard(shards); }
 };
 
 template <class Stat>
@@ -167,6 +174,8 @@ class VectorDistInfoProxy : public InfoProxy<Stat, VectorDistInfo>
   public:
     VectorDistInfoProxy(Stat &stat) : InfoProxy<Stat, VectorDistInfo>(stat) {}
 
+    bool shard(size_type shards) { return this->s.shard(shards); }
+
     size_type size() const { return this->s.size(); }
 };
 
@@ -176,6 +185,8 @@ class Vector2dInfoProxy : public InfoProxy<Stat, Vector2dInfo>
   public:
     Vector2dInfoProxy(Stat &stat) : InfoProxy<Stat, Vector2dInfo>(stat) {}
 
+    bool shard(size_type shards) { return this->s.shard(shards); }
+
     Result total() const { return this->s.total(); }
 };
 
@@ -566,6 +577,8 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
         this->doInit();
     }
 
+    ~ScalarBase() { data()->~Storage(); }
+
   public:
     // Common operators for stats
     /**
@@ -628,6 +641,13 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
 
     void reset() { data()->reset(this->info()->getStorageParams()); }
     void prepare() { data()->prepare(this->info()->getStorageParams()); }
+
+    /**
+     * Split the storage into one shard per simulation thread.
+     * @param shards The number of shards.
+     * @return True if the storage supports sharding.
+     */
+    bool shard(size_type shards) { return data()->shard(shards); }
 };
 
 class ProxyInfo : public ScalarInfo
@@ -777,6 +797,8 @@ class ValueBase : public DataWrap<Derived, ScalarInfoProxy>
     std::string str() const { return proxy->str(); }
     bool zero() const { return proxy->zero(); }
     bool check() const { return proxy != NULL; }
+    /** Values are only read, so they never need shards. */
+    bool shard(size_type shards) { return true; }
     void prepare() { }
     void reset() { }
 };
@@ -1015,6 +1037,20 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
         return size() > 0;
     }
 
+    /**
+     * Split every element into one shard per simulation thread.
+     * @param shards The number of shards.
+     * @return True if the storage supports sharding.
+     */
+    bool
+    shard(size_type shards)
+    {
+        bool sharded = true;
+        for (auto &stor : storage)
+            sharded = stor->shard(shards) && sharded;
+        return sharded;
+    }
+
   public:
     VectorBase(Group *parent, const char *name,
                const units::Base *unit,
@@ -1257,6 +1293,20 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
     {
         return size() > 0;
     }
+
+    /**
+     * Split every element into one shard per simulation thread.
+     * @param shards The number of shards.
+     * @return True if the storage supports sharding.
+     */
+    bool
+    shard(size_type shards)
+    {
+        bool sharded = true;
+        for (auto &stor : storage)
+            sharded = stor->shard(shards) && sharded;
+        return sharded;
+    }
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -1265,6 +1315,41 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
 //
 //////////////////////////////////////////////////////////////////////
 
+/**
+ * Add a batch of values to a distribution storage, once each. Values
+ * of types other than Counter are converted in small chunks.
+ */
+template <class Stor, typename U>
+void
+sampleBatch(Stor &stor, const U *vals, size_type count)
+{
+    if constexpr (std::is_same_v<U, Counter>) {
+        stor.sampleN(vals, count);
+    } else {
+        Counter chunk[sampleBufferSize];
+        for (size_type i = 0; i < count; i += sampleBufferSize) {
+            const size_type n = std::min(count - i, sampleBufferSize);
+            for (size_type j = 0; j < n; ++j)
+                chunk[j] = vals[i + j];
+            stor.sampleN(chunk, n);
+        }
+    }
+}
+
+/**
+ * A per-thread copy of a distribution storage, kept apart from the
+ * copies of other threads.
+ */
+template <class Stor>
+struct alignas(64) StorShard
+{
+    Stor stor;
+
+    StorShard(const StorageParams* const storage_params)
+        : stor(storage_params)
+    {}
+};
+
 /**
  * Implementation of a distribution stat. The type of distribution is
  * determined by the Storage template. @sa ScalarBase
@@ -1280,6 +1365,8 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
   protected:
     /** The storage for this stat. */
     GEM5_ALIGNED(8) char storage[sizeof(Storage)];
+    /** The per-thread copies of the storage, if the stat is sharded. */
+    std::vector<std::unique_ptr<StorShard<Storage>>> shards;
 
   protected:
     /**
@@ -1309,6 +1396,27 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
         this->setInit();
     }
 
+    /** @return The storage sampled by the current thread. */
+    Storage *
+    local()
+    {
+        if (GEM5_UNLIKELY(!shards.empty())) {
+            assert(curShard() < shards.size());
+            return &shards[curShard()]->stor;
+        }
+        return data();
+    }
+
+    /** Add the shards to the storage and clear them. */
+    void
+    fold()
+    {
+        for (auto &shard : shards) {
+            data()->add(&shard->stor);
+            shard->stor.reset(this->info()->getStorageParams());
+        }
+    }
+
   public:
     DistBase(Group *parent, const char *name,
              const units::Base *unit,
@@ -1324,7 +1432,20 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
      * @param n The number of times to add it, defaults to 1.
      */
     template <typename U>
-    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+    void sample(const U &v, int n = 1) { local()->sample(v, n); }
+
+    /**
+     * Add a batch of values to the distribution, once each. This is
+     * cheaper than sampling them one by one.
+     * @param vals The values to add.
+     * @param count The number of values.
+     */
+    template <typename U>
+    void
+    sampleN(const U *vals, size_type count)
+    {
+        sampleBatch(*local(), vals, count);
+    }
 
     /**
      * Return the number of entries in this stat.
@@ -1335,12 +1456,20 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
      * Return true if no samples have been added.
      * @return True if there haven't been any samples.
      */
-    bool zero() const { return data()->zero(); }
+    bool
+    zero() const
+    {
+        for (auto &shard : shards)
+            if (!shard->stor.zero())
+                return false;
+        return data()->zero();
+    }
 
     void
     prepare()
     {
         Info *info = this->info();
+        fold();
         data()->prepare(info->getStorageParams(), info->data);
     }
 
@@ -1351,12 +1480,40 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     reset()
     {
         data()->reset(this->info()->getStorageParams());
+        for (auto &shard : shards)
+            shard->stor.reset(this->info()->getStorageParams());
+    }
+
+    /**
+     * Split the storage into one shard per simulation thread.
+     * @param num_shards The number of shards, 1 or less merges them.
+     * @return True if the storage supports sharding.
+     */
+    bool
+    shard(size_type num_shards)
+    {
+        if (!Storage::shardable)
+            return false;
+
+        fold();
+        shards.clear();
+        for (size_type i = 0; num_shards > 1 && i < num_shards; ++i) {
+            shards.emplace_back(new StorShard<Storage>(
+                this->info()->getStorageParams()));
+        }
+        return true;
     }
 
     /**
      *  Add the argument distribution to the this distribution.
      */
-    void add(DistBase &d) { data()->add(d.data()); }
+    void
+    add(DistBase &d)
+    {
+        d.fold();
+        fold();
+        data()->add(d.data());
+    }
 };
 
 template <class Stat>
@@ -1375,6 +1532,11 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
 
   protected:
     std::vector<Storage*> storage;
+    /**
+     * The per-thread copies of the storage, if the stat is sharded.
+     * The copies of all elements of one thread are next to each other.
+     */
+    std::vector<std::unique_ptr<StorShard<Storage>>> shards;
 
   protected:
     Storage *
@@ -1389,6 +1551,27 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
         return storage[index];
     }
 
+    /** @return The storage of an element sampled by the current thread. */
+    Storage *
+    local(off_type index)
+    {
+        if (GEM5_UNLIKELY(!shards.empty())) {
+            assert((curShard() + 1) * size() <= shards.size());
+            return &shards[curShard() * size() + index]->stor;
+        }
+        return data(index);
+    }
+
+    /** Add the shards to the storage and clear them. */
+    void
+    fold()
+    {
+        for (off_type i = 0; i < shards.size(); ++i) {
+            data(i % size())->add(&shards[i]->stor);
+            shards[i]->stor.reset(this->info()->getStorageParams());
+        }
+    }
+
     void
     doInit(size_type s)
     {
@@ -1435,6 +1618,9 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
         for (off_type i = 0; i < size(); ++i)
             if (!data(i)->zero())
                 return false;
+        for (auto &shard : shards)
+            if (!shard->stor.zero())
+                return false;
         return true;
     }
 
@@ -1443,11 +1629,42 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
     {
         Info *info = this->info();
         size_type size = this->size();
+        fold();
         info->data.resize(size);
         for (off_type i = 0; i < size; ++i)
             data(i)->prepare(info->getStorageParams(), info->data[i]);
     }
 
+    void
+    reset()
+    {
+        Info *info = this->info();
+        for (auto &stor : storage)
+            stor->reset(info->getStorageParams());
+        for (auto &shard : shards)
+            shard->stor.reset(info->getStorageParams());
+    }
+
+    /**
+     * Split every element into one shard per simulation thread.
+     * @param num_shards The number of shards, 1 or less merges them.
+     * @return True if the storage supports sharding.
+     */
+    bool
+    shard(size_type num_shards)
+    {
+        if (!Storage::shardable)
+            return false;
+
+        fold();
+        shards.clear();
+        for (size_type i = 0; num_shards > 1 && i < num_shards * size(); ++i) {
+            shards.emplace_back(new StorShard<Storage>(
+                this->info()->getStorageParams()));
+        }
+        return true;
+    }
+
     bool
     check() const
     {
@@ -1488,7 +1705,14 @@ class DistProxy
     void
     sample(const U &v, int n = 1)
     {
-        data()->sample(v, n);
+        stat.local(index)->sample(v, n);
+    }
+
+    template <typename U>
+    void
+    sampleN(const U *vals, size_type count)
+    {
+        sampleBatch(*stat.local(index), vals, count);
     }
 
     size_type
@@ -2393,6 +2617,9 @@ class FormulaInfoProxy : public InfoProxy<Stat, FormulaInfo>
     VCounter &value() const { return cvec; }
 
     std::string str() const { return this->s.str(); }
+
+    /** Formulas are computed from other stats when they are dumped. */
+    bool shard(size_type shards) { return true; }
 };
 
 template <class Stat>
@@ -2400,6 +2627,8 @@ class SparseHistInfoProxy : public InfoProxy<Stat, SparseHistInfo>
 {
   public:
     SparseHistInfoProxy(Stat &stat) : InfoProxy<Stat, SparseHistInfo>(stat) {}
+
+    bool shard(size_type shards) { return this->s.shard(shards); }
 };
 
 /**
@@ -2417,6 +2646,8 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
   protected:
     /** The storage for this stat. */
     char storage[sizeof(Storage)];
+    /** The per-thread copies of the storage, if the stat is sharded. */
+    std::vector<std::unique_ptr<StorShard<Storage>>> shards;
 
   protected:
     /**
@@ -2446,6 +2677,27 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
         this->setInit();
     }
 
+    /** @return The storage sampled by the current thread. */
+    Storage *
+    local()
+    {
+        if (GEM5_UNLIKELY(!shards.empty())) {
+            assert(curShard() < shards.size());
+            return &shards[curShard()]->stor;
+        }
+        return data();
+    }
+
+    /** Add the shards to the storage and clear them. */
+    void
+    fold()
+    {
+        for (auto &shard : shards) {
+            data()->add(&shard->stor);
+            shard->stor.reset(this->info()->getStorageParams());
+        }
+    }
+
   public:
     SparseHistBase(Group *parent, const char *name,
                    const units::Base *unit,
@@ -2461,7 +2713,7 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
      * @param n The number of times to add it, defaults to 1.
      */
     template <typename U>
-    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+    void sample(const U &v, int n = 1) { local()->sample(v, n); }
 
     /**
      * Return the number of entries in this stat.
@@ -2472,12 +2724,20 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
      * Return true if no samples have been added.
      * @return True if there haven't been any samples.
      */
-    bool zero() const { return data()->zero(); }
+    bool
+    zero() const
+    {
+        for (auto &shard : shards)
+            if (!shard->stor.zero())
+                return false;
+        return data()->zero();
+    }
 
     void
     prepare()
     {
         Info *info = this->info();
+        fold();
         data()->prepare(info->getStorageParams(), info->data);
     }
 
@@ -2488,6 +2748,28 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
     reset()
     {
         data()->reset(this->info()->getStorageParams());
+        for (auto &shard : shards)
+            shard->stor.reset(this->info()->getStorageParams());
+    }
+
+    /**
+     * Split the storage into one shard per simulation thread.
+     * @param num_shards The number of shards, 1 or less merges them.
+     * @return True if the storage supports sharding.
+     */
+    bool
+    shard(size_type num_shards)
+    {
+        if (!Storage::shardable)
+            return false;
+
+        fold();
+        shards.clear();
+        for (size_type i = 0; num_shards > 1 && i < num_shards; ++i) {
+            shards.emplace_back(new StorShard<Storage>(
+                this->info()->getStorageParams()));
+        }
+        return true;
     }
 };
 
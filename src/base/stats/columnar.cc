@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <cassert>
+#include <cstring>
+#include <ostream>
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+/** Columns written for every distribution, before the buckets */
+const char *distColumns[] = {
+    "samples", "sum", "squares", "logs", "min_value", "max_value",
+    "underflow", "overflow", "min", "bucket_size",
+};
+
+/** Name of an element of a vector, its sub-name if it has one */
+std::string
+subName(const std::vector<std::string> &subnames, size_t i)
+{
+    if (i < subnames.size() && !subnames[i].empty())
+        return subnames[i];
+    return std::to_string(i);
+}
+
+void
+nameDist(const DistData &data, const std::string &prefix,
+         std::vector<std::string> &names)
+{
+    for (const char *column : distColumns)
+        names.push_back(prefix + "::" + column);
+    for (size_t i = 0; i < data.cvec.size(); ++i)
+        names.push_back(prefix + "::bucket" + std::to_string(i));
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(std::ostream &stream, bool desc, bool delta)
+    : stream(stream), descriptions(desc), deltas(delta),
+      headerWritten(false), nextBlock(0), schemaChanged(false)
+{
+}
+
+void
+Columnar::begin()
+{
+    row.clear();
+    buffer.clear();
+    nextBlock = 0;
+    schemaChanged = false;
+}
+
+void
+Columnar::end()
+{
+    assert(path.empty());
+
+    // a dump with fewer stats than the last one changes the schema too
+    if (!schemaChanged && nextBlock != blocks.size()) {
+        schemaChanged = true;
+        blocks.resize(nextBlock);
+        names.resize(row.size());
+        descs.resize(row.size());
+    }
+
+    if (!headerWritten) {
+        const uint32_t header[2] = {version, 0};
+        buffer.insert(buffer.end(), magic, magic + sizeof(magic));
+        buffer.insert(buffer.end(), (const char *)header,
+                      (const char *)header + sizeof(header));
+        headerWritten = true;
+        schemaChanged = true;
+    }
+
+    if (schemaChanged) {
+        assert(names.size() == row.size());
+        std::vector<char> schema;
+        auto put_string = [&schema](const std::string &s) {
+            const uint32_t len = s.size();
+            schema.insert(schema.end(), (const char *)&len,
+                          (const char *)&len + sizeof(len));
+            schema.insert(schema.end(), s.begin(), s.end());
+        };
+        const uint32_t num_columns = names.size();
+        schema.insert(schema.end(), (const char *)&num_columns,
+                      (const char *)&num_columns + sizeof(num_columns));
+        for (size_t i = 0; i < names.size(); ++i) {
+            put_string(names[i]);
+            put_string(descs[i]);
+        }
+        appendRecord(Schema, schema.data(), schema.size());
+    }
+
+    if (deltas && !schemaChanged)
+        appendDelta();
+    else
+        appendRecord(Row, row.data(), row.size() * sizeof(double));
+    if (deltas)
+        last.swap(row);
+
+    // the whole dump goes out in a single write
+    stream.write(buffer.data(), buffer.size());
+    stream.flush();
+}
+
+bool
+Columnar::valid() const
+{
+    return stream.good();
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    path.push_back(name);
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!path.empty());
+    path.pop_back();
+}
+
+bool
+Columnar::noOutput(const Info &info) const
+{
+    // unlike the text output, stats with a zero prerequisite are still
+    // written so that the columns stay the same from dump to dump
+    return !info.flags.isSet(display);
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const size_t start = row.size();
+    row.push_back(info.result());
+    endStat(info, start);
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const size_t start = row.size();
+    appendVector(info);
+    endStat(info, start);
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const size_t start = row.size();
+    appendDist(info.data);
+    endStat(info, start);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const size_t start = row.size();
+    for (const auto &data : info.data)
+        appendDist(data);
+    endStat(info, start);
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const size_t start = row.size();
+    row.insert(row.end(), info.cvec.begin(), info.cvec.end());
+    if (info.flags.isSet(total))
+        row.push_back(info.total());
+    endStat(info, start);
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    visit(static_cast<const VectorInfo &>(info));
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    warn_once("Columnar stat files don't support sparse histograms.\n");
+}
+
+void
+Columnar::appendVector(const VectorInfo &info)
+{
+    const VResult &result = info.result();
+    row.insert(row.end(), result.begin(), result.end());
+    if (info.flags.isSet(total))
+        row.push_back(info.total());
+}
+
+void
+Columnar::appendDist(const DistData &data)
+{
+    row.insert(row.end(), {
+        data.samples, data.sum, data.squares, data.logs,
+        data.min_val, data.max_val, data.underflow, data.overflow,
+        data.min, data.bucket_size});
+    row.insert(row.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Columnar::endStat(const Info &info, size_t start)
+{
+    const Block block{&info, row.size() - start};
+
+    if (!schemaChanged) {
+        if (nextBlock < blocks.size() && blocks[nextBlock] == block) {
+            nextBlock++;
+            return;
+        }
+
+        // the columns up to this stat are the same, so keep their names
+        schemaChanged = true;
+        blocks.resize(nextBlock);
+        names.resize(start);
+        descs.resize(start);
+    }
+
+    std::string prefix;
+    for (const char *group : path) {
+        prefix += group;
+        prefix += '.';
+    }
+    prefix += info.name;
+
+    blocks.push_back(block);
+    nextBlock++;
+    nameColumns(info, prefix);
+    descs.resize(names.size(), descriptions ? info.desc : "");
+    panic_if(names.size() != row.size(),
+             "Inconsistent number of columns for stat %s\n", prefix);
+}
+
+void
+Columnar::nameColumns(const Info &info, const std::string &prefix)
+{
+    if (dynamic_cast<const ScalarInfo *>(&info)) {
+        names.push_back(prefix);
+    } else if (auto vector = dynamic_cast<const VectorInfo *>(&info)) {
+        for (size_t i = 0; i < vector->size(); ++i)
+            names.push_back(prefix + "::" + subName(vector->subnames, i));
+        if (info.flags.isSet(total))
+            names.push_back(prefix + "::total");
+    } else if (auto dist = dynamic_cast<const DistInfo *>(&info)) {
+        nameDist(dist->data, prefix, names);
+    } else if (auto vdist = dynamic_cast<const VectorDistInfo *>(&info)) {
+        for (size_t i = 0; i < vdist->data.size(); ++i) {
+            nameDist(vdist->data[i],
+                     prefix + "::" + subName(vdist->subnames, i), names);
+        }
+    } else if (auto v2d = dynamic_cast<const Vector2dInfo *>(&info)) {
+        for (size_t x = 0; x < v2d->x; ++x) {
+            for (size_t y = 0; y < v2d->y; ++y) {
+                names.push_back(prefix + "::" + subName(v2d->subnames, x) +
+                                "::" + subName(v2d->y_subnames, y));
+            }
+        }
+        if (info.flags.isSet(total))
+            names.push_back(prefix + "::total");
+    } else {
+        panic("Unexpected stat type for %s\n", prefix);
+    }
+}
+
+void
+Columnar::appendRecord(RecordType type, const void *data, size_t size)
+{
+    const uint32_t header[2] = {type, 0};
+    const uint64_t payload = size;
+    buffer.insert(buffer.end(), (const char *)header,
+                  (const char *)header + sizeof(header));
+    buffer.insert(buffer.end(), (const char *)&payload,
+                  (const char *)&payload + sizeof(payload));
+    buffer.insert(buffer.end(), (const char *)data,
+                  (const char *)data + size);
+}
+
+void
+Columnar::appendDelta()
+{
+    assert(last.size() == row.size());
+
+    std::vector<char> delta((row.size() + 7) / 8, 0);
+    for (size_t i = 0; i < row.size(); ++i) {
+        // compare the bits so that NaNs that stay NaN are unchanged
+        if (memcmp(&row[i], &last[i], sizeof(double)) == 0)
+            continue;
+        delta[i / 8] |= 1 << (i % 8);
+        delta.insert(delta.end(), (const char *)&row[i],
+                     (const char *)&row[i] + sizeof(double));
+    }
+    appendRecord(Delta, delta.data(), delta.size());
+}
+
+Output *
+initColumnar(const std::string &filename, bool desc, bool delta)
+{
+    static Columnar *columnar = nullptr;
+
+    if (!columnar) {
+        columnar = new Columnar(
+            *simout.findOrCreate(filename, true)->stream(), desc, delta);
+    }
+
+    return columnar;
+}
+
+} // namespace statistics
+} // namespace gem5
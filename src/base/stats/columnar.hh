@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Columnar binary stats output. The names of the stats are written
+ * once, as a schema, and every dump after that is a single row of
+ * doubles. This keeps long time series small and cheap to write, and
+ * does not need any external library.
+ *
+ * The file starts with a header followed by a sequence of records:
+ *
+ *   header:  magic "gem5stat", u32 version, u32 reserved
+ *   record:  u32 type, u32 reserved, u64 payload size, payload
+ *   schema:  u32 num_columns, then per column u32 name length, name,
+ *            u32 description length, description
+ *   row:     num_columns doubles
+ *   delta:   bitmap of (num_columns + 7) / 8 bytes, then one double
+ *            for every bit that is set
+ *
+ * All integers and doubles are in host byte order. A row uses the
+ * columns of the last schema before it. A new schema is only written
+ * when the stats that are dumped change, e.g. when a sub-tree of the
+ * hierarchy is dumped.
+ *
+ * In delta mode, the dumps that follow a row are written as deltas.
+ * Bit i of the bitmap (bit i % 8 of byte i / 8) is set if column i
+ * changed since the last dump, and only the values of those columns
+ * follow. Most stats do not change between periodic dumps, so this
+ * makes them much smaller.
+ *
+ * util/stats_columnar.py converts the files to CSV or pandas frames.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Columnar : public Output
+{
+  public:
+    static constexpr char magic[8] = {'g', 'e', 'm', '5', 's', 't', 'a', 't'};
+    static constexpr uint32_t version = 1;
+
+    enum RecordType : uint32_t
+    {
+        Schema = 1,
+        Row = 2,
+        Delta = 3,
+    };
+
+    /**
+     * @param stream Stream to write to, positioned at the start of the
+     *               file
+     * @param desc Write the descriptions of the stats in the schema
+     * @param delta Only write the values that changed since the last
+     *              dump
+     */
+    Columnar(std::ostream &stream, bool desc, bool delta=false);
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+    /** @return Number of columns in the current schema */
+    size_t columns() const { return names.size(); }
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** The columns of a single stat in a schema. */
+    struct Block
+    {
+        const Info *info;
+        size_t columns;
+
+        bool
+        operator==(const Block &other) const
+        {
+            return info == other.info && columns == other.columns;
+        }
+    };
+
+    /** Skip stats that are not displayed. */
+    bool noOutput(const Info &info) const;
+
+    /** Append the values of a vector stat to the current row. */
+    void appendVector(const VectorInfo &info);
+
+    /** Append the values of a distribution to the current row. */
+    void appendDist(const DistData &data);
+
+    /**
+     * Check the columns just appended for a stat against the schema,
+     * and name them if the schema changed.
+     */
+    void endStat(const Info &info, size_t start);
+
+    /** Append the names of the columns of a stat. */
+    void nameColumns(const Info &info, const std::string &prefix);
+
+    /** Append a record to the output buffer. */
+    void appendRecord(RecordType type, const void *data, size_t size);
+
+    /** Append the changes since the last row to the output buffer. */
+    void appendDelta();
+
+    std::ostream &stream;
+    const bool descriptions;
+    const bool deltas;
+    bool headerWritten;
+
+    /** Names of the enclosing groups */
+    std::vector<const char *> path;
+
+    /** Stats, column names and descriptions of the current schema */
+    std::vector<Block> blocks;
+    std::vector<std::string> names;
+    std::vector<std::string> descs;
+
+    /** Position in the schema, and whether this dump changes it */
+    size_t nextBlock;
+    bool schemaChanged;
+
+    /** Values of the dump in progress */
+    std::vector<double> row;
+
+    /** Values of the last dump, that deltas are relative to */
+    std::vector<double> last;
+
+    /** Records written to the stream when a dump ends */
+    std::vector<char> buffer;
+};
+
+Output *initColumnar(const std::string &filename, bool desc, bool delta);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_COLUMNAR_HH__
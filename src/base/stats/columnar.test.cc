@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/stats/columnar.hh"
+#include "base/stats/info.hh"
+
+using namespace gem5;
+
+class TestScalar : public statistics::ScalarInfo
+{
+  public:
+    double val = 0;
+
+    explicit TestScalar(const std::string &name)
+    {
+        this->name = name;
+        desc = "desc of " + name;
+        flags.set(statistics::init | statistics::display);
+    }
+
+    statistics::Counter value() const override { return val; }
+    statistics::Result result() const override { return val; }
+    statistics::Result total() const override { return val; }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return val == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+class TestVector : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter vals;
+    mutable statistics::VResult results;
+
+    TestVector(const std::string &name, size_t size)
+        : vals(size, 0)
+    {
+        this->name = name;
+        flags.set(statistics::init | statistics::display | statistics::total);
+        subnames = {"first"};
+        subnames.resize(size);
+    }
+
+    statistics::size_type size() const override { return vals.size(); }
+    const statistics::VCounter &value() const override { return vals; }
+
+    const statistics::VResult &
+    result() const override
+    {
+        results.assign(vals.begin(), vals.end());
+        return results;
+    }
+
+    statistics::Result
+    total() const override
+    {
+        statistics::Result sum = 0;
+        for (auto v : vals)
+            sum += v;
+        return sum;
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+};
+
+/** A minimal reader of columnar stat files. */
+struct ColumnarFile
+{
+    struct Schema
+    {
+        std::vector<std::string> names;
+        std::vector<std::string> descs;
+    };
+    std::vector<Schema> schemas;
+    // rows, and the index of the schema each one uses
+    std::vector<std::pair<size_t, std::vector<double>>> rows;
+    // number of rows that were written as deltas
+    size_t deltas = 0;
+
+    explicit ColumnarFile(const std::string &data)
+    {
+        size_t pos = 0;
+        auto get = [&](void *dst, size_t size) {
+            EXPECT_LE(pos + size, data.size());
+            memcpy(dst, data.data() + pos, size);
+            pos += size;
+        };
+        auto get_string = [&]() {
+            uint32_t len;
+            get(&len, sizeof(len));
+            std::string s = data.substr(pos, len);
+            pos += len;
+            return s;
+        };
+
+        char magic[8];
+        uint32_t header[2];
+        get(magic, sizeof(magic));
+        get(header, sizeof(header));
+        EXPECT_EQ(memcmp(magic, statistics::Columnar::magic, 8), 0);
+        EXPECT_EQ(header[0], statistics::Columnar::version);
+
+        while (pos < data.size()) {
+            uint32_t record[2];
+            uint64_t size;
+            get(record, sizeof(record));
+            get(&size, sizeof(size));
+            if (record[0] == statistics::Columnar::Schema) {
+                uint32_t num_columns;
+                get(&num_columns, sizeof(num_columns));
+                Schema schema;
+                for (uint32_t i = 0; i < num_columns; ++i) {
+                    schema.names.push_back(get_string());
+                    schema.descs.push_back(get_string());
+                }
+                schemas.push_back(schema);
+            } else if (record[0] == statistics::Columnar::Delta) {
+                std::vector<double> row = rows.back().second;
+                std::vector<uint8_t> bitmap((row.size() + 7) / 8);
+                get(bitmap.data(), bitmap.size());
+                for (size_t i = 0; i < row.size(); ++i) {
+                    if (bitmap[i / 8] & (1 << (i % 8)))
+                        get(&row[i], sizeof(double));
+                }
+                rows.emplace_back(schemas.size() - 1, row);
+                deltas++;
+            } else {
+                EXPECT_EQ(record[0], statistics::Columnar::Row);
+                std::vector<double> row(size / sizeof(double));
+                get(row.data(), size);
+                rows.emplace_back(schemas.size() - 1, row);
+            }
+        }
+    }
+};
+
+class StatsColumnarTest : public testing::Test
+{
+  protected:
+    std::stringstream stream;
+    statistics::Columnar output{stream, true};
+    TestScalar top{"top"};
+    TestScalar inner{"inner"};
+    TestVector vec{"vec", 2};
+
+    void
+    dump(bool with_inner=true)
+    {
+        output.begin();
+        top.visit(output);
+        output.beginGroup("sys");
+        if (with_inner)
+            inner.visit(output);
+        vec.visit(output);
+        output.endGroup();
+        output.end();
+    }
+};
+
+/** Test that the schema is written once and each dump is a row. */
+TEST_F(StatsColumnarTest, SchemaAndRows)
+{
+    top.val = 1;
+    inner.val = 2;
+    vec.vals = {3, 4};
+    dump();
+    top.val = 5;
+    dump();
+
+    ColumnarFile file(stream.str());
+    ASSERT_EQ(file.schemas.size(), 1u);
+    std::vector<std::string> names = {
+        "top", "sys.inner", "sys.vec::first", "sys.vec::1", "sys.vec::total"};
+    ASSERT_EQ(file.schemas[0].names, names);
+    ASSERT_EQ(file.schemas[0].descs[0], "desc of top");
+
+    ASSERT_EQ(file.rows.size(), 2u);
+    ASSERT_EQ(file.rows[0].second, std::vector<double>({1, 2, 3, 4, 7}));
+    ASSERT_EQ(file.rows[1].second, std::vector<double>({5, 2, 3, 4, 7}));
+}
+
+/** Test that dumping different stats writes a new schema. */
+TEST_F(StatsColumnarTest, SchemaChange)
+{
+    dump();
+    dump(false);
+    dump(false);
+    dump();
+
+    ColumnarFile file(stream.str());
+    ASSERT_EQ(file.schemas.size(), 3u);
+    ASSERT_EQ(file.schemas[1].names.size(), 4u);
+    ASSERT_EQ(file.schemas[1].names[1], "sys.vec::first");
+    ASSERT_EQ(file.schemas[2].names, file.schemas[0].names);
+
+    ASSERT_EQ(file.rows.size(), 4u);
+    ASSERT_EQ(file.rows[0].first, 0u);
+    ASSERT_EQ(file.rows[1].first, 1u);
+    ASSERT_EQ(file.rows[2].first, 1u);
+    ASSERT_EQ(file.rows[3].first, 2u);
+}
+
+/** Test that a shorter dump of the same stats changes the schema. */
+TEST_F(StatsColumnarTest, TruncatedDump)
+{
+    dump();
+    output.begin();
+    top.visit(output);
+    output.end();
+
+    ColumnarFile file(stream.str());
+    ASSERT_EQ(file.schemas.size(), 2u);
+    ASSERT_EQ(file.schemas[1].names, std::vector<std::string>({"top"}));
+    ASSERT_EQ(output.columns(), 1u);
+}
+
+/** Test that only changed values are written in delta mode. */
+TEST(StatsColumnarDeltaTest, DeltaRows)
+{
+    std::stringstream stream;
+    statistics::Columnar output(stream, false, true);
+    std::deque<TestScalar> stats;
+    for (int i = 0; i < 20; ++i)
+        stats.emplace_back("stat" + std::to_string(i));
+
+    auto dump = [&](size_t count) {
+        output.begin();
+        for (size_t i = 0; i < count; ++i)
+            stats[i].visit(output);
+        output.end();
+    };
+
+    dump(20);
+    const size_t full_size = stream.str().size();
+    stats[3].val = 1;
+    stats[17].val = 2;
+    dump(20);
+    // record header, 3 bytes of bitmap and two values
+    ASSERT_EQ(stream.str().size() - full_size, 16u + 3 + 2 * 8);
+    dump(20);
+    // a schema change starts from a full row again
+    dump(10);
+    stats[0].val = 3;
+    dump(10);
+
+    ColumnarFile file(stream.str());
+    ASSERT_EQ(file.rows.size(), 5u);
+    ASSERT_EQ(file.deltas, 3u);
+    ASSERT_EQ(file.rows[1].second[3], 1);
+    ASSERT_EQ(file.rows[1].second[17], 2);
+    ASSERT_EQ(file.rows[2].second, file.rows[1].second);
+    ASSERT_EQ(file.rows[3].second.size(), 10u);
+    ASSERT_EQ(file.rows[4].second[0], 3);
+    ASSERT_EQ(file.rows[4].second[3], 1);
+}
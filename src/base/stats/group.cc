@@ -105,6 +105,25 @@ Group::preDumpStats()
         g.second->preDumpStats();
 }
 
+void
+Group::enableShards(size_type shards, bool parent_sharded)
+{
+    const bool sharded = parent_sharded || _statsSharded;
+
+    if (sharded) {
+        for (auto &s : stats) {
+            fatal_if(!s->shard(shards), "Stat %s can not be sharded, so "
+                     "its group can not be sharded either.\n", s->name);
+        }
+    }
+
+    for (auto &g : mergedStatGroups)
+        g->enableShards(shards, sharded);
+
+    for (auto &g : statGroups)
+        g.second->enableShards(shards, sharded);
+}
+
 void
 Group::addStat(statistics::Info *info)
 {
@@ -43,6 +43,7 @@
 #include <vector>
 
 #include "base/compiler.hh"
+#include "base/stats/types.hh"
 #include "base/stats/units.hh"
 
 namespace gem5
@@ -211,10 +212,53 @@ class Group
      */
     void mergeStatGroup(Group *block);
 
+    /**
+     * Keep one copy of the stats in this group and its sub-groups per
+     * simulation thread.
+     *
+     * Stats that are updated from objects on different event queues,
+     * such as those of a shared crossbar, race when the event queues
+     * run in parallel. Sharded stats let every thread update its own
+     * copy without locks, and the copies are merged when the stats
+     * are prepared for dumping. This has no effect when there is only
+     * one event queue.
+     *
+     * Averages and histograms can not be split into shards, as their
+     * value depends on the order of the updates, so groups holding
+     * them must not be sharded.
+     *
+     * This has to be called before the stats are enabled.
+     *
+     * @param sharded True to shard the stats of this group.
+     *
+     * @ingroup api_stats
+     */
+    void shardStats(bool sharded = true) { _statsSharded = sharded; }
+
+    /**
+     * @return True if the stats of this group have been requested to
+     * be sharded.
+     *
+     * @ingroup api_stats
+     */
+    bool statsSharded() const { return _statsSharded; }
+
+    /**
+     * Split the stats of all groups requesting it into shards. This is
+     * called once, when the stats are enabled.
+     *
+     * @param shards The number of shards, i.e., of event queues.
+     * @param parent_sharded True if a parent group is sharded.
+     */
+    void enableShards(size_type shards, bool parent_sharded = false);
+
   private:
     /** Parent pointer if merged into parent */
     Group *mergedParent;
 
+    /** Whether the stats of this group should be sharded */
+    bool _statsSharded = false;
+
     std::map<std::string, Group *> statGroups;
     std::vector<Group *> mergedStatGroups;
     std::vector<Info *> stats;
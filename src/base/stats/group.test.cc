@@ -485,6 +485,80 @@ TEST(StatsGroupTest, ResetStats)
     ASSERT_EQ(info5.value, 0);
 }
 
+/**
+ * Test that sharding is applied to the stats of the groups requesting it,
+ * and to those of their sub-groups and merged groups.
+ */
+TEST(StatsGroupTest, EnableShards)
+{
+    class ShardInfo : public DummyInfo
+    {
+      public:
+        statistics::size_type shards = 0;
+
+        bool
+        shard(statistics::size_type _shards) override
+        {
+            shards = _shards;
+            return true;
+        }
+    };
+
+    statistics::Group root(nullptr);
+    statistics::Group node1(&root, "Node1");
+    statistics::Group node1_1(&node1, "Node1_1");
+    statistics::Group node1_2(&node1_1);
+    statistics::Group node2(&root, "Node2");
+
+    ShardInfo info;
+    info.setName("InfoEnableShards");
+    root.addStat(&info);
+
+    ShardInfo info2;
+    info2.setName("InfoEnableShards2");
+    node1.addStat(&info2);
+
+    ShardInfo info3;
+    info3.setName("InfoEnableShards3");
+    node1_1.addStat(&info3);
+
+    ShardInfo info4;
+    info4.setName("InfoEnableShards4");
+    node1_2.addStat(&info4);
+
+    ShardInfo info5;
+    info5.setName("InfoEnableShards5");
+    node2.addStat(&info5);
+
+    ASSERT_FALSE(node1.statsSharded());
+    node1.shardStats();
+    ASSERT_TRUE(node1.statsSharded());
+
+    root.enableShards(4);
+    ASSERT_EQ(info.shards, 0);
+    ASSERT_EQ(info2.shards, 4);
+    ASSERT_EQ(info3.shards, 4);
+    ASSERT_EQ(info4.shards, 4);
+    ASSERT_EQ(info5.shards, 0);
+}
+
+/** Test that groups holding stats that can not be sharded are refused. */
+TEST(StatsGroupTest, EnableShardsUnsupported)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(&root, "Node1");
+
+    DummyInfo info;
+    info.setName("InfoEnableShardsUnsupported");
+    node1.addStat(&info);
+
+    // nothing happens as long as the group is not sharded
+    root.enableShards(4);
+
+    node1.shardStats();
+    ASSERT_ANY_THROW(root.enableShards(4));
+}
+
 /**
  * Test that calling preDumpStats calls the respective function of all sub-
  * groups and merged groups.
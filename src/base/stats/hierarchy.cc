@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/hierarchy.hh"
+
+#include <algorithm>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+#include "base/str.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+/**
+ * Check that a stat has been initialized, and hide it from the dumps
+ * by giving it an internal name unless it should be displayed.
+ */
+void
+checkStat(Info *info)
+{
+    if (!info->check() || !info->baseCheck()) {
+        fatal("statistic '%s' (%d) was not properly initialized "
+              "by a regStats() function\n", info->name, info->id);
+    }
+
+    if (!(info->flags & display))
+        info->name = csprintf("__Stat%06d", info->id);
+}
+
+/** Order legacy stats by the components of their dotted names. */
+bool
+nameLess(const Info *a, const Info *b)
+{
+    std::vector<std::string> a_parts, b_parts;
+    tokenize(a_parts, a->name, '.', false);
+    tokenize(b_parts, b->name, '.', false);
+    return a_parts < b_parts;
+}
+
+} // anonymous namespace
+
+void
+Hierarchy::flatten(const Group &group, std::vector<Entry> &entries,
+                   RangeMap *ranges)
+{
+    const size_t start = entries.size();
+
+    for (auto *info : group.getStats())
+        entries.push_back({info, nullptr});
+
+    for (const auto &g : group.getStatGroups()) {
+        entries.push_back({nullptr, g.first.c_str()});
+        flatten(*g.second, entries, ranges);
+        entries.push_back({nullptr, nullptr});
+    }
+
+    if (ranges)
+        (*ranges)[&group] = {start, entries.size()};
+}
+
+void
+Hierarchy::build(Group *root, std::list<Info *> &legacy, size_type shards)
+{
+    entries.clear();
+    ranges.clear();
+
+    if (root)
+        flatten(*root, entries, &ranges);
+    for (const auto &e : entries) {
+        if (e.info)
+            checkStat(e.info);
+    }
+
+    for (auto *info : legacy)
+        checkStat(info);
+    legacy.sort(nameLess);
+
+    legacyStart = entries.size();
+    for (auto *info : legacy)
+        entries.push_back({info, nullptr});
+
+    numStats = 0;
+    for (const auto &e : entries) {
+        if (e.info) {
+            e.info->enable();
+            numStats++;
+        }
+    }
+
+    if (root && shards > 1)
+        root->enableShards(shards);
+}
+
+void
+Hierarchy::prepare() const
+{
+    // legacy stats first, as they have always been prepared that way
+    for (size_t i = legacyStart; i < entries.size(); ++i)
+        entries[i].info->prepare();
+    for (size_t i = 0; i < legacyStart; ++i) {
+        if (entries[i].info)
+            entries[i].info->prepare();
+    }
+}
+
+void
+Hierarchy::visit(Output &output, const Entry *begin, const Entry *end)
+{
+    for (const Entry *e = begin; e != end; ++e) {
+        if (e->info)
+            e->info->visit(output);
+        else if (e->group)
+            output.beginGroup(e->group);
+        else
+            output.endGroup();
+    }
+}
+
+void
+Hierarchy::dump(Output &output) const
+{
+    visit(output, entries.data(), entries.data() + entries.size());
+}
+
+void
+Hierarchy::dump(Output &output, const Group &root,
+                const std::vector<std::string> &path) const
+{
+    for (const auto &p : path)
+        output.beginGroup(p.c_str());
+
+    auto range = ranges.find(&root);
+    if (range != ranges.end()) {
+        visit(output, entries.data() + range->second.first,
+              entries.data() + range->second.second);
+    } else {
+        // the group is not reachable from the root, so it has to be
+        // flattened on the fly
+        std::vector<Entry> group_entries;
+        flatten(root, group_entries, nullptr);
+        visit(output, group_entries.data(),
+              group_entries.data() + group_entries.size());
+    }
+
+    for (size_t i = 0; i < path.size(); ++i)
+        output.endGroup();
+}
+
+} // namespace statistics
+} // namespace gem5
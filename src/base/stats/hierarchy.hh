@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_HIERARCHY_HH__
+#define __BASE_STATS_HIERARCHY_HH__
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Group;
+class Info;
+struct Output;
+
+/**
+ * A flattened view of the stat hierarchy. The groups are walked once
+ * when stats are enabled, and the stats and group boundaries are
+ * recorded in the order in which they are dumped. Preparing and
+ * dumping the stats then is a single pass over a flat list, rather
+ * than a walk of the group maps for every dump.
+ *
+ * Stats and groups cannot be added once stats are enabled, so the
+ * list stays valid for the rest of the simulation.
+ */
+class Hierarchy
+{
+  public:
+    /**
+     * Flatten the hierarchy below a root group, followed by the
+     * legacy stats, then check and enable all of them. The legacy
+     * list is sorted by name in place.
+     *
+     * @param root Root of the hierarchy, or nullptr for none
+     * @param legacy Stats that are not part of any group
+     * @param shards Number of shards for groups requesting them
+     */
+    void build(Group *root, std::list<Info *> &legacy,
+               size_type shards = 1);
+
+    /** Prepare all stats for data access. */
+    void prepare() const;
+
+    /**
+     * Dump the whole hierarchy and the legacy stats.
+     *
+     * @param output Output to visit the stats with
+     */
+    void dump(Output &output) const;
+
+    /**
+     * Dump the hierarchy below a group. The group is entered using the
+     * path of group names leading to it from the root.
+     *
+     * @param output Output to visit the stats with
+     * @param root Group to dump
+     * @param path Names of the groups from the root to the group
+     */
+    void dump(Output &output, const Group &root,
+              const std::vector<std::string> &path) const;
+
+    /** @return Number of stats in the hierarchy, legacy stats included */
+    size_t size() const { return numStats; }
+
+  private:
+    /**
+     * A stat to visit or a group boundary. Stats have an info, group
+     * starts have a name and group ends have neither.
+     */
+    struct Entry
+    {
+        Info *info;
+        const char *group;
+    };
+
+    using RangeMap =
+        std::unordered_map<const Group *, std::pair<size_t, size_t>>;
+
+    /**
+     * Append the contents of a group to a list of entries.
+     *
+     * @param group Group to flatten
+     * @param entries List to append to
+     * @param ranges If not null, where to record the entries of each
+     *               group
+     */
+    static void flatten(const Group &group, std::vector<Entry> &entries,
+                        RangeMap *ranges);
+
+    /** Visit a range of entries. */
+    static void visit(Output &output, const Entry *begin, const Entry *end);
+
+    /** Stats and group boundaries, in dump order */
+    std::vector<Entry> entries;
+
+    /** Index in entries of the first legacy stat */
+    size_t legacyStart = 0;
+
+    /** Range of entries that covers the contents of each group */
+    RangeMap ranges;
+
+    size_t numStats = 0;
+};
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_HIERARCHY_HH__
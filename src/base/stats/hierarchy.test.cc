@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "base/stats/group.hh"
+#include "base/stats/hierarchy.hh"
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+
+using namespace gem5;
+
+/** An output that records the order in which it is visited. */
+class RecordingOutput : public statistics::Output
+{
+  public:
+    std::vector<std::string> events;
+    void record(const std::string &event) { events.push_back(event); }
+
+    void begin() override {}
+    void end() override {}
+    bool valid() const override { return true; }
+    void beginGroup(const char *name) override { record(name); }
+    void endGroup() override { record("/"); }
+
+    void visit(const statistics::ScalarInfo &info) override {}
+    void visit(const statistics::VectorInfo &info) override {}
+    void visit(const statistics::DistInfo &info) override {}
+    void visit(const statistics::VectorDistInfo &info) override {}
+    void visit(const statistics::Vector2dInfo &info) override {}
+    void visit(const statistics::FormulaInfo &info) override {}
+    void visit(const statistics::SparseHistInfo &info) override {}
+};
+
+class DummyInfo : public statistics::Info
+{
+  public:
+    int prepared = 0;
+    bool enabled = false;
+
+    DummyInfo(const std::string &name,
+              statistics::FlagsType flags=statistics::display)
+    {
+        this->name = name;
+        this->flags.set(statistics::init | flags);
+    }
+
+    bool check() const override { return true; }
+    void enable() override { enabled = true; }
+    void prepare() override { prepared++; }
+    void reset() override {}
+    bool zero() const override { return false; }
+
+    void
+    visit(statistics::Output &visitor) override
+    {
+        static_cast<RecordingOutput &>(visitor).record(name);
+    }
+};
+
+class StatsHierarchyTest : public testing::Test
+{
+  protected:
+    statistics::Group root{nullptr};
+    statistics::Group b{&root, "b"};
+    statistics::Group a{&root, "a"};
+    statistics::Group a1{&a, "a1"};
+    DummyInfo rootStat{"rootStat"};
+    DummyInfo aStat{"aStat"};
+    DummyInfo a1Stat{"a1Stat"};
+    DummyInfo bStat{"bStat"};
+    DummyInfo legacyB{"legacy.b"};
+    DummyInfo legacyA{"legacy.a"};
+    std::list<statistics::Info *> legacy;
+    statistics::Hierarchy hierarchy;
+
+    void
+    SetUp() override
+    {
+        root.addStat(&rootStat);
+        a.addStat(&aStat);
+        a1.addStat(&a1Stat);
+        b.addStat(&bStat);
+        legacy = {&legacyB, &legacyA};
+        hierarchy.build(&root, legacy);
+    }
+};
+
+/** Test that a full dump visits groups in name order, then legacy stats. */
+TEST_F(StatsHierarchyTest, DumpAll)
+{
+    RecordingOutput output;
+    hierarchy.dump(output);
+
+    std::vector<std::string> expected = {
+        "rootStat", "a", "aStat", "a1", "a1Stat", "/", "/",
+        "b", "bStat", "/", "legacy.a", "legacy.b"};
+    ASSERT_EQ(output.events, expected);
+    ASSERT_EQ(hierarchy.size(), 6u);
+}
+
+/** Test dumping a sub-group, entered through its path. */
+TEST_F(StatsHierarchyTest, DumpGroup)
+{
+    RecordingOutput output;
+    hierarchy.dump(output, a, {"a"});
+
+    std::vector<std::string> expected = {
+        "a", "aStat", "a1", "a1Stat", "/", "/"};
+    ASSERT_EQ(output.events, expected);
+}
+
+/** Test dumping a group that is not part of the hierarchy. */
+TEST_F(StatsHierarchyTest, DumpDetachedGroup)
+{
+    statistics::Group detached(nullptr);
+    DummyInfo stat("detachedStat");
+    detached.addStat(&stat);
+
+    RecordingOutput output;
+    hierarchy.dump(output, detached, {"x", "y"});
+
+    std::vector<std::string> expected = {"x", "y", "detachedStat", "/", "/"};
+    ASSERT_EQ(output.events, expected);
+}
+
+/** Test that building enables and sorts stats, and preparing reaches all. */
+TEST_F(StatsHierarchyTest, EnablePrepare)
+{
+    for (auto *info : {&rootStat, &aStat, &a1Stat, &bStat,
+                       &legacyA, &legacyB})
+        ASSERT_TRUE(info->enabled);
+    ASSERT_EQ(legacy.front(), &legacyA);
+
+    hierarchy.prepare();
+    for (auto *info : {&rootStat, &aStat, &a1Stat, &bStat,
+                       &legacyA, &legacyB})
+        ASSERT_EQ(info->prepared, 1);
+}
+
+/** Test that stats that are not displayed get an internal name. */
+TEST(StatsHierarchyHiddenTest, HiddenStat)
+{
+    statistics::Group root(nullptr);
+    DummyInfo hidden("hidden", statistics::none);
+    root.addStat(&hidden);
+    std::list<statistics::Info *> legacy;
+
+    statistics::Hierarchy hierarchy;
+    hierarchy.build(&root, legacy);
+    ASSERT_EQ(hidden.name.substr(0, 6), "__Stat");
+}
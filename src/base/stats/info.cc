@@ -193,6 +193,12 @@ Info::enable()
 {
 }
 
+bool
+Info::shard(size_type shards)
+{
+    return false;
+}
+
 void
 VectorInfo::enable()
 {
@@ -140,6 +140,16 @@ class Info
      */
     virtual void enable();
 
+    /**
+     * Split the stat into one shard per simulation thread so that
+     * threads can update it concurrently without locks. The shards are
+     * merged when the stat is prepared for dumping.
+     *
+     * @param shards The number of shards.
+     * @return false if the stat does not support sharding.
+     */
+    virtual bool shard(size_type shards);
+
     /**
      * Prepare the stat for dumping.
      */
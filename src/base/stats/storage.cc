@@ -41,6 +41,7 @@
 
 #include "base/stats/storage.hh"
 
+#include <algorithm>
 #include <cmath>
 
 namespace gem5
@@ -49,8 +50,10 @@ namespace gem5
 namespace statistics
 {
 
+__thread size_type _curShard = 0;
+
 void
-DistStor::sample(Counter val, int number)
+DistStor::addSample(Counter val, int number)
 {
     assert(bucket_size > 0);
     if (val < min_track)
@@ -72,6 +75,58 @@ DistStor::sample(Counter val, int number)
     samples += number;
 }
 
+void
+DistStor::addSamples(const Counter *vals, size_type count)
+{
+    assert(bucket_size > 0);
+
+    Counter lo = min_val, hi = max_val, s = sum, sq = squares;
+    for (size_type i = 0; i < count; ++i) {
+        const Counter val = vals[i];
+        lo = val < lo ? val : lo;
+        hi = val > hi ? val : hi;
+        s += val;
+        sq += val * val;
+    }
+    min_val = lo;
+    max_val = hi;
+    sum = s;
+    squares = sq;
+    samples += count;
+
+    for (size_type i = 0; i < count; ++i) {
+        const Counter val = vals[i];
+        if (val < min_track)
+            underflow += 1;
+        else if (val > max_track)
+            overflow += 1;
+        else
+            cvec[std::floor((val - min_track) / bucket_size)] += 1;
+    }
+}
+
+void
+DistStor::add(DistStor *other)
+{
+    flush();
+    other->flush();
+
+    assert(size() == other->size());
+    assert(min_track == other->min_track);
+    assert(bucket_size == other->bucket_size);
+
+    min_val = std::min(min_val, other->min_val);
+    max_val = std::max(max_val, other->max_val);
+    underflow += other->underflow;
+    overflow += other->overflow;
+    sum += other->sum;
+    squares += other->squares;
+    samples += other->samples;
+
+    for (off_type i = 0; i < size(); ++i)
+        cvec[i] += other->cvec[i];
+}
+
 void
 HistStor::growOut()
 {
@@ -173,7 +228,7 @@ HistStor::growUp()
 }
 
 void
-HistStor::sample(Counter val, int number)
+HistStor::grow(Counter val)
 {
     assert(min_bucket < max_bucket);
     if (val < min_bucket) {
@@ -191,6 +246,12 @@ HistStor::sample(Counter val, int number)
                 growOut();
         }
     }
+}
+
+void
+HistStor::addSample(Counter val, int number)
+{
+    grow(val);
 
     assert(bucket_size > 0);
     size_type index =
@@ -205,9 +266,41 @@ HistStor::sample(Counter val, int number)
     samples += number;
 }
 
+void
+HistStor::addSamples(const Counter *vals, size_type count)
+{
+    Counter s = sum, sq = squares, l = logs;
+    for (size_type i = 0; i < count; ++i) {
+        const Counter val = vals[i];
+        s += val;
+        sq += val * val;
+        l += std::log(val);
+    }
+    sum = s;
+    squares = sq;
+    logs = l;
+    samples += count;
+
+    // the buckets can only grow in the order the values were sampled,
+    // as growing merges buckets differently depending on the range
+    for (size_type i = 0; i < count; ++i) {
+        const Counter val = vals[i];
+        if (val < min_bucket || val >= max_bucket + bucket_size)
+            grow(val);
+
+        size_type index =
+            (int64_t)std::floor((val - min_bucket) / bucket_size);
+        assert(index < size());
+        cvec[index] += 1;
+    }
+}
+
 void
 HistStor::add(HistStor *hs)
 {
+    flush();
+    hs->flush();
+
     int b_size = hs->size();
     assert(size() == b_size);
     assert(min_bucket == hs->min_bucket);
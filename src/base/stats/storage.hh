@@ -30,8 +30,10 @@
 #ifndef __BASE_STATS_STORAGE_HH__
 #define __BASE_STATS_STORAGE_HH__
 
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <memory>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
@@ -50,14 +52,65 @@ struct StorageParams
     virtual ~StorageParams() = default;
 };
 
+/**
+ * Number of single samples that distributions and histograms buffer
+ * before adding them to their buckets in one batch.
+ */
+constexpr size_type sampleBufferSize = 16;
+
+/**
+ * Index of the stat shard that the current thread updates. Every
+ * simulation thread sets this to the index of the event queue it runs.
+ */
+extern __thread size_type _curShard;
+
+/** @return The stat shard updated by the current thread. */
+inline size_type curShard() { return _curShard; }
+
+/** Set the stat shard updated by the current thread. */
+inline void curShard(size_type shard) { _curShard = shard; }
+
 /**
  * Templatized storage and interface for a simple scalar stat.
+ *
+ * A stat that is updated from several simulation threads can be split
+ * into shards, one per thread. Each thread then only writes to its own
+ * shard, which needs neither locks nor atomics, and the shards are
+ * folded back into the value when the stat is prepared for dumping.
  */
 class StatStor
 {
   private:
+    /** A partial value, kept on its own cache line. */
+    struct alignas(64) Shard
+    {
+        Counter data = Counter();
+    };
+
     /** The statistic value. */
     Counter data;
+    /** The per-thread partial values, if the stat is sharded. */
+    std::unique_ptr<Shard[]> shards;
+    /** The number of shards. */
+    size_type numShards;
+
+    /** Add the shards to the value and clear them. */
+    void
+    fold()
+    {
+        for (size_type i = 0; i < numShards; ++i) {
+            data += shards[i].data;
+            shards[i].data = Counter();
+        }
+    }
+
+    /** @return The shard of the current thread. */
+    Counter &
+    local()
+    {
+        assert(curShard() < numShards);
+        return shards[curShard()].data;
+    }
 
   public:
     struct Params : public StorageParams {};
@@ -67,53 +120,99 @@ class StatStor
      * datatype.
      */
     StatStor(const StorageParams* const storage_params)
-        : data(Counter())
+        : data(Counter()), numShards(0)
     { }
 
+    /**
+     * Split this stat into one shard per simulation thread.
+     * @param shards The number of shards, 1 or less merges them again.
+     * @return Always true, this storage can be sharded.
+     */
+    bool
+    shard(size_type shards)
+    {
+        fold();
+        this->shards.reset(shards > 1 ? new Shard[shards] : nullptr);
+        numShards = shards > 1 ? shards : 0;
+        return true;
+    }
+
     /**
      * The the stat to the given value.
      * @param val The new value.
      */
-    void set(Counter val) { data = val; }
+    void
+    set(Counter val)
+    {
+        fold();
+        data = val;
+    }
 
     /**
      * Increment the stat by the given value.
      * @param val The new value.
      */
-    void inc(Counter val) { data += val; }
+    void
+    inc(Counter val)
+    {
+        if (GEM5_UNLIKELY(shards))
+            local() += val;
+        else
+            data += val;
+    }
 
     /**
      * Decrement the stat by the given value.
      * @param val The new value.
      */
-    void dec(Counter val) { data -= val; }
+    void
+    dec(Counter val)
+    {
+        if (GEM5_UNLIKELY(shards))
+            local() -= val;
+        else
+            data -= val;
+    }
 
     /**
      * Return the value of this stat as its base type.
      * @return The value of this stat.
      */
-    Counter value() const { return data; }
+    Counter
+    value() const
+    {
+        Counter val = data;
+        for (size_type i = 0; i < numShards; ++i)
+            val += shards[i].data;
+        return val;
+    }
 
     /**
      * Return the value of this stat as a result type.
      * @return The value of this stat.
      */
-    Result result() const { return (Result)data; }
+    Result result() const { return (Result)value(); }
 
     /**
      * Prepare stat data for dumping or serialization
      */
-    void prepare(const StorageParams* const storage_params) { }
+    void prepare(const StorageParams* const storage_params) { fold(); }
 
     /**
      * Reset stat value to default
      */
-    void reset(const StorageParams* const storage_params) { data = Counter(); }
+    void
+    reset(const StorageParams* const storage_params)
+    {
+        data = Counter();
+        for (size_type i = 0; i < numShards; ++i)
+            shards[i].data = Counter();
+    }
 
     /**
      * @return true if zero value
      */
-    bool zero() const { return data == Counter(); }
+    bool zero() const { return value() == Counter(); }
 };
 
 /**
@@ -145,6 +244,13 @@ class AvgStor
         : current(0), lastReset(0), total(0), last(0)
     { }
 
+    /**
+     * The running average depends on the order of all updates, so it
+     * cannot be split into shards.
+     * @return Always false.
+     */
+    bool shard(size_type shards) { return false; }
+
     /**
      * Set the current count to the one provided, update the total and last
      * set values.
@@ -256,6 +362,25 @@ class DistStor
     /** Counter for each bucket. */
     VCounter cvec;
 
+    /** Single samples that have not been added to the buckets yet. */
+    std::array<Counter, sampleBufferSize> pending;
+    /** The number of pending samples. */
+    size_type numPending;
+
+    /**
+     * Add a value to the distribution for the given number of times,
+     * bypassing the pending samples.
+     */
+    void addSample(Counter val, int number);
+
+    /**
+     * Add a batch of values to the distribution, once each. The
+     * running sums and extremes are updated in one pass and the
+     * buckets in another, so that both loops are simple enough for the
+     * compiler to keep in registers and vectorize.
+     */
+    void addSamples(const Counter *vals, size_type count);
+
   public:
     /** The parameters for a distribution stat. */
     struct Params : public DistParams
@@ -284,18 +409,68 @@ class DistStor
         }
     };
 
+    /**
+     * Samples can be split into per-thread shards, as the buckets are
+     * fixed and the shards can be added together.
+     */
+    static constexpr bool shardable = true;
+
     DistStor(const StorageParams* const storage_params)
         : cvec(safe_cast<const Params *>(storage_params)->buckets)
     {
         reset(storage_params);
     }
 
+    /**
+     * Adds the contents of the given storage to this storage. Both
+     * storages must have the same parameters.
+     * @param other The other storage to be added.
+     */
+    void add(DistStor *other);
+
     /**
      * Add a value to the distribution for the given number of times.
+     * Single samples are buffered and added in batches.
      * @param val The value to add.
      * @param number The number of times to add the value.
      */
-    void sample(Counter val, int number);
+    void
+    sample(Counter val, int number)
+    {
+        if (number != 1) {
+            flush();
+            addSample(val, number);
+            return;
+        }
+
+        pending[numPending++] = val;
+        if (numPending == sampleBufferSize)
+            flush();
+    }
+
+    /**
+     * Add a batch of values to the distribution, once each.
+     * @param vals The values to add.
+     * @param count The number of values.
+     */
+    void
+    sampleN(const Counter *vals, size_type count)
+    {
+        flush();
+        addSamples(vals, count);
+    }
+
+    /**
+     * Add the pending samples to the distribution.
+     */
+    void
+    flush()
+    {
+        if (numPending) {
+            addSamples(pending.data(), numPending);
+            numPending = 0;
+        }
+    }
 
     /**
      * Return the number of buckets in this distribution.
@@ -310,7 +485,7 @@ class DistStor
     bool
     zero() const
     {
-        return samples == Counter();
+        return samples == Counter() && numPending == 0;
     }
 
     void
@@ -318,6 +493,7 @@ class DistStor
     {
         const Params *params = safe_cast<const Params *>(storage_params);
 
+        flush();
         assert(params->type == Dist);
         data.type = params->type;
         data.min = params->min;
@@ -348,6 +524,7 @@ class DistStor
         min_track = params->min;
         max_track = params->max;
         bucket_size = params->bucket_size;
+        numPending = 0;
 
         min_val = CounterLimits::max();
         max_val = CounterLimits::min();
@@ -416,6 +593,29 @@ class HistStor
     /** Counter for each bucket. */
     VCounter cvec;
 
+    /** Single samples that have not been added to the buckets yet. */
+    std::array<Counter, sampleBufferSize> pending;
+    /** The number of pending samples. */
+    size_type numPending;
+
+    /**
+     * Grow the buckets until they cover the given value.
+     */
+    void grow(Counter val);
+
+    /**
+     * Add a value to the distribution for the given number of times,
+     * bypassing the pending samples.
+     */
+    void addSample(Counter val, int number);
+
+    /**
+     * Add a batch of values to the distribution, once each. The
+     * running sums are updated in a separate pass from the buckets,
+     * which may have to grow in between samples.
+     */
+    void addSamples(const Counter *vals, size_type count);
+
     /**
      * Given a bucket size B, and a range of values [0, N], this function
      * doubles the bucket size to double the range of values towards the
@@ -470,6 +670,13 @@ class HistStor
         }
     };
 
+    /**
+     * The buckets of every shard would grow on their own, and shards
+     * whose ranges grew in different directions can not be added, so
+     * histograms are never sharded.
+     */
+    static constexpr bool shardable = false;
+
     HistStor(const StorageParams* const storage_params)
         : cvec(safe_cast<const Params *>(storage_params)->buckets)
     {
@@ -484,10 +691,47 @@ class HistStor
 
     /**
      * Add a value to the distribution for the given number of times.
+     * Single samples are buffered and added in batches.
      * @param val The value to add.
      * @param number The number of times to add the value.
      */
-    void sample(Counter val, int number);
+    void
+    sample(Counter val, int number)
+    {
+        if (number != 1) {
+            flush();
+            addSample(val, number);
+            return;
+        }
+
+        pending[numPending++] = val;
+        if (numPending == sampleBufferSize)
+            flush();
+    }
+
+    /**
+     * Add a batch of values to the distribution, once each.
+     * @param vals The values to add.
+     * @param count The number of values.
+     */
+    void
+    sampleN(const Counter *vals, size_type count)
+    {
+        flush();
+        addSamples(vals, count);
+    }
+
+    /**
+     * Add the pending samples to the distribution.
+     */
+    void
+    flush()
+    {
+        if (numPending) {
+            addSamples(pending.data(), numPending);
+            numPending = 0;
+        }
+    }
 
     /**
      * Return the number of buckets in this distribution.
@@ -502,7 +746,7 @@ class HistStor
     bool
     zero() const
     {
-        return samples == Counter();
+        return samples == Counter() && numPending == 0;
     }
 
     void
@@ -510,6 +754,7 @@ class HistStor
     {
         const Params *params = safe_cast<const Params *>(storage_params);
 
+        flush();
         assert(params->type == Hist);
         data.type = params->type;
         data.min = min_bucket;
@@ -540,6 +785,7 @@ class HistStor
         min_bucket = 0;
         max_bucket = params->buckets - 1;
         bucket_size = 1;
+        numPending = 0;
 
         size_type size = cvec.size();
         for (off_type i = 0; i < size; ++i)
@@ -572,6 +818,9 @@ class SampleStor
         Params() : DistParams(Deviation) {}
     };
 
+    /** The sums of shards can simply be added together. */
+    static constexpr bool shardable = true;
+
     /**
      * Create and initialize this storage.
      */
@@ -579,6 +828,18 @@ class SampleStor
         : sum(Counter()), squares(Counter()), samples(Counter())
     { }
 
+    /**
+     * Adds the contents of the given storage to this storage.
+     * @param other The other storage to be added.
+     */
+    void
+    add(SampleStor *other)
+    {
+        sum += other->sum;
+        squares += other->squares;
+        samples += other->samples;
+    }
+
     /**
      * Add a value the given number of times to this running average.
      * Update the running sum and sum of squares, increment the number of
@@ -594,6 +855,24 @@ class SampleStor
         samples += number;
     }
 
+    /**
+     * Add a batch of values, once each.
+     * @param vals The values to add.
+     * @param count The number of values.
+     */
+    void
+    sampleN(const Counter *vals, size_type count)
+    {
+        Counter s = sum, sq = squares;
+        for (size_type i = 0; i < count; ++i) {
+            s += vals[i];
+            sq += vals[i] * vals[i];
+        }
+        sum = s;
+        squares = sq;
+        samples += count;
+    }
+
     /**
      * Return the number of entries in this stat, 1
      * @return 1.
@@ -648,6 +927,9 @@ class AvgSampleStor
         Params() : DistParams(Deviation) {}
     };
 
+    /** The sums of shards can simply be added together. */
+    static constexpr bool shardable = true;
+
     /**
      * Create and initialize this storage.
      */
@@ -655,6 +937,17 @@ class AvgSampleStor
         : sum(Counter()), squares(Counter())
     {}
 
+    /**
+     * Adds the contents of the given storage to this storage.
+     * @param other The other storage to be added.
+     */
+    void
+    add(AvgSampleStor *other)
+    {
+        sum += other->sum;
+        squares += other->squares;
+    }
+
     /**
      * Add a value to the distribution for the given number of times.
      * Update the running sum and sum of squares.
@@ -668,6 +961,23 @@ class AvgSampleStor
         squares += val * val * number;
     }
 
+    /**
+     * Add a batch of values, once each.
+     * @param vals The values to add.
+     * @param count The number of values.
+     */
+    void
+    sampleN(const Counter *vals, size_type count)
+    {
+        Counter s = sum, sq = squares;
+        for (size_type i = 0; i < count; ++i) {
+            s += vals[i];
+            sq += vals[i] * vals[i];
+        }
+        sum = s;
+        squares = sq;
+    }
+
     /**
      * Return the number of entries, in this case 1.
      * @return 1.
@@ -725,11 +1035,26 @@ class SparseHistStor
         Params() : DistParams(Hist) {}
     };
 
+    /** The buckets of shards can simply be added together. */
+    static constexpr bool shardable = true;
+
     SparseHistStor(const StorageParams* const storage_params)
     {
         reset(storage_params);
     }
 
+    /**
+     * Adds the contents of the given storage to this storage.
+     * @param other The other storage to be added.
+     */
+    void
+    add(SparseHistStor *other)
+    {
+        for (const auto &bucket : other->cmap)
+            cmap[bucket.first] += bucket.second;
+        samples += other->samples;
+    }
+
     /**
      * Add a value to the distribution for the given number of times.
      * @param val The value to add.
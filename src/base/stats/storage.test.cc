@@ -30,6 +30,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <thread>
+#include <vector>
 
 #include "base/gtest/cur_tick_fake.hh"
 #include "base/gtest/logging.hh"
@@ -129,6 +131,69 @@ TEST(StatsStatStorTest, ZeroReset)
     ASSERT_FALSE(stor.zero());
 }
 
+/**
+ * Test that the updates of every thread go to its own shard, and that the
+ * shards are folded into the value.
+ */
+TEST(StatsStatStorTest, Shard)
+{
+    statistics::StatStor stor(nullptr);
+    stor.set(5);
+    ASSERT_TRUE(stor.shard(4));
+    ASSERT_EQ(stor.value(), 5);
+
+    for (statistics::size_type i = 0; i < 4; ++i) {
+        statistics::curShard(i);
+        stor.inc(i + 1);
+    }
+    statistics::curShard(2);
+    stor.dec(1);
+    statistics::curShard(0);
+    ASSERT_EQ(stor.value(), 14);
+    ASSERT_FALSE(stor.zero());
+
+    stor.prepare(nullptr);
+    ASSERT_EQ(stor.value(), 14);
+
+    stor.inc(1);
+    stor.set(3);
+    ASSERT_EQ(stor.value(), 3);
+
+    stor.reset(nullptr);
+    ASSERT_TRUE(stor.zero());
+
+    // merging the shards again keeps the value
+    stor.inc(7);
+    ASSERT_TRUE(stor.shard(1));
+    ASSERT_EQ(stor.value(), 7);
+    stor.inc(1);
+    ASSERT_EQ(stor.value(), 8);
+}
+
+/** Test that threads can update their shards concurrently. */
+TEST(StatsStatStorTest, ShardThreads)
+{
+    const statistics::size_type num_threads = 4;
+    const int num_incs = 100000;
+
+    statistics::StatStor stor(nullptr);
+    stor.shard(num_threads);
+
+    std::vector<std::thread> threads;
+    for (statistics::size_type i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&stor, i]() {
+            statistics::curShard(i);
+            for (int j = 0; j < num_incs; ++j)
+                stor.inc(1);
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    stor.prepare(nullptr);
+    ASSERT_EQ(stor.value(), num_threads * num_incs);
+}
+
 /** Test setting and getting a value to the storage. */
 TEST(StatsAvgStorTest, SetValueResult)
 {
@@ -434,6 +499,97 @@ TEST(StatsDistStorTest, SamplePrepareMultiple)
     prepareCheckDistStor(params, values, num_values, expected_data);
 }
 
+/**
+ * Test that buffered single samples and batches of samples give the same
+ * distribution as the samples added one by one.
+ */
+TEST(StatsDistStorTest, SampleN)
+{
+    statistics::DistStor::Params params(0, 99, 5);
+    statistics::DistStor single(&params);
+    statistics::DistStor batch(&params);
+    statistics::DistStor weighted(&params);
+
+    // more values than are buffered, with underflows and overflows
+    std::vector<statistics::Counter> values;
+    for (int i = 0; i < 3 * statistics::sampleBufferSize + 5; i++)
+        values.push_back((i * 37) % 131 - 10);
+
+    for (auto val : values) {
+        single.sample(val, 1);
+        // samples with a weight bypass the buffer
+        weighted.sample(val, 2);
+    }
+    batch.sampleN(values.data(), 7);
+    batch.sampleN(values.data() + 7, values.size() - 7);
+
+    statistics::DistData single_data, batch_data, weighted_data;
+    single.prepare(&params, single_data);
+    batch.prepare(&params, batch_data);
+    weighted.prepare(&params, weighted_data);
+
+    checkExpectedDistData(batch_data, single_data, true);
+    ASSERT_EQ(single_data.samples, values.size());
+    ASSERT_EQ(weighted_data.samples, 2 * single_data.samples);
+    ASSERT_EQ(weighted_data.sum, 2 * single_data.sum);
+    ASSERT_EQ(weighted_data.squares, 2 * single_data.squares);
+    ASSERT_EQ(weighted_data.underflow, 2 * single_data.underflow);
+    ASSERT_EQ(weighted_data.overflow, 2 * single_data.overflow);
+    ASSERT_EQ(weighted_data.min_val, single_data.min_val);
+    ASSERT_EQ(weighted_data.max_val, single_data.max_val);
+    for (int i = 0; i < params.buckets; i++)
+        ASSERT_EQ(weighted_data.cvec[i], 2 * single_data.cvec[i]);
+}
+
+/** Test that buffered samples are accounted for by zero and reset. */
+TEST(StatsDistStorTest, PendingZeroReset)
+{
+    statistics::DistStor::Params params(0, 99, 5);
+    statistics::DistStor stor(&params);
+
+    stor.sample(10, 1);
+    ASSERT_FALSE(stor.zero());
+
+    stor.reset(&params);
+    ASSERT_TRUE(stor.zero());
+
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.samples, 0);
+}
+
+/**
+ * Test that adding distributions, as done when merging shards, gives the
+ * same distribution as sampling all values into one storage.
+ */
+TEST(StatsDistStorTest, Add)
+{
+    statistics::DistStor::Params params(0, 99, 5);
+    statistics::DistStor all(&params);
+    statistics::DistStor stor(&params);
+    statistics::DistStor other(&params);
+
+    // the second half has smaller values, with underflows
+    ValueSamples values[] = {{10, 5}, {1234, 2}, {52, 1}, {18, 1},
+        {-10, 4}, {0, 1}, {3, 1}, {99, 15}};
+    int num_values = sizeof(values) / sizeof(ValueSamples);
+    for (int i = 0; i < num_values; i++) {
+        all.sample(values[i].value, values[i].numSamples);
+        auto &half = (i < num_values / 2) ? stor : other;
+        half.sample(values[i].value, values[i].numSamples);
+    }
+    ASSERT_FALSE(other.zero());
+
+    stor.add(&other);
+
+    statistics::DistData data, expected_data;
+    stor.prepare(&params, data);
+    all.prepare(&params, expected_data);
+    checkExpectedDistData(data, expected_data, true);
+    ASSERT_EQ(data.min_val, -10);
+    ASSERT_EQ(data.max_val, 1234);
+}
+
 /** Test resetting storage. */
 TEST(StatsDistStorTest, Reset)
 {
@@ -970,6 +1126,61 @@ TEST(StatsHistStorTest, Add)
     checkExpectedDistData(merge_data, expected_data, false);
 }
 
+/**
+ * Test that buffered single samples and batches of samples give the same
+ * histogram as the samples added one by one, while the buckets grow.
+ */
+TEST(StatsHistStorTest, SampleN)
+{
+    statistics::HistStor::Params params(5);
+    statistics::HistStor single(&params);
+    statistics::HistStor batch(&params);
+    statistics::HistStor weighted(&params);
+
+    std::vector<statistics::Counter> values;
+    for (int i = 0; i < 3 * statistics::sampleBufferSize + 5; i++)
+        values.push_back((i * i * 7) % 97 + 1);
+
+    for (auto val : values) {
+        single.sample(val, 1);
+        // samples with a weight bypass the buffer
+        weighted.sample(val, 2);
+    }
+    batch.sampleN(values.data(), 7);
+    batch.sampleN(values.data() + 7, values.size() - 7);
+
+    statistics::DistData single_data, batch_data, weighted_data;
+    single.prepare(&params, single_data);
+    batch.prepare(&params, batch_data);
+    weighted.prepare(&params, weighted_data);
+
+    checkExpectedDistData(batch_data, single_data, false);
+    ASSERT_EQ(single_data.samples, values.size());
+    ASSERT_EQ(weighted_data.samples, 2 * single_data.samples);
+    ASSERT_EQ(weighted_data.bucket_size, single_data.bucket_size);
+    for (int i = 0; i < params.buckets; i++)
+        ASSERT_EQ(weighted_data.cvec[i], 2 * single_data.cvec[i]);
+}
+
+/** Test that adding histograms includes their buffered samples. */
+TEST(StatsHistStorTest, AddPending)
+{
+    statistics::HistStor::Params params(5);
+    statistics::HistStor stor(&params);
+    statistics::HistStor other(&params);
+
+    stor.sample(1, 1);
+    other.sample(2, 1);
+    ASSERT_FALSE(other.zero());
+    stor.add(&other);
+
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.samples, 2);
+    ASSERT_EQ(data.cvec[1], 1);
+    ASSERT_EQ(data.cvec[2], 1);
+}
+
 /**
  * Test whether zero is correctly set as the reset value. The test order is
  * to check if it is initially zero on creation, then it is made non zero,
@@ -1062,6 +1273,24 @@ TEST(StatsSampleStorTest, Size)
     ASSERT_EQ(stor.size(), 1);
 }
 
+/** Test that adding storages adds their sums and samples. */
+TEST(StatsSampleStorTest, Add)
+{
+    statistics::SampleStor::Params params;
+    statistics::SampleStor stor(&params);
+    statistics::SampleStor other(&params);
+
+    stor.sample(10, 2);
+    other.sample(3, 5);
+    stor.add(&other);
+
+    statistics::DistData data;
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.sum, 10 * 2 + 3 * 5);
+    ASSERT_EQ(data.squares, 10 * 10 * 2 + 3 * 3 * 5);
+    ASSERT_EQ(data.samples, 7);
+}
+
 /**
  * Test whether zero is correctly set as the reset value. The test order is
  * to check if it is initially zero on creation, then it is made non zero,
@@ -1214,3 +1443,24 @@ TEST(StatsSparseHistStorTest, SamplePrepare)
     }
     ASSERT_EQ(data.samples, total_samples);
 }
+
+/** Test that adding storages adds the samples of every value. */
+TEST(StatsSparseHistStorTest, Add)
+{
+    statistics::SparseHistStor stor(nullptr);
+    statistics::SparseHistStor other(nullptr);
+
+    stor.sample(10, 5);
+    stor.sample(1234, 2);
+    other.sample(10, 3);
+    other.sample(7, 1);
+    stor.add(&other);
+
+    statistics::SparseHistData data;
+    stor.prepare(nullptr, data);
+    ASSERT_EQ(stor.size(), 3);
+    ASSERT_EQ(data.cmap[10], 8);
+    ASSERT_EQ(data.cmap[1234], 2);
+    ASSERT_EQ(data.cmap[7], 1);
+    ASSERT_EQ(data.samples, 11);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/thread_pool.hh"
+
+#include <algorithm>
+
+namespace gem5
+{
+
+ThreadPool::ThreadPool(unsigned num_threads)
+{
+    if (num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    workers.reserve(num_threads - 1);
+    for (unsigned i = 1; i < num_threads; i++)
+        workers.emplace_back(&ThreadPool::workerMain, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &t : workers)
+        t.join();
+}
+
+void
+ThreadPool::drainJob()
+{
+    for (size_t i = next++; i < jobCount; i = next++)
+        (*job)(i);
+}
+
+void
+ThreadPool::workerMain()
+{
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+
+        drainJob();
+
+        std::lock_guard<std::mutex> lock(m);
+        if (--busy == 0)
+            done.notify_one();
+    }
+}
+
+void
+ThreadPool::parallelFor(size_t count, const Job &fn)
+{
+    if (count == 0)
+        return;
+
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; i++)
+            fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+        job = &fn;
+        jobCount = count;
+        next = 0;
+        busy = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    drainJob();
+
+    std::unique_lock<std::mutex> lock(m);
+    done.wait(lock, [&] { return busy == 0; });
+    job = nullptr;
+}
+
+} // namespace gem5
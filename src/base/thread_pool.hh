@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_THREAD_POOL_HH__
+#define __BASE_THREAD_POOL_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * A fixed set of host worker threads for data parallel host-side work
+ * such as compressing checkpoints. This is unrelated to the simulated
+ * system and must not be used to touch simulation state that is owned
+ * by an event queue.
+ *
+ * Work is submitted as a loop with parallelFor(), which hands out loop
+ * indices to the workers and to the calling thread, and returns once
+ * every index has been processed.
+ */
+class ThreadPool
+{
+  public:
+    using Job = std::function<void(size_t)>;
+
+  private:
+    std::vector<std::thread> workers;
+
+    std::mutex m;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    /** The loop being executed, valid while busy is non-zero. */
+    const Job *job = nullptr;
+    size_t jobCount = 0;
+    std::atomic<size_t> next{0};
+
+    /** Number of workers that have not finished the current loop. */
+    size_t busy = 0;
+    /** Incremented for every loop so workers can detect new work. */
+    uint64_t generation = 0;
+    bool stopping = false;
+
+    /** Process loop indices until there are none left. */
+    void drainJob();
+
+    void workerMain();
+
+  public:
+    /**
+     * @param num_threads Total number of threads taking part in a loop,
+     *        including the calling thread. Zero uses one thread per host
+     *        core.
+     */
+    explicit ThreadPool(unsigned num_threads=0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /** Number of threads taking part in a loop. */
+    unsigned size() const { return workers.size() + 1; }
+
+    /**
+     * Call fn(i) for every i in [0, count) on the pool and the calling
+     * thread. Calls may happen in any order and concurrently.
+     */
+    void parallelFor(size_t count, const Job &fn);
+};
+
+} // namespace gem5
+
+#endif // __BASE_THREAD_POOL_HH__
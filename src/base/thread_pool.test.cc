@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include "base/thread_pool.hh"
+
+using namespace gem5;
+
+TEST(ThreadPoolTest, Size)
+{
+    ThreadPool single(1);
+    EXPECT_EQ(single.size(), 1u);
+
+    ThreadPool four(4);
+    EXPECT_EQ(four.size(), 4u);
+
+    ThreadPool host;
+    EXPECT_GE(host.size(), 1u);
+}
+
+TEST(ThreadPoolTest, EveryIndexOnce)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(hits.size(), [&hits](size_t i) { hits[i]++; });
+    for (const auto &h : hits)
+        EXPECT_EQ(h, 1);
+}
+
+TEST(ThreadPoolTest, RepeatedLoops)
+{
+    ThreadPool pool(3);
+    std::vector<uint64_t> values(257);
+    for (int round = 0; round < 100; round++) {
+        pool.parallelFor(values.size(),
+                         [&values](size_t i) { values[i] += i; });
+    }
+
+    uint64_t sum = std::accumulate(values.begin(), values.end(), 0ull);
+    EXPECT_EQ(sum, 100ull * 256 * 257 / 2);
+}
+
+TEST(ThreadPoolTest, EmptyAndSingle)
+{
+    ThreadPool pool(2);
+    int calls = 0;
+    pool.parallelFor(0, [&calls](size_t) { calls++; });
+    EXPECT_EQ(calls, 0);
+    pool.parallelFor(1, [&calls](size_t) { calls++; });
+    EXPECT_EQ(calls, 1);
+}
@@ -32,9 +32,12 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <type_traits>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -54,6 +57,119 @@ namespace gem5
 
 namespace trace {
 
+/**
+ * An argument of a debug message that is kept unformatted, together
+ * with its type, so that it can be formatted later on exactly like
+ * cprintf would have. Only fundamental types, strings and object
+ * pointers are supported, as the output of other types depends on
+ * their stream operators.
+ */
+struct RawArg
+{
+    /** The type of the argument, the integer ones by size. */
+    enum Type : uint8_t
+    {
+        None,
+        Bool,
+        Char,
+        SChar,
+        UChar,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Double,
+        String,
+        Pointer
+    };
+
+    template <typename T>
+    static constexpr bool isString =
+        std::is_same_v<T, std::string> ||
+        std::is_same_v<std::decay_t<T>, char *> ||
+        std::is_same_v<std::decay_t<T>, const char *>;
+
+    template <typename T>
+    static constexpr bool isInteger =
+        std::is_integral_v<T> && sizeof(T) <= 8 &&
+        !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> &&
+        !std::is_same_v<T, char32_t>;
+
+    template <typename T>
+    static constexpr bool isObjectPointer =
+        std::is_pointer_v<T> && !std::is_array_v<T> &&
+        !std::is_function_v<std::remove_pointer_t<T>> &&
+        !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char> &&
+        !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>,
+                        signed char> &&
+        !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>,
+                        unsigned char>;
+
+    /** True if arguments of type T can be kept unformatted. */
+    template <typename T>
+    static constexpr bool supported =
+        isInteger<T> || std::is_same_v<T, float> ||
+        std::is_same_v<T, double> || isString<T> || isObjectPointer<T>;
+
+    Type type = None;
+    /** The bits of integer and floating point values, and pointers. */
+    uint64_t bits = 0;
+    /** The characters of strings, which are not terminated. */
+    const char *str = nullptr;
+    size_t len = 0;
+
+    RawArg() = default;
+
+    template <typename T>
+    RawArg(const T &v)
+    {
+        static_assert(supported<T>, "Unsupported raw argument type");
+
+        if constexpr (std::is_same_v<T, std::string>) {
+            type = String;
+            str = v.data();
+            len = v.size();
+        } else if constexpr (isString<T>) {
+            type = String;
+            if constexpr (std::is_array_v<T>)
+                str = v;
+            else
+                str = v ? v : "";
+            len = std::strlen(str);
+        } else if constexpr (isObjectPointer<T>) {
+            type = Pointer;
+            bits = reinterpret_cast<uintptr_t>(v);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            type = Double;
+            const double d = v;
+            std::memcpy(&bits, &d, sizeof(d));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            type = Bool;
+            bits = v;
+        } else if constexpr (std::is_same_v<T, char>) {
+            type = Char;
+            bits = (uint8_t)v;
+        } else if constexpr (std::is_same_v<T, signed char>) {
+            type = SChar;
+            bits = (uint8_t)v;
+        } else if constexpr (std::is_same_v<T, unsigned char>) {
+            type = UChar;
+            bits = v;
+        } else {
+            constexpr bool is_signed = std::is_signed_v<T>;
+            if constexpr (sizeof(T) == 2)
+                type = is_signed ? Int16 : UInt16;
+            else if constexpr (sizeof(T) == 4)
+                type = is_signed ? Int32 : UInt32;
+            else
+                type = is_signed ? Int64 : UInt64;
+            bits = (uint64_t)(int64_t)v;
+        }
+    }
+};
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -64,6 +180,22 @@ class Logger
     /** Name match for objects to activate log */
     ObjectMatch activate;
 
+    /**
+     * Set by loggers that record messages through logRaw instead of
+     * formatting them with their arguments.
+     */
+    bool raw = false;
+
+    /**
+     * Record a message without formatting it. This is only called if
+     * raw is set and all arguments are supported by RawArg.
+     */
+    virtual void
+    logRaw(Tick when, const std::string &name, const std::string &flag,
+           const char *fmt, const RawArg *args, size_t num_args)
+    {
+    }
+
     bool isEnabled(const std::string &name) const
     {
         if (name.empty()) // Enable the logger with a empty name.
@@ -96,6 +228,14 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if constexpr ((RawArg::supported<Args> && ...)) {
+            if (raw) {
+                // the extra argument avoids an empty array
+                const RawArg raw_args[] = { RawArg(args)..., RawArg() };
+                logRaw(when, name, flag, fmt, raw_args, sizeof...(Args));
+                return;
+            }
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -35,6 +35,25 @@ class ExeTracer(InstTracer):
     cxx_header = "cpu/exetrace.hh"
 
 
+class BinaryExeTracer(InstTracer):
+    type = "BinaryExeTracer"
+    cxx_class = "gem5::trace::BinaryExeTracer"
+    cxx_header = "cpu/binary_exetrace.hh"
+    file_name = Param.String(
+        "", "Commit trace output file, <name>.ctrace if empty"
+    )
+    op_class = Param.Bool(True, "Record the op class of instructions")
+    machine_code = Param.Bool(
+        False, "Record the machine code of instructions"
+    )
+    redecode = Param.Bool(
+        True, "Record the op class of instructions the CPU redecoded"
+    )
+    buffer_size = Param.MemorySize(
+        "4MiB", "Size of the buffer between the CPU and the writer thread"
+    )
+
+
 class IntelTrace(InstTracer):
     type = "IntelTrace"
     cxx_class = "gem5::trace::IntelTrace"
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/binary_exetrace.hh"
+
+#include <sstream>
+
+#include "base/loader/symtab.hh"
+#include "base/output.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "debug/ExecEnable.hh"
+#include "enums/OpClass.hh"
+#include "sim/core.hh"
+#include "sim/full_system.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+void
+BinaryExeTracerRecord::dump()
+{
+    using Tracer = BinaryExeTracer;
+
+    std::lock_guard<UncontendedMutex> guard(tracer.lock);
+
+    tracer.setContext(thread);
+    const uint64_t id = tracer.entryId(staticInst, *pc, macroStaticInst);
+
+    uint8_t bits = 0;
+    if (!predicate)
+        bits |= Tracer::PredicatedFalse;
+    if (thread->getIsaPtr()->inUserMode())
+        bits |= Tracer::UserMode;
+    if (faulting)
+        bits |= Tracer::Faulting;
+    if (mem_valid)
+        bits |= Tracer::MemValid;
+    if (fetch_seq_valid)
+        bits |= Tracer::FetchSeqValid;
+    if (cp_seq_valid)
+        bits |= Tracer::CPSeqValid;
+    if (dataStatus == DataReg)
+        bits |= Tracer::RegData;
+    else if (dataStatus != DataInvalid)
+        bits |= Tracer::IntData;
+
+    if (redecoded && tracer.recordRedecode) {
+        tracer.put<uint8_t>(Tracer::RedecodeRecord);
+        tracer.put<uint8_t>(redecoded_op_class);
+    }
+
+    tracer.put<uint8_t>(Tracer::CommitRecord);
+    tracer.put<uint8_t>(bits);
+    tracer.putVarint(id);
+    tracer.putDelta(when, tracer.lastTick);
+
+    if (dataStatus == DataReg)
+        tracer.putString(data.asReg.asString());
+    else if (dataStatus != DataInvalid)
+        tracer.putVarint(data.asInt);
+
+    if (mem_valid) {
+        tracer.putDelta(addr, tracer.lastAddr);
+        tracer.putVarint(size);
+    }
+    if (fetch_seq_valid)
+        tracer.putDelta(fetch_seq, tracer.lastFetchSeq);
+    if (cp_seq_valid)
+        tracer.putDelta(cp_seq, tracer.lastCPSeq);
+
+    tracer.commit();
+}
+
+BinaryExeTracer::BinaryExeTracer(const Params &p)
+    : InstTracer(p), recordOpClass(p.op_class),
+      recordMachineCode(p.machine_code), recordRedecode(p.redecode)
+{
+    const std::string file_name =
+        p.file_name.empty() ? name() + ".ctrace" : p.file_name;
+    traceStream = simout.create(file_name, true);
+    writer.reset(new AsyncWriter(*traceStream->stream(), p.buffer_size));
+
+    const uint8_t options = (recordOpClass ? OpClassField : 0) |
+                            (recordMachineCode ? MachineCodeField : 0) |
+                            (recordRedecode ? RedecodeField : 0) |
+                            (FullSystem ? FullSystemMode : 0);
+    record.insert(record.end(), magic, magic + sizeof(magic));
+    put<uint32_t>(version);
+    put<uint8_t>(options);
+    put<uint64_t>(sim_clock::Frequency);
+    if (recordOpClass || recordRedecode) {
+        putVarint(enums::Num_OpClass);
+        for (int i = 0; i < enums::Num_OpClass; ++i)
+            putString(enums::OpClassStrings[i]);
+    }
+    commit();
+
+    // get a callback when we exit so we can close the file
+    registerExitCallback([this]() { closeStreams(); });
+}
+
+BinaryExeTracer::~BinaryExeTracer()
+{
+    closeStreams();
+}
+
+void
+BinaryExeTracer::closeStreams()
+{
+    if (!writer)
+        return;
+
+    writer.reset();
+    simout.close(traceStream);
+    traceStream = nullptr;
+}
+
+InstRecord *
+BinaryExeTracer::getInstRecord(Tick when, ThreadContext *tc,
+        const StaticInstPtr staticInst, const PCStateBase &pc,
+        const StaticInstPtr macroStaticInst)
+{
+    // Only record the trace if Exec debugging is enabled
+    if (!debug::ExecEnable)
+        return nullptr;
+
+    return new BinaryExeTracerRecord(*this, when, tc,
+            staticInst, pc, macroStaticInst);
+}
+
+void
+BinaryExeTracer::commit()
+{
+    panic_if(!writer, "Instruction traced after the trace was closed.");
+    writer->push(record.data(), record.size());
+    record.clear();
+}
+
+void
+BinaryExeTracer::setContext(ThreadContext *tc)
+{
+    const uint64_t asid = tc->getIsaPtr()->getExecutingAsid();
+    if (tc == lastThread && asid == lastAsid)
+        return;
+
+    lastThread = tc;
+    lastAsid = asid;
+
+    const std::string &cpu_name = tc->getCpuPtr()->name();
+    auto it = names.find(cpu_name);
+    if (it == names.end()) {
+        it = names.emplace(cpu_name, names.size()).first;
+        put<uint8_t>(NameRecord);
+        putVarint(it->second);
+        putString(cpu_name);
+        commit();
+    }
+
+    put<uint8_t>(ContextRecord);
+    putVarint(it->second);
+    putVarint(tc->threadId());
+    putVarint(asid);
+    commit();
+}
+
+uint64_t
+BinaryExeTracer::entryId(const StaticInstPtr &inst, const PCStateBase &pc,
+                         const StaticInstPtr &macro_inst)
+{
+    const bool microop = inst->isMicroop();
+    const Addr inst_addr = pc.instAddr();
+    const MicroPC upc = microop ? pc.microPC() : 0;
+
+    EntryKey key{inst, inst_addr, upc};
+    auto it = entries.find(key);
+    if (it != entries.end())
+        return it->second;
+
+    const bool has_macro = microop && macro_inst;
+    const uint64_t macro_id =
+        has_macro ? entryId(macro_inst, pc, nullptr) : 0;
+
+    const uint64_t id = entries.size();
+    entries.emplace(std::move(key), id);
+
+    uint8_t bits = 0;
+    if (microop)
+        bits |= Microop;
+    if (inst->isFirstMicroop())
+        bits |= FirstMicroop;
+    if (inst->isLastMicroop())
+        bits |= LastMicroop;
+    if (has_macro)
+        bits |= HasMacroop;
+
+    put<uint8_t>(EntryRecord);
+    putVarint(id);
+    putVarint(inst_addr);
+    putVarint(upc);
+    put<uint8_t>(bits);
+    if (has_macro)
+        putVarint(macro_id);
+    if (recordOpClass)
+        put<uint8_t>(inst->opClass());
+    if (recordMachineCode) {
+        size_t size = inst->asBytes(codeBuf.data(), codeBuf.size());
+        if (size > codeBuf.size()) {
+            codeBuf.resize(size);
+            size = inst->asBytes(codeBuf.data(), codeBuf.size());
+        }
+        putVarint(size);
+        record.insert(record.end(), codeBuf.begin(), codeBuf.begin() + size);
+    }
+
+    putString(disassemble(inst, pc, &loader::debugSymbolTable));
+
+    auto sym = loader::debugSymbolTable.findNearest(inst_addr);
+    if (sym != loader::debugSymbolTable.end()) {
+        putString(sym->name());
+        putVarint(inst_addr - sym->address());
+    } else {
+        putString("");
+    }
+
+    std::ostringstream flags;
+    inst->printFlags(flags, "|");
+    putString(flags.str());
+
+    commit();
+
+    return id;
+}
+
+} // namespace trace
+} // namespace gem5
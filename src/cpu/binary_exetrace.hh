@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_BINARY_EXETRACE_HH__
+#define __CPU_BINARY_EXETRACE_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/async_writer.hh"
+#include "base/types.hh"
+#include "base/uncontended_mutex.hh"
+#include "cpu/static_inst.hh"
+#include "params/BinaryExeTracer.hh"
+#include "sim/insttracer.hh"
+
+namespace gem5
+{
+
+class OutputStream;
+class ThreadContext;
+
+namespace trace {
+
+class BinaryExeTracer;
+
+class BinaryExeTracerRecord : public InstRecord
+{
+  public:
+    BinaryExeTracerRecord(BinaryExeTracer &_tracer, Tick _when,
+            ThreadContext *_thread, const StaticInstPtr _staticInst,
+            const PCStateBase &_pc,
+            const StaticInstPtr _macroStaticInst=nullptr)
+        : InstRecord(_when, _thread, _staticInst, _pc, _macroStaticInst),
+          tracer(_tracer)
+    {}
+
+    /** Encode the committed instruction and pass it to the tracer. */
+    void dump() override;
+
+  protected:
+    BinaryExeTracer &tracer;
+};
+
+/**
+ * A commit trace with the contents of the ExeTracer output in a
+ * compact binary form. Everything that only depends on the static
+ * instruction and its PC (disassembly, symbol, op class, flags) is
+ * recorded once in a dictionary entry, and each committed instruction
+ * only refers to its entry and records what changes between
+ * instructions, with ticks, addresses and sequence numbers encoded as
+ * deltas from the previous instruction. Records are written by a
+ * background thread.
+ *
+ * Micro-ops are always recorded, together with a reference to their
+ * macro-op, so that util/decode_commit_trace.py can reproduce the
+ * ExeTracer output for any combination of the Exec debug flags.
+ *
+ * The file starts with the magic string "gem5ctrc", a u32 version,
+ * a u8 with the Option bits, the u64 tick frequency and, with the
+ * OpClassField or RedecodeField option, the names of the op classes
+ * as a varint count followed by strings. Then come records, each
+ * starting with a u8 RecordType:
+ *   - Name: varint ID, string. Defines the ID of a CPU name.
+ *   - Context: varint name ID, varint thread ID, varint ASID. Sets
+ *     the context of the instructions that follow.
+ *   - Entry: varint ID, varint PC, varint micro PC, u8 EntryBits,
+ *     the varint ID of the macro-op entry with HasMacroop, u8 op class
+ *     with OpClassField, machine code as a string with
+ *     MachineCodeField, then the disassembly, the nearest symbol
+ *     and, if the symbol isn't empty, the varint offset from it, and
+ *     the instruction flags joined by "|".
+ *   - Commit: u8 CommitBits, varint entry ID, signed tick delta, the
+ *     data as a varint with IntData or a string with RegData, signed
+ *     address delta and varint size with MemValid, signed fetch
+ *     sequence delta with FetchSeqValid and signed commit sequence
+ *     delta with CPSeqValid.
+ *   - Redecode: u8 op class, only with the RedecodeField option.
+ *     The CPU redecoded the instruction of the next Commit record to
+ *     execute as this op class instead of the one of its entry.
+ * Varints are LEB128 encoded, signed values zigzag encoded first,
+ * and strings are a varint length followed by their characters.
+ */
+class BinaryExeTracer : public InstTracer
+{
+  public:
+    /** The record types. */
+    enum RecordType : uint8_t
+    {
+        NameRecord = 1,
+        ContextRecord = 2,
+        EntryRecord = 3,
+        CommitRecord = 4,
+        RedecodeRecord = 5
+    };
+
+    /** Bits of the options byte in the file header. */
+    enum Option : uint8_t
+    {
+        OpClassField = 0x1,
+        MachineCodeField = 0x2,
+        FullSystemMode = 0x4,
+        RedecodeField = 0x8
+    };
+
+    /** Bits of the flags byte of an entry. */
+    enum EntryBits : uint8_t
+    {
+        Microop = 0x1,
+        FirstMicroop = 0x2,
+        LastMicroop = 0x4,
+        HasMacroop = 0x8
+    };
+
+    /** Bits of the flags byte of a committed instruction. */
+    enum CommitBits : uint8_t
+    {
+        PredicatedFalse = 0x1,
+        UserMode = 0x2,
+        Faulting = 0x4,
+        MemValid = 0x8,
+        FetchSeqValid = 0x10,
+        CPSeqValid = 0x20,
+        IntData = 0x40,
+        RegData = 0x80
+    };
+
+    static constexpr char magic[8] = {
+        'g', 'e', 'm', '5', 'c', 't', 'r', 'c' };
+    static constexpr uint32_t version = 2;
+
+    PARAMS(BinaryExeTracer);
+    BinaryExeTracer(const Params &params);
+    ~BinaryExeTracer();
+
+    InstRecord *getInstRecord(Tick when, ThreadContext *tc,
+            const StaticInstPtr staticInst, const PCStateBase &pc,
+            const StaticInstPtr macroStaticInst=nullptr) override;
+
+  protected:
+    /** Wait for the writer and close the trace file. */
+    void closeStreams();
+
+    /** The key of a dictionary entry. */
+    struct EntryKey
+    {
+        /** Keeps the instruction alive so its address isn't reused. */
+        StaticInstPtr inst;
+        Addr pc;
+        MicroPC upc;
+
+        bool
+        operator==(const EntryKey &other) const
+        {
+            return inst == other.inst && pc == other.pc &&
+                upc == other.upc;
+        }
+    };
+
+    struct EntryKeyHash
+    {
+        size_t
+        operator()(const EntryKey &key) const
+        {
+            return std::hash<const StaticInst *>()(key.inst.get()) ^
+                (key.pc * 0x9e3779b97f4a7c15ULL) ^ key.upc;
+        }
+    };
+
+    /**
+     * @return The ID of the entry of an instruction, defining it if
+     * it's new. Defining the entry of a micro-op also defines the
+     * entry of its macro-op.
+     */
+    uint64_t entryId(const StaticInstPtr &inst, const PCStateBase &pc,
+                     const StaticInstPtr &macro_inst);
+
+    /** Define the context of a thread if it isn't the current one. */
+    void setContext(ThreadContext *tc);
+
+    /** Append a value to the record being built. */
+    template <typename T>
+    void
+    put(const T &val)
+    {
+        const char *p = reinterpret_cast<const char *>(&val);
+        record.insert(record.end(), p, p + sizeof(T));
+    }
+
+    /** Append an unsigned LEB128 value to the record being built. */
+    void
+    putVarint(uint64_t val)
+    {
+        while (val >= 0x80) {
+            record.push_back(char(val | 0x80));
+            val >>= 7;
+        }
+        record.push_back(char(val));
+    }
+
+    /** Append a zigzag encoded difference to the record being built. */
+    void
+    putDelta(uint64_t val, uint64_t &last)
+    {
+        const int64_t delta = val - last;
+        last = val;
+        putVarint((uint64_t(delta) << 1) ^ uint64_t(delta >> 63));
+    }
+
+    /** Append a string to the record being built. */
+    void
+    putString(const std::string &str)
+    {
+        putVarint(str.size());
+        record.insert(record.end(), str.begin(), str.end());
+    }
+
+    /** Pass the record being built to the writer, and clear it. */
+    void commit();
+
+    const bool recordOpClass;
+    const bool recordMachineCode;
+    const bool recordRedecode;
+
+    OutputStream *traceStream;
+    std::unique_ptr<AsyncWriter> writer;
+
+    /** Serializes the threads sharing this tracer. */
+    UncontendedMutex lock;
+
+    /** The record being built. */
+    std::vector<char> record;
+
+    std::unordered_map<EntryKey, uint64_t, EntryKeyHash> entries;
+    std::unordered_map<std::string, uint64_t> names;
+
+    /** Scratch buffer for the machine code of instructions. */
+    std::vector<uint8_t> codeBuf;
+
+    /** The context of the last committed instruction. */
+    ThreadContext *lastThread = nullptr;
+    uint64_t lastAsid = 0;
+
+    /** The bases of the delta encoded fields. */
+    uint64_t lastTick = 0;
+    uint64_t lastAddr = 0;
+    uint64_t lastFetchSeq = 0;
+    uint64_t lastCPSeq = 0;
+
+    friend class BinaryExeTracerRecord;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_BINARY_EXETRACE_HH__
@@ -1225,6 +1225,10 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
                 && dynamic_cast<ReExec*>(inst_fault.get()) == nullptr) {
 
                 head_inst->traceData->setFaulting(true);
+                if (head_inst->isRedecoded()) {
+                    head_inst->traceData->setRedecoded(
+                        affinityTable.getAffinity(head_inst->opClass()));
+                }
                 head_inst->traceData->setFetchSeq(head_inst->seqNum);
                 head_inst->traceData->setCPSeq(thread[tid]->numOp);
                 head_inst->traceData->dump();
@@ -1244,6 +1248,10 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
             "[tid:%i] [sn:%llu] Committing instruction with PC %s\n",
             tid, head_inst->seqNum, head_inst->pcState());
     if (head_inst->traceData) {
+        if (head_inst->isRedecoded()) {
+            head_inst->traceData->setRedecoded(
+                affinityTable.getAffinity(head_inst->opClass()));
+        }
         head_inst->traceData->setFetchSeq(head_inst->seqNum);
         head_inst->traceData->setCPSeq(thread[tid]->numOp);
         head_inst->traceData->dump();
@@ -715,8 +715,8 @@ LSQUnit::executeStore(const DynInstPtr &store_inst)
 
 }
 
-void
-LSQUnit::commitLoad()
+bool
+LSQUnit::commitLoad(Counter &load_to_use)
 {
     assert(loadQueue.front().valid());
 
@@ -725,17 +725,20 @@ LSQUnit::commitLoad()
     DPRINTF(LSQUnit, "Committing head load instruction, PC %s\n",
             inst->pcState());
 
-    // Update histogram with memory latency from load
+    // Report the memory latency from load for the histogram
     // Only take latency from load demand that where issued and did not fault
-    if (!inst->isInstPrefetch() && !inst->isDataPrefetch()
+    bool sampled = !inst->isInstPrefetch() && !inst->isDataPrefetch()
             && inst->firstIssue != -1
-            && inst->lastWakeDependents != -1) {
-        stats.loadToUse.sample(cpu->ticksToCycles(
-                    inst->lastWakeDependents - inst->firstIssue));
+            && inst->lastWakeDependents != -1;
+    if (sampled) {
+        load_to_use = cpu->ticksToCycles(
+                inst->lastWakeDependents - inst->firstIssue);
     }
 
     loadQueue.front().clear();
     loadQueue.pop_front();
+
+    return sampled;
 }
 
 void
@@ -743,10 +746,22 @@ LSQUnit::commitLoads(InstSeqNum &youngest_inst)
 {
     assert(loadQueue.size() == 0 || loadQueue.front().valid());
 
+    // Several loads usually retire together, so gather their latencies
+    // and hand them to the histogram in one batch
+    std::array<Counter, statistics::sampleBufferSize> load_to_use;
+    statistics::size_type num_samples = 0;
+
     while (loadQueue.size() != 0 && loadQueue.front().instruction()->seqNum
             <= youngest_inst) {
-        commitLoad();
+        if (commitLoad(load_to_use[num_samples]) &&
+                ++num_samples == load_to_use.size()) {
+            stats.loadToUse.sampleN(load_to_use.data(), num_samples);
+            num_samples = 0;
+        }
     }
+
+    if (num_samples)
+        stats.loadToUse.sampleN(load_to_use.data(), num_samples);
 }
 
 void
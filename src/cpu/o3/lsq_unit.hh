@@ -43,6 +43,7 @@
 #define __CPU_O3_LSQ_UNIT_HH__
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -266,8 +267,14 @@ class LSQUnit
     /** Executes a store instruction. */
     Fault executeStore(const DynInstPtr &inst);
 
-    /** Commits the head load. */
-    void commitLoad();
+    /**
+     * Commits the head load.
+     *
+     * @param load_to_use Set to the load-to-use latency in cycles if
+     *                    the load produced a loadToUse sample.
+     * @return Whether load_to_use holds a sample.
+     */
+    bool commitLoad(Counter &load_to_use);
     /** Commits loads older than a specific sequence number. */
     void commitLoads(InstSeqNum &youngest_inst);
 
@@ -165,8 +165,8 @@ ElasticTrace::fetchReqTrace(const RequestPtr &req)
     inst_fetch_pkt.set_flags(req->getFlags());
     inst_fetch_pkt.set_addr(req->getPaddr());
     inst_fetch_pkt.set_size(req->getSize());
-    // Write the message to the stream.
-    instTraceStream->write(inst_fetch_pkt);
+    // Write the message to the stream, indexed by tick
+    instTraceStream->write(inst_fetch_pkt, inst_fetch_pkt.tick());
 }
 
 void
@@ -866,8 +866,9 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 dep_pkt.set_weight(num_filtered_nodes);
                 num_filtered_nodes = 0;
             }
-            // Write the message to the protobuf output stream
-            dataTraceStream->write(dep_pkt);
+            // Write the message to the protobuf output stream, indexed
+            // by sequence number as the records have no tick
+            dataTraceStream->write(dep_pkt, dep_pkt.seq_num());
         } else {
             // Don't write the node to the trace but note that we have filtered
             // out a node.
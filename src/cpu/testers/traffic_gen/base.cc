@@ -544,11 +544,13 @@ BaseTrafficGen::createStrided(Tick duration,
 
 std::shared_ptr<BaseGen>
 BaseTrafficGen::createTrace(Tick duration,
-                            const std::string& trace_file, Addr addr_offset)
+                            const std::string& trace_file, Addr addr_offset,
+                            Tick start_tick)
 {
 #if HAVE_PROTOBUF
     return std::shared_ptr<BaseGen>(
-        new TraceGen(*this, requestorId, duration, trace_file, addr_offset));
+        new TraceGen(*this, requestorId, duration, trace_file, addr_offset,
+                     start_tick));
 #else
     panic("Can't instantiate trace generation without Protobuf support!\n");
 #endif
@@ -327,7 +327,8 @@ class BaseTrafficGen : public ClockedObject
 
     std::shared_ptr<BaseGen> createTrace(
         Tick duration,
-        const std::string& trace_file, Addr addr_offset);
+        const std::string& trace_file, Addr addr_offset,
+        Tick start_tick=0);
 
   protected:
     void start();
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/traffic_gen/fixed_packet_trace.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Magic number at the start of a fixed-width packet trace */
+constexpr char magic[8] = {'g', 'e', 'm', '5', 'f', 'p', 'k', 't'};
+
+/** Header as laid out in the file */
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t tickFreq;
+    uint64_t numRecords;
+};
+
+static_assert(sizeof(Header) == 32, "Unexpected packet header layout");
+
+} // anonymous namespace
+
+bool
+FixedPacketTrace::isFixedPacketTrace(const std::string &filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    char buf[sizeof(magic)];
+    bool match = ::read(fd, buf, sizeof(buf)) == sizeof(buf) &&
+        std::memcmp(buf, magic, sizeof(magic)) == 0;
+    close(fd);
+    return match;
+}
+
+FixedPacketTrace::FixedPacketTrace(const std::string &_filename,
+                                   size_t batch_size)
+    : filename(_filename), data(nullptr), length(0), records(nullptr),
+      numRecords(0), tickFreq(0), batchSize(std::max<size_t>(batch_size, 1)),
+      pos(0), prefetched(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Failed to open packet trace %s.\n", filename);
+
+    off_t off = lseek(fd, 0, SEEK_END);
+    fatal_if(off < (off_t)sizeof(Header),
+             "Packet trace %s is too short for its header.\n", filename);
+    length = static_cast<size_t>(off);
+
+    data = (uint8_t *)mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    panic_if(data == MAP_FAILED, "Failed to mmap packet trace %s.\n",
+             filename);
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    fatal_if(std::memcmp(header.magic, magic, sizeof(magic)) != 0,
+             "%s is not a fixed-width packet trace.\n", filename);
+    fatal_if(letoh(header.version) != version,
+             "Packet trace %s has version %d, expected %d.\n", filename,
+             letoh(header.version), version);
+    fatal_if(letoh(header.recordSize) != sizeof(Record),
+             "Packet trace %s has %d byte records, expected %d.\n",
+             filename, letoh(header.recordSize), sizeof(Record));
+
+    tickFreq = letoh(header.tickFreq);
+    numRecords = letoh(header.numRecords);
+    fatal_if(numRecords > (length - sizeof(Header)) / sizeof(Record),
+             "Packet trace %s is truncated, expected %d records.\n",
+             filename, numRecords);
+    records = reinterpret_cast<const Record *>(data + sizeof(Header));
+
+    // Records are mostly read front to back, so let the kernel read
+    // ahead aggressively and drop pages behind.
+    madvise(data, length, MADV_SEQUENTIAL);
+    prefetch(0);
+}
+
+FixedPacketTrace::~FixedPacketTrace()
+{
+    munmap(data, length);
+}
+
+void
+FixedPacketTrace::prefetch(size_t first)
+{
+    if (first >= numRecords)
+        return;
+
+    size_t last = std::min(first + batchSize, numRecords);
+
+    // madvise needs a page aligned start address
+    static const uintptr_t page_mask = sysconf(_SC_PAGESIZE) - 1;
+    uintptr_t start = (uintptr_t)&records[first] & ~page_mask;
+    uintptr_t end = (uintptr_t)&records[last];
+    madvise((void *)start, end - start, MADV_WILLNEED);
+    prefetched = last;
+}
+
+bool
+FixedPacketTrace::read(Record &record)
+{
+    if (pos == numRecords)
+        return false;
+
+    // Once the reader gets half way through the prefetched batch,
+    // request the next one so it is resident by the time it is needed.
+    if (prefetched < numRecords && pos + batchSize / 2 >= prefetched)
+        prefetch(prefetched);
+
+    const Record &r = records[pos++];
+    record.tick = letoh(r.tick);
+    record.addr = letoh(r.addr);
+    record.size = letoh(r.size);
+    record.flags = letoh(r.flags);
+    record.cmd = letoh(r.cmd);
+    record.reserved = 0;
+    return true;
+}
+
+void
+FixedPacketTrace::seek(Tick tick)
+{
+    const Record *it = std::partition_point(records, records + numRecords,
+        [tick](const Record &r) { return letoh(r.tick) < tick; });
+    pos = it - records;
+    prefetch(pos);
+}
+
+void
+FixedPacketTrace::reset()
+{
+    pos = 0;
+    prefetch(0);
+}
+
+} // namespace gem5
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a reader for fixed-width binary packet traces.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_FIXED_PACKET_TRACE_HH__
+#define __CPU_TRAFFIC_GEN_FIXED_PACKET_TRACE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A fixed-width packet trace is an alternative to the protobuf packet
+ * trace for replaying large memory traces. The file starts with a
+ * header followed by records of a fixed size, all little endian:
+ *
+ * - header: magic "gem5fpkt", uint32 version, uint32 record size,
+ *   uint64 tick frequency, uint64 number of records
+ * - record: uint64 tick, uint64 address, uint32 size, uint32 request
+ *   flags, uint32 command, uint32 reserved
+ *
+ * The file is memory mapped and records are read in place, so reading
+ * does not parse or copy anything. The pages for the next batch of
+ * records are requested from the kernel ahead of use. As records are
+ * sorted by tick, seeking is a binary search.
+ *
+ * Such traces are created from protobuf packet traces with
+ * util/convert_packet_trace.py.
+ */
+class FixedPacketTrace
+{
+  public:
+    /** A record as laid out in the file. */
+    struct Record
+    {
+        uint64_t tick;
+        uint64_t addr;
+        uint32_t size;
+        uint32_t flags;
+        uint32_t cmd;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(Record) == 32, "Unexpected packet record layout");
+
+    /** Version of the format written in the header */
+    static constexpr uint32_t version = 1;
+
+    /**
+     * Check if a file is a fixed-width packet trace.
+     *
+     * @param filename Path to the file
+     * @return True if the file starts with the magic number
+     */
+    static bool isFixedPacketTrace(const std::string &filename);
+
+    /**
+     * Map a trace file, checking its header.
+     *
+     * @param filename Path to the file to read from
+     * @param batch_size Number of records requested from the kernel
+     *                   ahead of use
+     */
+    FixedPacketTrace(const std::string &filename,
+                     size_t batch_size = 64 * 1024);
+
+    ~FixedPacketTrace();
+
+    FixedPacketTrace(const FixedPacketTrace &) = delete;
+    FixedPacketTrace &operator=(const FixedPacketTrace &) = delete;
+
+    /** Tick frequency the trace was recorded with */
+    uint64_t tickFrequency() const { return tickFreq; }
+
+    /** Number of records in the trace */
+    size_t size() const { return numRecords; }
+
+    /**
+     * Get the next record and advance past it.
+     *
+     * @param record Record to populate, in host byte order
+     * @return True if there was a record left to read
+     */
+    bool read(Record &record);
+
+    /**
+     * Move to the first record at or after a tick.
+     *
+     * @param tick Tick to seek to
+     */
+    void seek(Tick tick);
+
+    /** Move back to the first record. */
+    void reset();
+
+  private:
+    /** Request the pages of the batch starting at a record. */
+    void prefetch(size_t first);
+
+    /** Path of the trace, for error messages */
+    const std::string filename;
+
+    /** Start of the mapping */
+    uint8_t *data;
+
+    /** Length of the mapping in bytes */
+    size_t length;
+
+    /** Records in the mapping, following the header */
+    const Record *records;
+
+    /** Number of records in the trace */
+    size_t numRecords;
+
+    /** Tick frequency the trace was recorded with */
+    uint64_t tickFreq;
+
+    /** Number of records prefetched at a time */
+    const size_t batchSize;
+
+    /** Index of the next record to read */
+    size_t pos;
+
+    /** Index of the first record that is not prefetched yet */
+    size_t prefetched;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TRAFFIC_GEN_FIXED_PACKET_TRACE_HH__
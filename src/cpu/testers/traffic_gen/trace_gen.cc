@@ -50,17 +50,27 @@ namespace gem5
 {
 
 TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
 {
+    if (FixedPacketTrace::isFixedPacketTrace(filename))
+        fixedTrace = std::make_unique<FixedPacketTrace>(filename);
+    else
+        trace = std::make_unique<ProtoInputStream>(filename);
     init();
 }
 
 void
 TraceGen::InputStream::init()
 {
+    if (fixedTrace) {
+        panic_if(fixedTrace->tickFrequency() != sim_clock::Frequency,
+                 "Trace was recorded with a different tick frequency %d\n",
+                 fixedTrace->tickFrequency());
+        return;
+    }
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!trace->read(header_msg)) {
         panic("Failed to read packet header from trace\n");
     } else if (header_msg.tick_freq() != sim_clock::Frequency) {
         panic("Trace was recorded with a different tick frequency %d\n",
@@ -71,15 +81,40 @@ TraceGen::InputStream::init()
 void
 TraceGen::InputStream::reset()
 {
-    trace.reset();
+    if (fixedTrace)
+        fixedTrace->reset();
+    else
+        trace->reset();
     init();
 }
 
+void
+TraceGen::InputStream::seek(Tick tick)
+{
+    if (fixedTrace)
+        fixedTrace->seek(tick);
+    else
+        trace->seek(tick);
+}
+
 bool
 TraceGen::InputStream::read(TraceElement& element)
 {
+    if (fixedTrace) {
+        FixedPacketTrace::Record record;
+        if (!fixedTrace->read(record))
+            return false;
+
+        element.cmd = record.cmd;
+        element.addr = record.addr;
+        element.blocksize = record.size;
+        element.tick = record.tick;
+        element.flags = record.flags;
+        return true;
+    }
+
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (trace->read(pkt_msg)) {
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
@@ -118,14 +153,22 @@ TraceGen::nextPacketTick(bool elastic, Tick delay) const
 void
 TraceGen::enter()
 {
-    // update the trace offset to the time where the state was entered.
-    tickOffset = curTick();
+    // update the trace offset to the time where the state was entered,
+    // less the start tick as the trace is played back from there
+    tickOffset = curTick() - startTick;
 
     // clear everything
     currElement.clear();
 
-    // read the first element in the file and set the complete flag
-    traceComplete = !trace.read(nextElement);
+    // with a start tick, use the chunk index of the trace to skip
+    // most of the elements before it
+    if (startTick)
+        trace.seek(startTick);
+
+    // read the first element to play back and set the complete flag
+    do {
+        traceComplete = !trace.read(nextElement);
+    } while (!traceComplete && nextElement.tick < startTick);
 }
 
 PacketPtr
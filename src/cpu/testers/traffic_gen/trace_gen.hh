@@ -44,9 +44,12 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <memory>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
+#include "cpu/testers/traffic_gen/fixed_packet_trace.hh"
 #include "mem/packet.hh"
 #include "proto/protoio.hh"
 
@@ -104,15 +107,19 @@ class TraceGen : public BaseGen
     /**
      * The InputStream encapsulates a trace file and the
      * internal buffers and populates TraceElements based on
-     * the input.
+     * the input. The trace is either a protobuf packet trace or a
+     * fixed-width packet trace, which is memory mapped instead.
      */
     class InputStream
     {
 
       private:
 
-        /// Input file stream for the protobuf trace
-        ProtoInputStream trace;
+        /// Input file stream for a protobuf trace
+        std::unique_ptr<ProtoInputStream> trace;
+
+        /// Mapped fixed-width trace, used instead of the protobuf trace
+        std::unique_ptr<FixedPacketTrace> fixedTrace;
 
       public:
 
@@ -135,6 +142,15 @@ class TraceGen : public BaseGen
          */
         void init();
 
+        /**
+         * Move close to the first element at or after a tick, if the
+         * trace has a chunk index. Otherwise the stream stays where
+         * it is.
+         *
+         * @param tick Tick to seek to
+         */
+        void seek(Tick tick);
+
         /**
          * Attempt to read a trace element from the stream,
          * and also notify the caller if the end of the file
@@ -156,13 +172,16 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param start_tick Tick in the trace to start playing back at
      */
     TraceGen(SimObject &obj, RequestorID requestor_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             Tick start_tick=0)
         : BaseGen(obj, requestor_id, _duration),
           trace(trace_file),
           tickOffset(0),
           addrOffset(addr_offset),
+          startTick(start_tick),
           traceComplete(false)
     {
     }
@@ -202,6 +221,12 @@ class TraceGen : public BaseGen
      */
     Addr addrOffset;
 
+    /**
+     * Tick in the trace the playback starts at. Elements before it
+     * are skipped, and the ones after it are played relative to it.
+     */
+    const Tick startTick;
+
     /**
      * Set to true when the trace replay for one instance of
      * state is complete.
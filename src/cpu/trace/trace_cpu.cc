@@ -37,6 +37,8 @@
 
 #include "cpu/trace/trace_cpu.hh"
 
+#include <algorithm>
+
 #include "base/compiler.hh"
 #include "sim/sim_exit.hh"
 #include "sim/system.hh"
@@ -45,7 +47,7 @@ namespace gem5
 {
 
 // Declare and initialize the static counter for number of trace CPUs.
-int TraceCPU::numTraceCPUs = 0;
+std::atomic<int> TraceCPU::numTraceCPUs(0);
 
 TraceCPU::TraceCPU(const TraceCPUParams &params)
     :   ClockedObject(params),
@@ -63,7 +65,9 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
         dcacheNextEvent([this]{ schedDcacheNext(); }, name()),
         oneTraceComplete(false),
         traceOffset(0),
-        execCompleteEvent(nullptr),
+        execCompleteEvent([this]{ countDownExit(); },
+                          name() + ".execComplete", false,
+                          Event::Sim_Exit_Pri),
         enableEarlyExit(params.enableEarlyExit),
         progressMsgInterval(params.progressMsgInterval),
         progressMsgThreshold(params.progressMsgInterval), traceStats(this)
@@ -126,16 +130,16 @@ TraceCPU::init()
     // events using a relative tick delta
     dcacheGen.adjustInitTraceOffset(traceOffset);
 
-    // If the Trace CPU simulation is configured to exit on any one trace
-    // completion then we don't need a counted event to count down all Trace
-    // CPUs in the system. If not then instantiate a counted event.
-    if (!enableEarlyExit) {
-        // The static counter for number of Trace CPUs is correctly set at
-        // this point so create an event and pass it.
-        execCompleteEvent = new CountedExitEvent("end of all traces reached.",
-                                                 numTraceCPUs);
-    }
+}
 
+void
+TraceCPU::countDownExit()
+{
+    // The counter is shared by Trace CPUs which may be simulated by
+    // different threads, so the decrement and the test must be one step.
+    if (--numTraceCPUs == 0) {
+        exitSimLoop("end of all traces reached.", 0);
+    }
 }
 
 void
@@ -194,7 +198,7 @@ TraceCPU::checkAndSchedExitEvent()
         if (enableEarlyExit) {
             exitSimLoop("End of trace reached");
         } else {
-            schedule(*execCompleteEvent, curTick());
+            schedule(execCompleteEvent, curTick());
         }
     }
 }
@@ -281,12 +285,39 @@ TraceCPU::ElasticDataGen::adjustInitTraceOffset(Tick& offset)
     }
 }
 
+TraceCPU::ElasticDataGen::~ElasticDataGen()
+{
+    depGraph.forEach([](GraphNode *node_ptr) { delete node_ptr; });
+    for (auto node_ptr : freeNodes)
+        delete node_ptr;
+}
+
 void
 TraceCPU::ElasticDataGen::exit()
 {
     trace.reset();
 }
 
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::allocNode()
+{
+    if (freeNodes.empty())
+        return new GraphNode;
+
+    GraphNode *node_ptr = freeNodes.back();
+    freeNodes.pop_back();
+    return node_ptr;
+}
+
+void
+TraceCPU::ElasticDataGen::freeNode(GraphNode *node_ptr)
+{
+    node_ptr->robDep.clear();
+    node_ptr->regDep.clear();
+    node_ptr->dependents.clear();
+    freeNodes.push_back(node_ptr);
+}
+
 bool
 TraceCPU::ElasticDataGen::readNextWindow()
 {
@@ -306,7 +337,7 @@ TraceCPU::ElasticDataGen::readNextWindow()
     while (num_read != windowSize) {
 
         // Create a new graph node
-        GraphNode* new_node = new GraphNode;
+        GraphNode* new_node = allocNode();
 
         // Read the next line to get the next record. If that fails then end of
         // trace has been reached and traceComplete needs to be set in addition
@@ -314,6 +345,7 @@ TraceCPU::ElasticDataGen::readNextWindow()
         if (!trace.read(new_node)) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
             traceComplete = true;
+            freeNode(new_node);
             return false;
         }
 
@@ -324,8 +356,8 @@ TraceCPU::ElasticDataGen::readNextWindow()
         addDepsOnParent(new_node, new_node->regDep);
 
         num_read++;
-        // Add to map
-        depGraph[new_node->seqNum] = new_node;
+        // Add to the window
+        depGraph.insert(new_node);
         if (new_node->robDep.empty() && new_node->regDep.empty()) {
             // Source dependencies are already complete, check if resources
             // are available and issue. The execution time is approximated
@@ -346,13 +378,13 @@ TraceCPU::ElasticDataGen::addDepsOnParent(GraphNode *new_node, T& dep_list)
     auto dep_it = dep_list.begin();
     while (dep_it != dep_list.end()) {
         // We look up the valid dependency, i.e. the parent of this node
-        auto parent_itr = depGraph.find(*dep_it);
-        if (parent_itr != depGraph.end()) {
+        GraphNode *parent = depGraph.find(*dep_it);
+        if (parent) {
             // If the parent is found, it is yet to be executed. Append a
             // pointer to the new node to the dependents list of the parent
             // node.
-            parent_itr->second->dependents.push_back(new_node);
-            auto num_depts = parent_itr->second->dependents.size();
+            parent->dependents.push_back(new_node);
+            auto num_depts = parent->dependents.size();
             elasticStats.maxDependents = std::max<double>(num_depts,
                                         elasticStats.maxDependents.value());
             dep_it++;
@@ -395,16 +427,13 @@ TraceCPU::ElasticDataGen::execute()
         }
     }
     // Proceed to execute from readyList
-    auto graph_itr = depGraph.begin();
-    auto free_itr = readyList.begin();
     // Iterate through readyList until the next free node has its execute
     // tick later than curTick or the end of readyList is reached
-    while (free_itr->execTick <= curTick() && free_itr != readyList.end()) {
+    while (!readyList.empty() && readyList.front().execTick <= curTick()) {
 
         // Get pointer to the node to be executed
-        graph_itr = depGraph.find(free_itr->seqNum);
-        assert(graph_itr != depGraph.end());
-        GraphNode* node_ptr = graph_itr->second;
+        GraphNode* node_ptr = readyList.front().node;
+        assert(depGraph.find(node_ptr->seqNum) == node_ptr);
 
         // If there is a retryPkt send that else execute the load
         if (retryPkt) {
@@ -433,6 +462,11 @@ TraceCPU::ElasticDataGen::execute()
             break;
         }
 
+        // After executing the node, remove it from readyList. This is done
+        // before waking up its dependents as they are inserted into the
+        // readyList, and none of them can go ahead of their parent.
+        readyList.pop_front();
+
         // Proceed to remove dependencies for the successfully executed node.
         // If it is a load which is not strictly ordered and we sent a
         // request for it successfully, we do not yet mark any register
@@ -487,8 +521,6 @@ TraceCPU::ElasticDataGen::execute()
             }
         }
 
-        // After executing the node, remove from readyList and delete node.
-        readyList.erase(free_itr);
         // If it is a cacheable load which was sent, don't delete
         // just yet.  Delete it in completeMemAccess() after the
         // response is received. If it is an strictly ordered
@@ -503,13 +535,9 @@ TraceCPU::ElasticDataGen::execute()
             (node_ptr->dependents).clear();
             // Update the stat for numOps simulated
             owner.updateNumOps(node_ptr->robNum);
-            // delete node
-            delete node_ptr;
-            // remove from graph
-            depGraph.erase(graph_itr);
+            // remove from graph and return the node to the pool
+            freeNode(depGraph.erase(node_ptr->seqNum));
         }
-        // Point to first node to continue to next iteration of while loop
-        free_itr = readyList.begin();
     } // end of while loop
 
     // Print readyList, sizes of queues and resource status after updating
@@ -593,7 +621,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
     }
 
     // Create a request and the packet containing request
-    auto req = std::make_shared<Request>(
+    auto req = makeRequestPtr(
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, requestorId);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
@@ -638,7 +666,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
 }
 
 bool
-TraceCPU::ElasticDataGen::checkAndIssue(const GraphNode* node_ptr, bool first)
+TraceCPU::ElasticDataGen::checkAndIssue(GraphNode* node_ptr, bool first)
 {
     // Assert the node is dependency-free
     assert(node_ptr->robDep.empty() && node_ptr->regDep.empty());
@@ -658,7 +686,7 @@ TraceCPU::ElasticDataGen::checkAndIssue(const GraphNode* node_ptr, bool first)
                 node_ptr->seqNum);
         // Compute the execute tick by adding the compute delay for the node
         // and add the ready node to the ready list
-        addToSortedReadyList(node_ptr->seqNum,
+        addToSortedReadyList(node_ptr,
                              owner.clockEdge() + node_ptr->compDelay);
         // Account for the resources taken up by this issued node.
         hwResource.occupy(node_ptr);
@@ -691,9 +719,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
     } else {
         // If it is a load response then release the dependents waiting on it.
         // Get pointer to the completed load
-        auto graph_itr = depGraph.find(pkt->req->getReqInstSeqNum());
-        assert(graph_itr != depGraph.end());
-        GraphNode* node_ptr = graph_itr->second;
+        GraphNode* node_ptr = depGraph.find(pkt->req->getReqInstSeqNum());
+        assert(node_ptr);
 
         // Release resources occupied by the load
         hwResource.release(node_ptr);
@@ -711,10 +738,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
         (node_ptr->dependents).clear();
         // Update the stat for numOps completed
         owner.updateNumOps(node_ptr->robNum);
-        // delete node
-        delete node_ptr;
-        // remove from graph
-        depGraph.erase(graph_itr);
+        // remove from graph and return the node to the pool
+        freeNode(depGraph.erase(node_ptr->seqNum));
     }
 
     if (debug::TraceCPUData) {
@@ -745,60 +770,37 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
 }
 
 void
-TraceCPU::ElasticDataGen::addToSortedReadyList(NodeSeqNum seq_num,
+TraceCPU::ElasticDataGen::addToSortedReadyList(GraphNode *node_ptr,
                                                Tick exec_tick)
 {
     ReadyNode ready_node;
-    ready_node.seqNum = seq_num;
+    ready_node.seqNum = node_ptr->seqNum;
     ready_node.execTick = exec_tick;
-
-    // Iterator to readyList
-    auto itr = readyList.begin();
-
-    // If the readyList is empty, simply insert the new node at the beginning
-    // and return
-    if (itr == readyList.end()) {
-        readyList.insert(itr, ready_node);
-        elasticStats.maxReadyListSize =
-            std::max<double>(readyList.size(),
-                             elasticStats.maxReadyListSize.value());
-        return;
+    ready_node.node = node_ptr;
+
+    // If the first node in the list failed to execute, its position as the
+    // first is maintained regardless of the execute tick of the new node.
+    auto first = readyList.begin();
+    if (retryPkt && first != readyList.end() &&
+        retryPkt->req->getReqInstSeqNum() == first->seqNum) {
+        first++;
     }
 
-    // If the new node has its execution tick equal to the first node in the
-    // list then go to the next node. If the first node in the list failed
-    // to execute, its position as the first is thus maintained.
-    if (retryPkt) {
-        if (retryPkt->req->getReqInstSeqNum() == itr->seqNum)
-            itr++;
-    }
-
-    // Increment the iterator and compare the node pointed to by it to the new
-    // node till the position to insert the new node is found.
-    bool found = false;
-    while (!found && itr != readyList.end()) {
-        // If the execution tick of the new node is less than the node then
-        // this is the position to insert
-        if (exec_tick < itr->execTick) {
-            found = true;
-        // If the execution tick of the new node is equal to the node then
-        // sort in ascending order of sequence numbers
-        } else if (exec_tick == itr->execTick) {
-            // If the sequence number of the new node is less than the node
-            // then this is the position to insert
-            if (seq_num < itr->seqNum) {
-                found = true;
-            // Else go to next node
-            } else {
-                itr++;
-            }
-        } else {
-            // If the execution tick of the new node is greater than the node
-            // then go to the next node.
-            itr++;
-        }
+    // Nodes are sorted in ascending order of execution tick, and nodes with
+    // the same execution tick in ascending order of sequence number. New
+    // nodes mostly execute later than those already in the list, so check
+    // the back before searching for the position to insert.
+    auto before = [](const ReadyNode &a, const ReadyNode &b) {
+        return a.execTick < b.execTick ||
+            (a.execTick == b.execTick && a.seqNum < b.seqNum);
+    };
+    if (first == readyList.end() || before(readyList.back(), ready_node)) {
+        readyList.push_back(ready_node);
+    } else {
+        readyList.insert(std::upper_bound(first, readyList.end(), ready_node,
+                                          before),
+                         ready_node);
     }
-    readyList.insert(itr, ready_node);
     // Update the stat for max size reached of the readyList
     elasticStats.maxReadyListSize = std::max<double>(readyList.size(),
                                         elasticStats.maxReadyListSize.value());
@@ -807,21 +809,70 @@ TraceCPU::ElasticDataGen::addToSortedReadyList(NodeSeqNum seq_num,
 void
 TraceCPU::ElasticDataGen::printReadyList()
 {
-    auto itr = readyList.begin();
-    if (itr == readyList.end()) {
+    if (readyList.empty()) {
         DPRINTF(TraceCPUData, "readyList is empty.\n");
         return;
     }
     DPRINTF(TraceCPUData, "Printing readyList:\n");
-    while (itr != readyList.end()) {
-        auto graph_itr = depGraph.find(itr->seqNum);
-        [[maybe_unused]] GraphNode* node_ptr = graph_itr->second;
-        DPRINTFR(TraceCPUData, "\t%lld(%s), %lld\n", itr->seqNum,
-            node_ptr->typeToStr(), itr->execTick);
-        itr++;
+    for ([[maybe_unused]] const auto &ready_node : readyList) {
+        DPRINTFR(TraceCPUData, "\t%lld(%s), %lld\n", ready_node.seqNum,
+            ready_node.node->typeToStr(), ready_node.execTick);
     }
 }
 
+size_t
+TraceCPU::ElasticDataGen::DepWindow::slotIndex(NodeSeqNum seq_num) const
+{
+    if (slots.empty() || seq_num < slots.front().seqNum)
+        return slots.size();
+
+    // Sequence numbers in a trace are usually contiguous, in which case the
+    // offset from the oldest slot is the index.
+    size_t idx = seq_num - slots.front().seqNum;
+    if (idx < slots.size() && slots[idx].seqNum == seq_num)
+        return idx;
+
+    auto it = std::lower_bound(slots.begin(), slots.end(), seq_num,
+        [](const Slot &slot, NodeSeqNum seq) { return slot.seqNum < seq; });
+    if (it == slots.end() || it->seqNum != seq_num)
+        return slots.size();
+    return it - slots.begin();
+}
+
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::DepWindow::find(NodeSeqNum seq_num) const
+{
+    size_t idx = slotIndex(seq_num);
+    return idx < slots.size() ? slots[idx].node : nullptr;
+}
+
+void
+TraceCPU::ElasticDataGen::DepWindow::insert(GraphNode *node)
+{
+    panic_if(!slots.empty() && node->seqNum <= slots.back().seqNum,
+             "Elastic trace node %lli follows node %lli, sequence numbers "
+             "must be increasing.", node->seqNum, slots.back().seqNum);
+    slots.push_back({node->seqNum, node});
+    ++numNodes;
+}
+
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::DepWindow::erase(NodeSeqNum seq_num)
+{
+    size_t idx = slotIndex(seq_num);
+    assert(idx < slots.size() && slots[idx].node);
+
+    GraphNode *node = slots[idx].node;
+    slots[idx].node = nullptr;
+    --numNodes;
+
+    // Reclaim the slots of completed nodes at the front of the window
+    while (!slots.empty() && !slots.front().node)
+        slots.pop_front();
+
+    return node;
+}
+
 TraceCPU::ElasticDataGen::HardwareResource::HardwareResource(
         uint16_t max_rob, uint16_t max_stores, uint16_t max_loads) :
     sizeROB(max_rob),
@@ -1084,7 +1135,7 @@ TraceCPU::FixedRetryGen::send(Addr addr, unsigned size, const MemCmd& cmd,
 {
 
     // Create new request
-    auto req = std::make_shared<Request>(addr, size, flags, requestorId);
+    auto req = makeRequestPtr(addr, size, flags, requestorId);
     req->setPC(pc);
 
     // If this is not done it triggers assert in L1 cache for invalid contextId
@@ -38,11 +38,12 @@
 #ifndef __CPU_TRACE_TRACE_CPU_HH__
 #define __CPU_TRACE_TRACE_CPU_HH__
 
+#include <atomic>
 #include <cstdint>
-#include <list>
+#include <deque>
 #include <queue>
 #include <set>
-#include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "debug/TraceCPUData.hh"
@@ -55,7 +56,6 @@
 #include "proto/packet.pb.h"
 #include "proto/protoio.hh"
 #include "sim/clocked_object.hh"
-#include "sim/sim_events.hh"
 
 namespace gem5
 {
@@ -136,9 +136,14 @@ namespace gem5
  * Strictly-ordered requests are skipped and the dependencies on such requests
  * are handled by simply marking them complete immediately.
  *
- * A CountedExitEvent that contains a static int belonging to the Trace CPU
- * class as a down counter is used to implement multi Trace CPU simulation
- * exit.
+ * Nodes are drawn from a per-generator pool and recycled once they complete,
+ * and the dependency graph is an index-based window ordered by sequence
+ * number, so steady-state replay does not allocate.
+ *
+ * An atomic down counter shared by all Trace CPUs is used to implement multi
+ * Trace CPU simulation exit. As the counter is safe to decrement from any
+ * thread, Trace CPUs replaying per-core traces may be placed on separate
+ * event queues (see configs/example/etrace_replay.py).
  */
 
 class TraceCPU : public ClockedObject
@@ -543,10 +548,10 @@ class TraceCPU : public ClockedObject
         {
           public:
             /** Typedef for the list containing the ROB dependencies */
-            typedef std::list<NodeSeqNum> RobDepList;
+            typedef std::vector<NodeSeqNum> RobDepList;
 
             /** Typedef for the list containing the register dependencies */
-            typedef std::list<NodeSeqNum> RegDepList;
+            typedef std::vector<NodeSeqNum> RegDepList;
 
             /** Instruction sequence number */
             NodeSeqNum seqNum;
@@ -636,6 +641,78 @@ class TraceCPU : public ClockedObject
 
             /** The tick at which the ready node must be executed */
             Tick execTick;
+
+            /** The ready node itself, saving a lookup in the window */
+            GraphNode *node;
+        };
+
+        /**
+         * The DepWindow holds the nodes of the dependency graph in ascending
+         * order of sequence number. Since the trace is in program order, new
+         * nodes are appended at the back and nodes are found by indexing
+         * from the oldest slot, falling back to a binary search when the
+         * sequence numbers in the trace are not contiguous. Completed nodes
+         * leave an empty slot behind which is reclaimed once it reaches the
+         * front of the window.
+         */
+        class DepWindow
+        {
+          public:
+            /**
+             * Find a node in the window.
+             *
+             * @param seq_num sequence number of the node
+             * @return the node, or nullptr if it is not in the window
+             */
+            GraphNode *find(NodeSeqNum seq_num) const;
+
+            /**
+             * Append a node to the window. Its sequence number must be
+             * larger than that of any node inserted before.
+             */
+            void insert(GraphNode *node);
+
+            /**
+             * Remove a node from the window.
+             *
+             * @param seq_num sequence number of a node in the window
+             * @return the removed node
+             */
+            GraphNode *erase(NodeSeqNum seq_num);
+
+            /** Number of nodes in the window */
+            size_t size() const { return numNodes; }
+
+            /** True if there are no nodes in the window */
+            bool empty() const { return numNodes == 0; }
+
+            /** Apply a function to every node in the window. */
+            template <typename F>
+            void
+            forEach(F f) const
+            {
+                for (const auto &slot : slots) {
+                    if (slot.node)
+                        f(slot.node);
+                }
+            }
+
+          private:
+            /** A node and its sequence number, kept once the node is gone */
+            struct Slot
+            {
+                NodeSeqNum seqNum;
+                GraphNode *node;
+            };
+
+            /** Index of the slot holding a sequence number, or slots.size() */
+            size_t slotIndex(NodeSeqNum seq_num) const;
+
+            /** Slots in ascending order of sequence number */
+            std::deque<Slot> slots;
+
+            /** Number of occupied slots */
+            size_t numNodes = 0;
         };
 
         /**
@@ -823,6 +900,8 @@ class TraceCPU : public ClockedObject
                     windowSize);
         }
 
+        ~ElasticDataGen();
+
         /**
          * Called from TraceCPU init(). Reads the first message from the
          * input trace file and returns the send tick.
@@ -892,10 +971,10 @@ class TraceCPU : public ClockedObject
          * Add a ready node to the readyList. When inserting, ensure the nodes
          * are sorted in ascending order of their execute ticks.
          *
-         * @param seq_num seq. num of ready node
+         * @param node_ptr the ready node
          * @param exec_tick the execute tick of the ready node
          */
-        void addToSortedReadyList(NodeSeqNum seq_num, Tick exec_tick);
+        void addToSortedReadyList(GraphNode *node_ptr, Tick exec_tick);
 
         /** Print readyList for debugging using debug flag TraceCPUData. */
         void printReadyList();
@@ -925,7 +1004,7 @@ class TraceCPU : public ClockedObject
          * @param first true if this is the first attempt to issue this node
          * @return true if node was added to readyList
          */
-        bool checkAndIssue(const GraphNode* node_ptr, bool first=true);
+        bool checkAndIssue(GraphNode* node_ptr, bool first=true);
 
         /** Get number of micro-ops modelled in the TraceCPU replay */
         uint64_t getMicroOpCount() const { return trace.getMicroOpCount(); }
@@ -975,8 +1054,23 @@ class TraceCPU : public ClockedObject
          */
         HardwareResource hwResource;
 
+        /**
+         * Get a node from the pool, allocating a new one only if none is
+         * free.
+         */
+        GraphNode *allocNode();
+
+        /**
+         * Return a completed node to the pool. Its dependency lists are
+         * cleared but keep their storage for the next node.
+         */
+        void freeNode(GraphNode *node_ptr);
+
         /** Store the depGraph of GraphNodes */
-        std::unordered_map<NodeSeqNum, GraphNode*> depGraph;
+        DepWindow depGraph;
+
+        /** Completed nodes available for reuse */
+        std::vector<GraphNode *> freeNodes;
 
         /**
          * Queue of dependency-free nodes that are pending issue because
@@ -985,10 +1079,10 @@ class TraceCPU : public ClockedObject
          * into the queue in that order. Thus nodes are more likely to
          * issue in program order.
          */
-        std::queue<const GraphNode*> depFreeQueue;
+        std::queue<GraphNode*> depFreeQueue;
 
         /** List of nodes that are ready to execute */
-        std::list<ReadyNode> readyList;
+        std::deque<ReadyNode> readyList;
 
       protected:
         // Defining the a stat group
@@ -1057,19 +1151,22 @@ class TraceCPU : public ClockedObject
     Tick traceOffset;
 
     /**
-     * Number of Trace CPUs in the system used as a shared variable and passed
-     * to the CountedExitEvent event used for counting down exit events.  It is
-     * incremented in the constructor call so that the total is arrived at
-     * automatically.
+     * Number of Trace CPUs in the system used as a shared down counter by
+     * the execCompleteEvent of each Trace CPU. It is incremented in the
+     * constructor call so that the total is arrived at automatically. It is
+     * atomic as Trace CPUs may run on separate event queues.
      */
-    static int numTraceCPUs;
+    static std::atomic<int> numTraceCPUs;
+
+    /** Decrement numTraceCPUs and exit the simulation loop at zero. */
+    void countDownExit();
 
    /**
-    * A CountedExitEvent which when serviced decrements the counter. A sim
-    * exit event is scheduled when the counter equals zero, that is all
-    * instances of Trace CPU have had their execCompleteEvent serviced.
+    * An event which when serviced decrements the counter. A sim exit event
+    * is scheduled when the counter equals zero, that is all instances of
+    * Trace CPU have had their execCompleteEvent serviced.
     */
-    CountedExitEvent *execCompleteEvent;
+    EventFunctionWrapper execCompleteEvent;
 
     /**
      * Exit when any one Trace CPU completes its execution. If this is
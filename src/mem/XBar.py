@@ -100,6 +100,13 @@ class BaseXBar(ClockedObject):
         False, "Perform address mapping for the default port"
     )
 
+    # Routing decisions can be cached per address granule, where the
+    # granule is the largest aligned block that never straddles a range
+    # or an interleaving stripe. The cache is off by default
+    route_cache_entries = Param.Unsigned(
+        0, "Number of entries of the routing cache (0 to disable)"
+    )
+
 
 class NoncoherentXBar(BaseXBar):
     type = "NoncoherentXBar"
@@ -154,6 +161,13 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize("8MiB", "Maximum capacity of snoop filter")
 
+    # A non-zero associativity makes the filter finite: it tracks
+    # max_capacity worth of lines in sets of this many ways, and the
+    # crossbar back-invalidates the copies of the lines it evicts.
+    assoc = Param.Unsigned(
+        0, "Associativity of a finite snoop filter, 0 to track all lines"
+    )
+
 
 # We use a coherent crossbar to connect multiple requestors to the L2
 # caches. Normally this crossbar would be part of the cache itself.
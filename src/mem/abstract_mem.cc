@@ -62,6 +62,7 @@ AbstractMemory::AbstractMemory(const Params &p) :
              (MemBackdoor::Flags)(p.writeable ?
                  MemBackdoor::Readable | MemBackdoor::Writeable :
                  MemBackdoor::Readable)),
+    lazyFill(nullptr),
     confTableReported(p.conf_table_reported), inAddrMap(p.in_addr_map),
     kvmMap(p.kvm_map), writeable(p.writeable), _system(NULL),
     stats(*this)
@@ -115,6 +116,16 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     pmemAddr = pmem_addr;
 }
 
+void
+AbstractMemory::setLazyFill(chunked_store::LazyFill *fill)
+{
+    // Requestors holding the backdoor would bypass the fill.
+    if (fill && backdoor.ptr())
+        backdoor.invalidate();
+
+    lazyFill = fill;
+}
+
 AbstractMemory::MemStats::MemStats(AbstractMemory &_mem)
     : statistics::Group(&_mem), mem(_mem),
     ADD_STAT(bytesRead, statistics::units::Byte::get(),
@@ -393,6 +404,7 @@ AbstractMemory::access(PacketPtr pkt)
 
     assert(pkt->getAddrRange().isSubset(range));
 
+    restoreRange(pkt->getAddr(), pkt->getSize());
     uint8_t *host_addr = toHostAddr(pkt->getAddr());
 
     if (pkt->cmd == MemCmd::SwapReq) {
@@ -483,6 +495,7 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
 {
     assert(pkt->getAddrRange().isSubset(range));
 
+    restoreRange(pkt->getAddr(), pkt->getSize());
     uint8_t *host_addr = toHostAddr(pkt->getAddr());
 
     if (pkt->isRead()) {
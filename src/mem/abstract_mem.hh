@@ -47,6 +47,7 @@
 #define __MEM_ABSTRACT_MEMORY_HH__
 
 #include "mem/backdoor.hh"
+#include "mem/chunked_store.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
 #include "sim/clocked_object.hh"
@@ -120,6 +121,10 @@ class AbstractMemory : public ClockedObject
     // Backdoor to access this memory.
     MemBackdoor backdoor;
 
+    // Fills the backing store on first use after a lazy checkpoint
+    // restore, or nullptr if the backing store is fully populated
+    chunked_store::LazyFill *lazyFill;
+
     // Enable specific memories to be reported to the configuration table
     const bool confTableReported;
 
@@ -241,10 +246,31 @@ class AbstractMemory : public ClockedObject
      */
     void setBackingStore(uint8_t* pmem_addr);
 
+    /**
+     * Fill the backing store lazily from a checkpoint. Until the store
+     * is complete, no backdoor is handed out and every access fills the
+     * chunks it touches first.
+     *
+     * @param fill The lazy fill of the backing store, or nullptr
+     */
+    void setLazyFill(chunked_store::LazyFill *fill);
+
+    /**
+     * Make sure the given range of this memory holds its checkpointed
+     * contents before it is accessed through a host pointer.
+     */
+    void
+    restoreRange(Addr addr, Addr size)
+    {
+        if (lazyFill)
+            lazyFill->fill(toHostAddr(addr), size);
+    }
+
     void
     getBackdoor(MemBackdoorPtr &bd_ptr)
     {
-        if (lockedAddrList.empty() && backdoor.ptr())
+        if (lockedAddrList.empty() && backdoor.ptr() &&
+                (!lazyFill || lazyFill->complete()))
             bd_ptr = &backdoor;
     }
 
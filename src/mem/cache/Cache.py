@@ -102,6 +102,16 @@ class BaseCache(ClockedObject):
     demand_mshr_reserve = Param.Unsigned(1, "MSHRs reserved for demand access")
     tgts_per_mshr = Param.Unsigned("Max number of accesses per MSHR")
     write_buffers = Param.Unsigned(8, "Number of write buffers")
+    hashed_queue_lookup = Param.Bool(
+        False,
+        "Index MSHRs and write buffers by block address, which speeds up "
+        "lookups in caches with many outstanding requests",
+    )
+    warm_checkpoint = Param.Bool(
+        False,
+        "Record the clean blocks of the cache and their coherence state in "
+        "checkpoints, and restore them when starting from a checkpoint",
+    )
 
     is_read_only = Param.Bool(False, "Is this cache read only (e.g. inst)")
 
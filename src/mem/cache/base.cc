@@ -45,6 +45,9 @@
 
 #include "mem/cache/base.hh"
 
+#include <algorithm>
+#include <cstring>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "debug/Cache.hh"
@@ -82,8 +85,10 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       cpuSidePort (p.name + ".cpu_side_port", *this, "CpuSidePort"),
       memSidePort(p.name + ".mem_side_port", this, "MemSidePort"),
       accessor(*this),
-      mshrQueue("MSHRs", p.mshrs, 0, p.demand_mshr_reserve, p.name),
-      writeBuffer("write buffer", p.write_buffers, p.mshrs, p.name),
+      mshrQueue("MSHRs", p.mshrs, 0, p.demand_mshr_reserve, p.name,
+                p.hashed_queue_lookup),
+      writeBuffer("write buffer", p.write_buffers, p.mshrs, p.name,
+                  p.hashed_queue_lookup),
       tags(p.tags),
       compressor(p.compressor),
       prefetcher(p.prefetcher),
@@ -106,6 +111,9 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       isReadOnly(p.is_read_only),
       replaceExpansions(p.replace_expansions),
       moveContractions(p.move_contractions),
+      warmCheckpoint(p.warm_checkpoint),
+      cacheSize(p.size),
+      cacheAssoc(p.assoc),
       blocked(0),
       order(0),
       noTargetMSHR(nullptr),
@@ -199,6 +207,15 @@ BaseCache::init()
     forwardSnoops = cpuSidePort.isSnooping();
 }
 
+void
+BaseCache::startup()
+{
+    ClockedObject::startup();
+
+    if (!warmBlocks.empty())
+        restoreWarmBlocks();
+}
+
 Port &
 BaseCache::getPort(const std::string &if_name, PortID idx)
 {
@@ -247,7 +264,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = makeRequestPtr(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -720,6 +737,18 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
     CacheBlk *blk = tags->findBlock(pkt->getAddr(), is_secure);
     MSHR *mshr = mshrQueue.findMatch(blk_addr, is_secure);
 
+    // A cache restoring warm state is going to share this block. It may
+    // only have it writable if it sits above our own writable copy, and
+    // if it is anywhere else our copy must not stay writable either.
+    if (pkt->isWarmFill() && blk && blk->isValid()) {
+        if (!from_cpu_side) {
+            blk->clearCoherenceBits(CacheBlk::WritableBit);
+            pkt->setHasSharers();
+        } else if (!blk->isSet(CacheBlk::WritableBit)) {
+            pkt->setHasSharers();
+        }
+    }
+
     pkt->pushLabel(name());
 
     CacheBlkPrintWrapper cbpw(blk);
@@ -1708,7 +1737,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequestPtr(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1751,7 +1780,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequestPtr(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1825,7 +1854,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequestPtr(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -1842,6 +1871,103 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     }
 }
 
+void
+BaseCache::restoreWarmBlocks()
+{
+    std::vector<uint8_t> data(blkSize);
+
+    // Replay the fills first, without the memory side noticing, so that
+    // a block the replay evicts again was never recorded by the snoop
+    // filters below
+    for (const auto &warm_blk : warmBlocks) {
+        // The block size may have changed since the checkpoint
+        const Addr addr = warm_blk.addr & ~Addr(blkSize - 1);
+        if (tags->findBlock(addr, warm_blk.secure))
+            continue;
+
+        RequestPtr request = makeRequestPtr(
+            addr, blkSize, 0, Request::funcRequestorId);
+        if (warm_blk.secure) {
+            request->setFlags(Request::SECURE);
+        }
+
+        Packet packet(request, MemCmd::ReadReq);
+        packet.dataStatic(data.data());
+        // The memory map may have changed since the checkpoint as well
+        packet.setSuppressFuncError();
+
+        memSidePort.sendFunctional(&packet);
+        if (!packet.isResponse()) {
+            DPRINTF(Cache, "%s: no data for %#llx, not restoring it\n",
+                    __func__, addr);
+            continue;
+        }
+
+        // Any victim is a clean block replayed earlier, which nothing
+        // else knows about yet, so it is dropped without notice
+        PacketList writebacks;
+        CacheBlk *blk = allocateBlock(&packet, writebacks);
+        for (auto wb_pkt : writebacks) {
+            delete wb_pkt;
+        }
+        if (!blk)
+            continue;
+
+        blk->setCoherenceBits(warm_blk.coherence &
+            (CacheBlk::WritableBit | CacheBlk::ReadableBit));
+        std::memcpy(blk->data, data.data(), blkSize);
+        updateBlockData(blk, &packet, false);
+    }
+
+    // Then announce the blocks that are left to the rest of the
+    // hierarchy, which also settles their writability
+    unsigned restored = 0;
+    tags->forEachBlk([this, &data, &restored](CacheBlk &blk) {
+        if (blk.isValid()) {
+            announceWarmBlock(blk, data.data());
+            ++restored;
+        }
+    });
+
+    DPRINTF(Cache, "%s: restored %u of %u checkpointed blocks\n", __func__,
+            restored, warmBlocks.size());
+
+    warmBlocks.clear();
+    warmBlocks.shrink_to_fit();
+}
+
+void
+BaseCache::announceWarmBlock(CacheBlk &blk, uint8_t *data)
+{
+    RequestPtr request = makeRequestPtr(regenerateBlkAddr(&blk), blkSize,
+        0, Request::funcRequestorId);
+    if (blk.isSecure()) {
+        request->setFlags(Request::SECURE);
+    }
+
+    // The warm fill visits every other cache holding the block, as clean
+    // data never satisfies a functional read, and lets the snoop filters
+    // on the way record this cache as a holder
+    Packet packet(request, MemCmd::ReadReq);
+    packet.dataStatic(data);
+    packet.setWarmFill();
+    packet.setSuppressFuncError();
+    memSidePort.sendFunctional(&packet);
+
+    if (packet.hasSharers()) {
+        blk.clearCoherenceBits(CacheBlk::WritableBit);
+    }
+
+    // A writable copy above this one relies on this copy being writable
+    // too, so caches above that restored theirs earlier must downgrade
+    if (!blk.isSet(CacheBlk::WritableBit) && cpuSidePort.isSnooping()) {
+        Packet snoop_pkt(request, MemCmd::ReadReq);
+        snoop_pkt.dataStatic(data);
+        snoop_pkt.setWarmFill();
+        cpuSidePort.sendFunctionalSnoop(&snoop_pkt);
+    }
+}
+
 void
 BaseCache::invalidateVisitor(CacheBlk &blk)
 {
@@ -2017,6 +2143,49 @@ BaseCache::serialize(CheckpointOut &cp) const
     // cache contains dirty data.
     bool bad_checkpoint(dirty);
     SERIALIZE_SCALAR(bad_checkpoint);
+
+    if (!warmCheckpoint)
+        return;
+
+    // Record the clean blocks oldest first, so that inserting them in
+    // that order on restore rebuilds a similar replacement state. Dirty
+    // blocks cannot be restored, as their data is not checkpointed.
+    std::vector<CacheBlk*> blks;
+    tags->forEachBlk([&blks](CacheBlk &blk) {
+        if (blk.isValid() && !blk.isSet(CacheBlk::DirtyBit))
+            blks.push_back(&blk);
+    });
+    std::stable_sort(blks.begin(), blks.end(),
+        [](const CacheBlk *a, const CacheBlk *b) {
+            return a->getAge() > b->getAge(); });
+
+    std::vector<Addr> warm_addrs;
+    std::vector<bool> warm_secure;
+    std::vector<unsigned> warm_coherence;
+    for (CacheBlk *blk : blks) {
+        warm_addrs.push_back(tags->regenerateBlkAddr(blk));
+        warm_secure.push_back(blk->isSecure());
+        warm_coherence.push_back(
+            (blk->isSet(CacheBlk::WritableBit) ? CacheBlk::WritableBit : 0) |
+            (blk->isSet(CacheBlk::ReadableBit) ? CacheBlk::ReadableBit : 0));
+    }
+
+    // The geometry tells whether the coherence state may be restored
+    // as is
+    unsigned warm_blk_size = blkSize;
+    uint64_t warm_size = cacheSize;
+    unsigned warm_assoc = cacheAssoc;
+    SERIALIZE_SCALAR(warm_blk_size);
+    SERIALIZE_SCALAR(warm_size);
+    SERIALIZE_SCALAR(warm_assoc);
+
+    unsigned warm_blocks = blks.size();
+    SERIALIZE_SCALAR(warm_blocks);
+    if (warm_blocks) {
+        SERIALIZE_CONTAINER(warm_addrs);
+        SERIALIZE_CONTAINER(warm_secure);
+        SERIALIZE_CONTAINER(warm_coherence);
+    }
 }
 
 void
@@ -2029,6 +2198,51 @@ BaseCache::unserialize(CheckpointIn &cp)
               "supported in the classic memory system. Please remove any "
               "caches or drain them properly before taking checkpoints.\n");
     }
+
+    // Checkpoints taken without warm state, or caches not asking for it,
+    // start cold
+    unsigned warm_blocks = 0;
+    UNSERIALIZE_OPT_SCALAR(warm_blocks);
+    if (!warmCheckpoint || !warm_blocks)
+        return;
+
+    std::vector<Addr> warm_addrs;
+    std::vector<bool> warm_secure;
+    std::vector<unsigned> warm_coherence;
+    UNSERIALIZE_CONTAINER(warm_addrs);
+    UNSERIALIZE_CONTAINER(warm_secure);
+    UNSERIALIZE_CONTAINER(warm_coherence);
+    fatal_if(warm_addrs.size() != warm_blocks ||
+             warm_secure.size() != warm_blocks ||
+             warm_coherence.size() != warm_blocks,
+             "%s: checkpoint records %u warm blocks but holds %u/%u/%u "
+             "entries\n", name(), warm_blocks, warm_addrs.size(),
+             warm_secure.size(), warm_coherence.size());
+
+    // Blocks of a different geometry may overlap or cover other data
+    // than what was checkpointed as writable, so they come back shared
+    unsigned warm_blk_size = 0;
+    uint64_t warm_size = 0;
+    unsigned warm_assoc = 0;
+    UNSERIALIZE_OPT_SCALAR(warm_blk_size);
+    UNSERIALIZE_OPT_SCALAR(warm_size);
+    UNSERIALIZE_OPT_SCALAR(warm_assoc);
+    unsigned coherence_mask = CacheBlk::WritableBit | CacheBlk::ReadableBit;
+    if (warm_blk_size != blkSize || warm_size != cacheSize ||
+        warm_assoc != cacheAssoc) {
+        warn("%s: restoring warm blocks checkpointed with a different "
+             "geometry (%u B blocks, %llu B, %u-way), writable blocks are "
+             "restored shared\n", name(), warm_blk_size, warm_size,
+             warm_assoc);
+        coherence_mask = CacheBlk::ReadableBit;
+    }
+
+    warmBlocks.clear();
+    warmBlocks.reserve(warm_blocks);
+    for (unsigned i = 0; i < warm_blocks; i++) {
+        warmBlocks.push_back({warm_addrs[i], warm_secure[i],
+            warm_coherence[i] & coherence_mask});
+    }
 }
 
 
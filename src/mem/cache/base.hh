@@ -49,6 +49,7 @@
 #include <cassert>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "base/compiler.hh"
@@ -957,6 +958,35 @@ class BaseCache : public ClockedObject
      */
     const bool moveContractions;
 
+    /**
+     * Whether checkpoints record the valid clean blocks of the cache,
+     * and restoring one refills them.
+     */
+    const bool warmCheckpoint;
+
+    /** Capacity of the cache, recorded with its warm blocks. */
+    const uint64_t cacheSize;
+
+    /** Associativity of the cache, recorded with its warm blocks. */
+    const unsigned cacheAssoc;
+
+    /** A block recorded in a checkpoint to be refilled on restore. */
+    struct WarmBlock
+    {
+        /** Address of the block. */
+        Addr addr;
+        /** Whether the block belongs to the secure address space. */
+        bool secure;
+        /** Coherence bits of the block. @sa CacheBlk::CoherenceBits */
+        unsigned coherence;
+    };
+
+    /**
+     * Blocks read from the checkpoint, oldest first, until startup()
+     * refills them.
+     */
+    std::vector<WarmBlock> warmBlocks;
+
     /**
      * Bit vector of the blocking reasons for the access path.
      * @sa #BlockedCause
@@ -1154,6 +1184,8 @@ class BaseCache : public ClockedObject
 
     void init() override;
 
+    void startup() override;
+
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
@@ -1333,6 +1365,30 @@ class BaseCache : public ClockedObject
      */
     void invalidateVisitor(CacheBlk &blk);
 
+    /**
+     * Refill the blocks recorded in the checkpoint. Their data is read
+     * functionally from the memory side, which is up to date since the
+     * checkpoint only holds clean blocks, and they are inserted oldest
+     * first so that the replacement policy rebuilds a similar recency
+     * order. Replaying the insertions rather than restoring blocks in
+     * place also allows the cache geometry or replacement policy to
+     * change between checkpoint and restore; blocks that no longer fit
+     * are dropped. Only the blocks left at the end are announced to the
+     * rest of the hierarchy.
+     */
+    void restoreWarmBlocks();
+
+    /**
+     * Send a functional warm fill for a restored block, so that the
+     * snoop filters below record this cache as a holder. Other caches
+     * holding the block on the way make it shared, and a block that ends
+     * up shared downgrades writable copies in the caches above.
+     *
+     * @param blk The restored block.
+     * @param data Scratch space for the block's data.
+     */
+    void announceWarmBlock(CacheBlk &blk, uint8_t *data);
+
     /**
      * Take an MSHR, turn it into a suitable downstream packet, and
      * send it out. This construct allows a queue entry to choose a suitable
@@ -1356,7 +1412,10 @@ class BaseCache : public ClockedObject
     /**
      * Serialize the state of the caches
      *
-     * We currently don't support checkpointing cache state, so this panics.
+     * The data in the cache is not checkpointed, so checkpoints of caches
+     * with dirty blocks are flagged as unrestorable. If warmCheckpoint is
+     * set, the addresses and coherence state of the clean blocks are
+     * recorded so that restoring the checkpoint starts with warm caches.
      */
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
@@ -390,10 +390,10 @@ Cache::handleTimingReqMiss(PacketPtr pkt, CacheBlk *blk, Tick forward_time,
 
         if (!mshr) {
             // copy the request and create a new SoftPFReq packet
-            RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
-                                                    pkt->req->getSize(),
-                                                    pkt->req->getFlags(),
-                                                    pkt->req->requestorId());
+            RequestPtr req = makeRequestPtr(pkt->req->getPaddr(),
+                                            pkt->req->getSize(),
+                                            pkt->req->getFlags(),
+                                            pkt->req->requestorId());
             pf = new Packet(req, pkt->cmd);
             pf->allocate();
             assert(pf->matchAddr(pkt));
@@ -975,7 +975,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     assert(blk && blk->isValid() && !blk->isSet(CacheBlk::DirtyBit));
 
     // Creating a zero sized write, a message to the snoop filter
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequestPtr(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1327,6 +1327,43 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
             return;
         }
 
+        if (pkt->isBackInvalidation() &&
+            wb_pkt->cmd == MemCmd::WritebackDirty) {
+            // as for a dirty block in handleSnoop, do not respond to
+            // the back-invalidation of a finite snoop filter, but
+            // write the dirty data towards its point of reference as a
+            // WriteClean instead
+            RequestPtr req = makeRequestPtr(
+                blk_addr, blkSize, 0, Request::wbRequestorId);
+            if (is_secure) {
+                req->setFlags(Request::SECURE);
+            }
+            req->taskId(wb_pkt->req->taskId());
+
+            PacketPtr wc_pkt =
+                new Packet(req, MemCmd::WriteClean, blkSize, pkt->id);
+            if (pkt->req->getDest()) {
+                req->setFlags(pkt->req->getDest());
+                wc_pkt->setWriteThrough();
+            }
+            if (wb_pkt->hasSharers()) {
+                wc_pkt->setHasSharers();
+            }
+            wc_pkt->allocate();
+            wc_pkt->setData(wb_pkt->getConstPtr<uint8_t>());
+
+            // Note: markInService will remove entry from writeback buffer.
+            markInService(wb_entry);
+            delete wb_pkt;
+
+            allocateWriteBuffer(wc_pkt,
+                                clockEdge(forwardLatency) + pkt->headerDelay);
+            pkt->setSatisfied();
+
+            // the WriteClean is neither responding nor discarded below
+            wb_pkt = wc_pkt;
+        }
+
         // conceptually writebacks are no different to other blocks in
         // this cache, so the behaviour is modelled after handleSnoop,
         // the difference being that instead of querying the block
@@ -101,9 +101,11 @@ class BaseDelta : public DictionaryCompressor<BaseType>
     std::unique_ptr<typename DictionaryCompressor<BaseType>::Pattern>
     getPattern(const DictionaryEntry& bytes,
         const DictionaryEntry& dict_bytes,
-        const int match_location) const override
+        const int match_location,
+        const std::size_t size_bound) const override
     {
-        return PatternFactory::getPattern(bytes, dict_bytes, match_location);
+        return PatternFactory::getPattern(bytes, dict_bytes, match_location,
+            size_bound);
     }
 
     std::string
@@ -120,6 +122,35 @@ class BaseDelta : public DictionaryCompressor<BaseType>
 
     void addToDictionary(DictionaryEntry data) override;
 
+    /** Number of chunks whose deltas are checked by a single vector op. */
+    static constexpr unsigned chunksPerVector = 4;
+
+    /** A vector of chunks, whose deltas are checked as a single unit. */
+    typedef uint64_t ChunkVector
+        __attribute__((vector_size(chunksPerVector * sizeof(uint64_t))));
+
+    /**
+     * Check, for every chunk of a line at once, whether its delta to the
+     * given base fits in DeltaSizeBits. The line must have at most 64
+     * chunks.
+     *
+     * @param chunks The cache line being compressed.
+     * @param base The base the deltas are calculated against.
+     * @return A bitmask with the bits of the fitting chunks set.
+     */
+    static uint64_t fittingDeltas(const std::vector<Base::Chunk>& chunks,
+        const BaseType base);
+
+    /**
+     * The patterns of a line only depend on which of the (at most two)
+     * bases each chunk fits in, so when a line is compressible they are
+     * determined with vector delta checks over the whole line, instead of
+     * being matched value by value. Incompressible lines use the generic
+     * dictionary path.
+     */
+    std::unique_ptr<Base::CompressionData> compress(
+        const std::vector<Base::Chunk>& chunks) override;
+
     std::unique_ptr<Base::CompressionData> compress(
         const std::vector<Base::Chunk>& chunks,
         Cycles& comp_lat, Cycles& decomp_lat) override;
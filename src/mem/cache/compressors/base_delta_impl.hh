@@ -33,6 +33,11 @@
 #ifndef __MEM_CACHE_COMPRESSORS_BASE_DELTA_IMPL_HH__
 #define __MEM_CACHE_COMPRESSORS_BASE_DELTA_IMPL_HH__
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "base/bitfield.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/base_delta.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
@@ -69,6 +74,92 @@ BaseDelta<BaseType, DeltaSizeBits>::addToDictionary(DictionaryEntry data)
         DictionaryCompressor<BaseType>::numEntries++] = data;
 }
 
+template <class BaseType, std::size_t DeltaSizeBits>
+uint64_t
+BaseDelta<BaseType, DeltaSizeBits>::fittingDeltas(
+    const std::vector<Base::Chunk>& chunks, const BaseType base)
+{
+    assert(chunks.size() <= 64);
+
+    // A delta fits if it lies in [-limit, limit] when interpreted as a
+    // signed base. Biasing it by the limit turns this into a single
+    // unsigned comparison against twice the limit
+    const uint64_t limit = DeltaSizeBits ? mask(DeltaSizeBits - 1) : 0;
+    const ChunkVector bias = ChunkVector{} + (limit - base);
+    const ChunkVector type_mask = ChunkVector{} + mask(8 * sizeof(BaseType));
+    const ChunkVector range = ChunkVector{} + 2 * limit;
+
+    uint64_t fits = 0;
+    for (std::size_t i = 0; i < chunks.size(); i += chunksPerVector) {
+        // Pad the last vector with the base itself, which always fits
+        ChunkVector values = ChunkVector{} + base;
+        const std::size_t num_values =
+            std::min<std::size_t>(chunksPerVector, chunks.size() - i);
+        std::memcpy(&values, &chunks[i], num_values * sizeof(Base::Chunk));
+
+        const auto in_range = ((values + bias) & type_mask) <= range;
+        for (unsigned lane = 0; lane < chunksPerVector; lane++) {
+            fits |= uint64_t(in_range[lane] & 1) << (i + lane);
+        }
+    }
+
+    return fits & mask(chunks.size());
+}
+
+template <class BaseType, std::size_t DeltaSizeBits>
+std::unique_ptr<Base::CompressionData>
+BaseDelta<BaseType, DeltaSizeBits>::compress(
+    const std::vector<Base::Chunk>& chunks)
+{
+    if (chunks.size() > 64) {
+        return DictionaryCompressor<BaseType>::compress(chunks);
+    }
+
+    // A line is compressible if every chunk fits either the implicit zero
+    // base, or the base allocated by the first chunk that does not fit the
+    // zero base. Otherwise a third base would be needed, so leave it to the
+    // generic path to account for the failure
+    const uint64_t all_chunks = mask(chunks.size());
+    const uint64_t fits_zero = fittingDeltas(chunks, 0);
+    std::size_t base_index = chunks.size();
+    if (fits_zero != all_chunks) {
+        base_index = findLsbSet(all_chunks & ~fits_zero);
+        const uint64_t fits_base = fittingDeltas(chunks, chunks[base_index]);
+        if ((fits_zero | fits_base) != all_chunks) {
+            return DictionaryCompressor<BaseType>::compress(chunks);
+        }
+    }
+
+    using Pattern = typename DictionaryCompressor<BaseType>::Pattern;
+    using CompData = typename DictionaryCompressor<BaseType>::CompData;
+    std::unique_ptr<Base::CompressionData> comp_data =
+        this->instantiateDictionaryCompData();
+    CompData* const comp_data_ptr = static_cast<CompData*>(comp_data.get());
+
+    // Build the same patterns the value by value matching would have found
+    resetDictionary();
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        const DictionaryEntry bytes =
+            DictionaryCompressor<BaseType>::toDictionaryEntry(chunks[i]);
+        std::unique_ptr<Pattern> pattern;
+        if (bits(fits_zero, i)) {
+            pattern.reset(new PatternM(bytes, 0));
+        } else if (i == base_index) {
+            pattern.reset(new PatternX(bytes, -1));
+            addToDictionary(bytes);
+        } else {
+            pattern.reset(new PatternM(bytes, 1));
+        }
+
+        this->dictionaryStats.patterns[pattern->getPatternNumber()]++;
+        DPRINTF(CacheComp, "Compressed %016x to %s\n", chunks[i],
+            pattern->print());
+        comp_data_ptr->addEntry(std::move(pattern));
+    }
+
+    return comp_data;
+}
+
 template <class BaseType, std::size_t DeltaSizeBits>
 std::unique_ptr<Base::CompressionData>
 BaseDelta<BaseType, DeltaSizeBits>::compress(
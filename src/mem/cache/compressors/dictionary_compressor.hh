@@ -146,25 +146,29 @@ class DictionaryCompressor : public BaseDictionaryCompressor
      * Create a factory to determine if input matches a pattern. The if else
      * chains are constructed by recursion. The patterns should be explored
      * sorted by size for correct behaviour.
+     *
+     * The matching pattern is only heap allocated if its size is strictly
+     * smaller than the given bound, so that looking for the best match
+     * among all dictionary entries does not allocate a pattern per entry.
      */
     template <class Head, class... Tail>
     struct Factory
     {
         static std::unique_ptr<Pattern> getPattern(
             const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
-            const int match_location)
+            const int match_location, const std::size_t size_bound)
         {
             // If match this pattern, instantiate it. If a negative match
             // location is used, the patterns that use the dictionary bytes
             // must return false. This is used when there are no dictionary
             // entries yet
             if (Head::isPattern(bytes, dict_bytes, match_location)) {
-                return std::unique_ptr<Pattern>(
-                            new Head(bytes, match_location));
+                return instantiate<Head>(bytes, match_location, size_bound);
             // Otherwise, go for next pattern
             } else {
                 return Factory<Tail...>::getPattern(bytes, dict_bytes,
-                                                    match_location);
+                                                    match_location,
+                                                    size_bound);
             }
         }
     };
@@ -184,12 +188,36 @@ class DictionaryCompressor : public BaseDictionaryCompressor
 
         static std::unique_ptr<Pattern>
         getPattern(const DictionaryEntry& bytes,
-            const DictionaryEntry& dict_bytes, const int match_location)
+            const DictionaryEntry& dict_bytes, const int match_location,
+            const std::size_t size_bound)
         {
-            return std::unique_ptr<Pattern>(new Head(bytes, match_location));
+            return instantiate<Head>(bytes, match_location, size_bound);
         }
     };
 
+    /**
+     * Instantiate a pattern if it is smaller than a size bound. The pattern
+     * is first built on the stack to query its size, which is cheap, and
+     * only moved to the heap if it is going to be used.
+     *
+     * @tparam P The pattern class.
+     * @param bytes The bytes to be compressed.
+     * @param match_location The dictionary location used by the pattern.
+     * @param size_bound Exclusive upper bound on the size of the pattern.
+     * @return The pattern, or nullptr if it is not smaller than the bound.
+     */
+    template <class P>
+    static std::unique_ptr<Pattern>
+    instantiate(const DictionaryEntry& bytes, const int match_location,
+        const std::size_t size_bound)
+    {
+        const P candidate(bytes, match_location);
+        if (candidate.getSizeBits() >= size_bound) {
+            return nullptr;
+        }
+        return std::unique_ptr<Pattern>(new P(bytes, match_location));
+    }
+
     /** The dictionary. */
     std::vector<DictionaryEntry> dictionary;
 
@@ -197,10 +225,17 @@ class DictionaryCompressor : public BaseDictionaryCompressor
      * Since the factory cannot be instantiated here, classes that inherit
      * from this base class have to implement the call to their factory's
      * getPattern.
+     *
+     * @param bytes The bytes to be compressed.
+     * @param dict_bytes The dictionary entry being matched against.
+     * @param match_location The location of the dictionary entry.
+     * @param size_bound Exclusive upper bound on the size of the pattern.
+     * @return The matching pattern, or nullptr if it is not smaller than
+     *         the bound.
      */
     virtual std::unique_ptr<Pattern>
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
-        const int match_location) const = 0;
+        const int match_location, const std::size_t size_bound) const = 0;
 
     /**
      * Compress data.
@@ -237,12 +272,14 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     instantiateDictionaryCompData() const;
 
     /**
-     * Apply compression.
+     * Apply compression. Sub-classes may override this to provide a faster
+     * path for lines whose encoding can be determined without matching
+     * every value individually.
      *
      * @param chunks The cache line to be compressed.
      * @return Cache line after compression.
      */
-    std::unique_ptr<Base::CompressionData> compress(
+    virtual std::unique_ptr<Base::CompressionData> compress(
         const std::vector<Chunk>& chunks);
 
     std::unique_ptr<Base::CompressionData> compress(
@@ -34,6 +34,8 @@
 #define __MEM_CACHE_COMPRESSORS_DICTIONARY_COMPRESSOR_IMPL_HH__
 
 #include <algorithm>
+#include <cassert>
+#include <limits>
 
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
@@ -99,17 +101,16 @@ DictionaryCompressor<T>::compressValue(const T data)
 
     // Start as a no-match pattern. A negative match location is used so that
     // patterns that depend on the dictionary entry don't match
-    std::unique_ptr<Pattern> pattern =
-        getPattern(bytes, toDictionaryEntry(0), -1);
+    std::unique_ptr<Pattern> pattern = getPattern(bytes, toDictionaryEntry(0),
+        -1, std::numeric_limits<std::size_t>::max());
+    assert(pattern);
 
-    // Search for word on dictionary
+    // Search for word on dictionary. Only patterns that are better than the
+    // current best are instantiated
     for (std::size_t i = 0; i < numEntries; i++) {
-        // Try matching input with possible patterns
         std::unique_ptr<Pattern> temp_pattern =
-            getPattern(bytes, dictionary[i], i);
-
-        // Check if found pattern is better than previous
-        if (temp_pattern->getSizeBits() < pattern->getSizeBits()) {
+            getPattern(bytes, dictionary[i], i, pattern->getSizeBits());
+        if (temp_pattern) {
             pattern = std::move(temp_pattern);
         }
     }
@@ -192,23 +193,17 @@ DictionaryCompressor<T>::decompress(const CompressionData* comp_data,
     // Reset dictionary
     resetDictionary();
 
-    // Decompress every entry sequentially
-    std::vector<T> decomp_values;
+    // Decompress every entry sequentially, concatenating the decompressed
+    // values directly into the original data
+    const std::size_t values_per_entry = sizeof(uint64_t)/sizeof(T);
+    std::fill(data, data + blkSize/8, 0);
+    std::size_t index = 0;
     for (const auto& entry : casted_comp_data->entries) {
         const T value = decompressValue(&*entry);
-        decomp_values.push_back(value);
         DPRINTF(CacheComp, "Decompressed %s to %x\n", entry->print(), value);
-    }
-
-    // Concatenate the decompressed values to generate the original data
-    for (std::size_t i = 0; i < blkSize/8; i++) {
-        data[i] = 0;
-        const std::size_t values_per_entry = sizeof(uint64_t)/sizeof(T);
-        for (int j = values_per_entry - 1; j >= 0; j--) {
-            data[i] |=
-                static_cast<uint64_t>(decomp_values[values_per_entry*i+j]) <<
-                (j*8*sizeof(T));
-        }
+        data[index / values_per_entry] |= static_cast<uint64_t>(value) <<
+            ((index % values_per_entry) * 8 * sizeof(T));
+        index++;
     }
 }
 
@@ -115,12 +115,14 @@ class FPC : public DictionaryCompressor<uint32_t>
     std::unique_ptr<Pattern> getPattern(
         const DictionaryEntry& bytes,
         const DictionaryEntry& dict_bytes,
-        const int match_location) const override
+        const int match_location,
+        const std::size_t size_bound) const override
     {
         using PatternFactory = Factory<ZeroRun, SignExtended4Bits,
             SignExtended1Byte, SignExtendedHalfword, ZeroPaddedHalfword,
             SignExtendedTwoHalfwords, RepBytes, Uncompressed>;
-        return PatternFactory::getPattern(bytes, dict_bytes, match_location);
+        return PatternFactory::getPattern(bytes, dict_bytes, match_location,
+            size_bound);
     }
 
     void addToDictionary(const DictionaryEntry data) override;
@@ -137,9 +137,11 @@ class FPCD : public DictionaryCompressor<uint32_t>
 
     std::unique_ptr<Pattern>
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
-        const int match_location) const override
+        const int match_location,
+        const std::size_t size_bound) const override
     {
-        return PatternFactory::getPattern(bytes, dict_bytes, match_location);
+        return PatternFactory::getPattern(bytes, dict_bytes, match_location,
+            size_bound);
     }
 
     void addToDictionary(DictionaryEntry data) override;
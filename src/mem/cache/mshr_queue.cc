@@ -54,8 +54,10 @@ namespace gem5
 
 MSHRQueue::MSHRQueue(const std::string &_label,
                      int num_entries, int reserve,
-                     int demand_reserve, std::string cache_name = "")
-    : Queue<MSHR>(_label, num_entries, reserve, cache_name + ".mshr_queue"),
+                     int demand_reserve, std::string cache_name,
+                     bool hashed_lookup)
+    : Queue<MSHR>(_label, num_entries, reserve, cache_name + ".mshr_queue",
+                  hashed_lookup),
       demandReserve(demand_reserve)
 {}
 
@@ -74,6 +76,7 @@ MSHRQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
     mshr->allocate(blk_addr, blk_size, pkt, when_ready, order, alloc_on_fill);
     mshr->allocIter = allocatedList.insert(allocatedList.end(), mshr);
     mshr->readyIter = addToReadyList(mshr);
+    indexEntry(mshr);
 
     allocated += 1;
     return mshr;
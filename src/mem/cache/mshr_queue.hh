@@ -77,9 +77,11 @@ class MSHRQueue : public Queue<MSHR>
      * any access.
      * @param demand_reserve The minimum number of entries needed to satisfy
      * demand accesses.
+     * @param hashed_lookup Whether MSHRs are indexed by block address.
      */
     MSHRQueue(const std::string &_label, int num_entries, int reserve,
-              int demand_reserve, std::string cache_name);
+              int demand_reserve, std::string cache_name,
+              bool hashed_lookup = false);
 
     /**
      * Allocates a new MSHR for the request and size. This places the request
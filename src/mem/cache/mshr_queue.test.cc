@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/cache/mshr.hh"
+#include "mem/cache/mshr_queue.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+// Entries are ready at the current tick
+GTestTickHandler tickHandler;
+
+/**
+ * Runs the same operations on a queue that scans its entries and on one
+ * that looks them up by address, so that their lookups can be compared.
+ */
+class MSHRQueueLookupTest : public ::testing::Test
+{
+  protected:
+    static constexpr unsigned blkSize = 64;
+    static constexpr int numEntries = 16;
+
+    MSHRQueue linear{"linear", numEntries, 0, 0, "linear", false};
+    MSHRQueue hashed{"hashed", numEntries, 0, 0, "hashed", true};
+
+    /** Holds a single entry at a time, to look for pending entries. */
+    MSHRQueue probes{"probes", 1, 0, 0, "probes", false};
+
+    /** The allocated entries, as a pair of linear and hashed entries. */
+    std::vector<std::pair<MSHR *, MSHR *>> live;
+
+    std::vector<std::unique_ptr<Packet>> packets;
+    Counter order = 0;
+
+    PacketPtr
+    makePacket(Addr blk_addr, Request::FlagsType flags)
+    {
+        packets.emplace_back(new Packet(
+            makeRequestPtr(blk_addr, blkSize, flags, 0), MemCmd::ReadReq));
+        return packets.back().get();
+    }
+
+    void
+    allocate(Addr blk_addr, Request::FlagsType flags)
+    {
+        order++;
+        live.emplace_back(
+            linear.allocate(blk_addr, blkSize, makePacket(blk_addr, flags),
+                            curTick(), order, true),
+            hashed.allocate(blk_addr, blkSize, makePacket(blk_addr, flags),
+                            curTick(), order, true));
+    }
+
+    static void
+    release(MSHRQueue &queue, MSHR *mshr)
+    {
+        while (mshr->hasTargets()) {
+            mshr->popTarget();
+        }
+        queue.deallocate(mshr);
+    }
+
+    /** Check that both entries are either missing or the same one. */
+    static void
+    expectSame(const MSHR *expected, const MSHR *actual)
+    {
+        if (expected) {
+            ASSERT_NE(actual, nullptr);
+            EXPECT_EQ(expected->order, actual->order);
+        } else {
+            EXPECT_EQ(actual, nullptr);
+        }
+    }
+
+    /** Compare every lookup the queues offer, for every block. */
+    void
+    checkLookups(const std::vector<Addr> &blocks)
+    {
+        for (Addr blk_addr : blocks) {
+            for (bool is_secure : {false, true}) {
+                SCOPED_TRACE(blk_addr);
+                SCOPED_TRACE(is_secure);
+                expectSame(linear.findMatch(blk_addr, is_secure),
+                           hashed.findMatch(blk_addr, is_secure));
+                expectSame(linear.findMatch(blk_addr, is_secure, false),
+                           hashed.findMatch(blk_addr, is_secure, false));
+
+                MSHR *probe = probes.allocate(blk_addr, blkSize,
+                    makePacket(blk_addr, is_secure ? Request::SECURE : 0),
+                    curTick(), 0, true);
+                expectSame(linear.findPending(probe),
+                           hashed.findPending(probe));
+                release(probes, probe);
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * Allocate, service, retry, reorder and release entries in a random but
+ * repeatable order, and make sure that both lookup modes always agree.
+ */
+TEST_F(MSHRQueueLookupTest, SameEntries)
+{
+    // Few blocks, so that entries share addresses and buckets
+    std::vector<Addr> blocks;
+    for (Addr blk = 0; blk < 6; blk++) {
+        blocks.push_back(blk * blkSize);
+        blocks.push_back(blk * blkSize + 0x100000);
+    }
+
+    std::mt19937 rng(0x5eed);
+    for (int step = 0; step < 4000; step++) {
+        SCOPED_TRACE(step);
+        const unsigned op = rng() % 5;
+        if (op <= 1 && !linear.isFull()) {
+            const Addr blk_addr = blocks[rng() % blocks.size()];
+            Request::FlagsType flags = 0;
+            if (rng() % 2) {
+                flags |= Request::SECURE;
+            }
+            if (rng() % 4 == 0) {
+                flags |= Request::UNCACHEABLE;
+            }
+            allocate(blk_addr, flags);
+        } else if (!live.empty()) {
+            const std::size_t pos = rng() % live.size();
+            auto [linear_mshr, hashed_mshr] = live[pos];
+            ASSERT_EQ(linear_mshr->inService, hashed_mshr->inService);
+            if (op == 2) {
+                if (linear_mshr->inService) {
+                    linear.markPending(linear_mshr);
+                    hashed.markPending(hashed_mshr);
+                } else {
+                    linear.markInService(linear_mshr, false);
+                    hashed.markInService(hashed_mshr, false);
+                }
+            } else if (op == 3) {
+                linear.moveToFront(linear_mshr);
+                hashed.moveToFront(hashed_mshr);
+            } else {
+                release(linear, linear_mshr);
+                release(hashed, hashed_mshr);
+                live.erase(live.begin() + pos);
+            }
+        }
+        checkLookups(blocks);
+        if (HasFailure()) {
+            return;
+        }
+    }
+}
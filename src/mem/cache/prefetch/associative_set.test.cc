@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "mem/cache/prefetch/associative_set_impl.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "params/LRURP.hh"
+#include "params/SetAssociative.hh"
+#include "sim/cur_tick.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Number of entries of the tables. */
+constexpr int numEntries = 16;
+
+/** Associativity of the tables. */
+constexpr int assoc = 4;
+
+std::unique_ptr<SetAssociative>
+makeIndexingPolicy(const std::string &name)
+{
+    SetAssociativeParams params;
+    params.name = name;
+    params.eventq_index = 0;
+    params.size = numEntries;
+    params.entry_size = 1;
+    params.assoc = assoc;
+    return std::make_unique<SetAssociative>(params);
+}
+
+/**
+ * Two tables sharing a replacement policy, like the per-context tables of
+ * the stride prefetcher do. Each table has its own indexing policy, which
+ * keeps track of the entries of its sets.
+ */
+class AssociativeSetTest : public ::testing::Test
+{
+  protected:
+    std::unique_ptr<SetAssociative> firstIndexing;
+    std::unique_ptr<SetAssociative> secondIndexing;
+    std::unique_ptr<replacement_policy::LRU> lru;
+
+    void
+    SetUp() override
+    {
+        curEventQueue(getEventQueue(0));
+        curEventQueue()->setCurTick(1);
+
+        firstIndexing = makeIndexingPolicy("first_indexing_policy");
+        secondIndexing = makeIndexingPolicy("second_indexing_policy");
+
+        LRURPParams params;
+        params.name = "lru";
+        params.eventq_index = 0;
+        lru = std::make_unique<replacement_policy::LRU>(params);
+    }
+
+    /** Insert addr in a victim of its set, at the given tick. */
+    static TaggedEntry *
+    insertAt(AssociativeSet<TaggedEntry> &table, Addr addr, Tick when)
+    {
+        curEventQueue()->setCurTick(when);
+        TaggedEntry *entry = table.findVictim(addr);
+        table.insertEntry(addr, false, entry);
+        return entry;
+    }
+};
+
+} // anonymous namespace
+
+/** A second table can be built on a policy that already has a table. */
+TEST_F(AssociativeSetTest, SharedPolicy)
+{
+    AssociativeSet<TaggedEntry> first(assoc, numEntries,
+        firstIndexing.get(), lru.get());
+    AssociativeSet<TaggedEntry> second(assoc, numEntries,
+        secondIndexing.get(), lru.get());
+
+    // Every entry has replacement data of its own
+    for (auto &first_entry : first) {
+        ASSERT_NE(first_entry.replacementData, nullptr);
+        for (auto &second_entry : second) {
+            EXPECT_NE(first_entry.replacementData,
+                      second_entry.replacementData);
+        }
+    }
+}
+
+/** Tables sharing a policy keep separate replacement state. */
+TEST_F(AssociativeSetTest, SeparateReplacementState)
+{
+    AssociativeSet<TaggedEntry> first(assoc, numEntries,
+        firstIndexing.get(), lru.get());
+    AssociativeSet<TaggedEntry> second(assoc, numEntries,
+        secondIndexing.get(), lru.get());
+
+    // Fill set 0 of both tables, in opposite orders, and touch the
+    // oldest entry of the second table
+    const Addr addrs[assoc] = {0x0, 0x4, 0x8, 0xc};
+    for (int i = 0; i < assoc; i++) {
+        insertAt(first, addrs[i], 10 + i);
+        insertAt(second, addrs[assoc - 1 - i], 10 + i);
+    }
+    curEventQueue()->setCurTick(20);
+    second.accessEntry(second.findEntry(addrs[assoc - 1], false));
+
+    for (int i = 0; i < assoc; i++) {
+        EXPECT_NE(first.findEntry(addrs[i], false), nullptr);
+        EXPECT_NE(second.findEntry(addrs[i], false), nullptr);
+    }
+
+    // The first table evicts its oldest insertion, and the second the
+    // oldest it has not touched since
+    TaggedEntry *first_victim = insertAt(first, 0x10, 30);
+    EXPECT_EQ(first.findEntry(addrs[0], false), nullptr);
+    EXPECT_EQ(first.findEntry(0x10, false), first_victim);
+
+    TaggedEntry *second_victim = insertAt(second, 0x10, 30);
+    EXPECT_EQ(second.findEntry(addrs[2], false), nullptr);
+    EXPECT_NE(second.findEntry(addrs[assoc - 1], false), nullptr);
+    EXPECT_EQ(second.findEntry(0x10, false), second_victim);
+}
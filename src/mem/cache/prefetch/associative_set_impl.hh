@@ -49,7 +49,8 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
     for (unsigned int entry_idx = 0; entry_idx < numEntries; entry_idx += 1) {
         Entry* entry = &entries[entry_idx];
         indexingPolicy->setEntry(entry, entry_idx);
-        entry->replacementData = replacementPolicy->instantiateEntry();
+        entry->replacementData = replacementPolicy->instantiateSetEntry(
+            entry->getSet(), entry->getWay(), associativity);
     }
 }
 
@@ -58,7 +59,7 @@ Entry*
 AssociativeSet<Entry>::findEntry(Addr addr, bool is_secure) const
 {
     Addr tag = indexingPolicy->extractTag(addr);
-    const std::vector<ReplaceableEntry*> selected_entries =
+    const ReplacementCandidates selected_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     for (const auto& location : selected_entries) {
@@ -83,7 +84,7 @@ Entry*
 AssociativeSet<Entry>::findVictim(Addr addr)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> selected_entries =
+    const ReplacementCandidates selected_entries =
         indexingPolicy->getPossibleEntries(addr);
     Entry* victim = static_cast<Entry*>(replacementPolicy->getVictim(
                             selected_entries));
@@ -97,7 +98,7 @@ template<class Entry>
 std::vector<Entry *>
 AssociativeSet<Entry>::getPossibleEntries(const Addr addr) const
 {
-    std::vector<ReplaceableEntry *> selected_entries =
+    const ReplacementCandidates selected_entries =
         indexingPolicy->getPossibleEntries(addr);
     std::vector<Entry *> entries(selected_entries.size(), nullptr);
 
@@ -37,9 +37,11 @@
 
 #include "mem/cache/prefetch/queued.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "arch/generic/tlb.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/HWPrefetch.hh"
@@ -54,26 +56,25 @@ namespace gem5
 namespace prefetch
 {
 
-void
-Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
-                                            RequestorID requestor_id,
-                                            bool tag_prefetch,
-                                            Tick t) {
+PacketPtr
+Queued::DeferredPacket::createPkt(unsigned blk_size, RequestorID requestor_id,
+                                  bool tag_prefetch) const
+{
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
-                                                0, requestor_id);
+    RequestPtr req = makeRequestPtr(paddr, blk_size,
+                                    0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
     }
     req->taskId(context_switch_task_id::Prefetcher);
-    pkt = new Packet(req, MemCmd::HardPFReq);
+    PacketPtr pkt = new Packet(req, MemCmd::HardPFReq);
     pkt->allocate();
     if (tag_prefetch && pfInfo.hasPC()) {
         // Tag prefetch packet with  accessing pc
         pkt->req->setPC(pfInfo.getPC());
     }
-    tick = t;
+    return pkt;
 }
 
 void
@@ -97,44 +98,193 @@ Queued::DeferredPacket::finish(const Fault &fault,
     owner->translationComplete(this, failed, *cache);
 }
 
-Queued::Queued(const QueuedPrefetcherParams &p)
-    : Base(p), queueSize(p.queue_size),
-      missingTranslationQueueSize(
-        p.max_prefetch_requests_with_pending_translation),
-      latency(p.latency), queueSquash(p.queue_squash),
-      queueFilter(p.queue_filter), cacheSnoop(p.cache_snoop),
-      tagPrefetch(p.tag_prefetch),
-      throttleControlPct(p.throttle_control_percentage), statsQueued(this)
+Queued::DeferredQueue::DeferredQueue(const std::string &name,
+                                     std::size_t capacity)
+    : _name(name), capacity(capacity), slots(capacity), order(capacity),
+      head(0), count(0),
+      // Keep the load factor at or below one half
+      bucketMask((uint64_t(1) << ceilLog2(std::max<std::size_t>(
+          2 * capacity, 1))) - 1),
+      bucketHead(bucketMask + 1, -1), hashNext(capacity, -1),
+      hashPrev(capacity, -1)
+{
+    // The order ring and the slots are indexed modulo the capacity
+    fatal_if(capacity == 0, "%s: A prefetch queue needs room for at least "
+             "one prefetch.\n", name);
+
+    // Hand out the lowest slots first
+    freeSlots.reserve(capacity);
+    for (int slot = capacity - 1; slot >= 0; slot--) {
+        freeSlots.push_back(slot);
+    }
+}
+
+std::size_t
+Queued::DeferredQueue::positionOf(const DeferredPacket &dp) const
+{
+    // Only the packets with the same priority need to be searched
+    std::size_t pos = partitionPoint([&dp](const DeferredPacket &other)
+        { return other.priority > dp.priority; });
+    while (slotAt(pos) != dp.slot) {
+        pos++;
+        assert(pos < count);
+    }
+    return pos;
+}
+
+void
+Queued::DeferredQueue::insertAt(std::size_t pos, int slot)
 {
+    assert(count < capacity && pos <= count);
+    for (std::size_t i = count; i > pos; i--) {
+        order[(head + i) % capacity] = order[(head + i - 1) % capacity];
+    }
+    order[(head + pos) % capacity] = slot;
+    count++;
+}
+
+void
+Queued::DeferredQueue::removeAt(std::size_t pos)
+{
+    assert(pos < count);
+    if (pos == 0) {
+        head = (head + 1) % capacity;
+    } else {
+        for (std::size_t i = pos; i + 1 < count; i++) {
+            order[(head + i) % capacity] = order[(head + i + 1) % capacity];
+        }
+    }
+    count--;
+}
+
+void
+Queued::DeferredQueue::insertByPriority(int slot)
+{
+    const int32_t priority = slots[slot]->priority;
+    insertAt(partitionPoint([priority](const DeferredPacket &other)
+        { return other.priority >= priority; }), slot);
 }
 
-Queued::~Queued()
+void
+Queued::DeferredQueue::release(DeferredPacket &dp)
 {
-    // Delete the queued prefetch packets
-    for (DeferredPacket &p : pfq) {
-        delete p.pkt;
+    const int slot = dp.slot;
+    const int next = hashNext[slot];
+    const int prev = hashPrev[slot];
+    if (prev >= 0) {
+        hashNext[prev] = next;
+    } else {
+        bucketHead[bucketOf(dp.pfInfo.getAddr())] = next;
+    }
+    if (next >= 0) {
+        hashPrev[next] = prev;
     }
+
+    slots[slot].reset();
+    freeSlots.push_back(slot);
 }
 
 void
-Queued::printQueue(const std::list<DeferredPacket> &queue) const
+Queued::DeferredQueue::popFront()
 {
-    int pos = 0;
-    std::string queue_name = "";
-    if (&queue == &pfq) {
-        queue_name = "PFQ";
+    assert(count > 0);
+    DeferredPacket &dp = front();
+    removeAt(0);
+    release(dp);
+}
+
+Queued::DeferredPacket &
+Queued::DeferredQueue::insert(const DeferredPacket &dp)
+{
+    assert(!freeSlots.empty());
+    const int slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    DeferredPacket &queued_dp = slots[slot].emplace(dp);
+    queued_dp.slot = slot;
+
+    // Append to the address chain, so that it keeps insertion order
+    const std::size_t bucket = bucketOf(queued_dp.pfInfo.getAddr());
+    int tail = bucketHead[bucket];
+    hashNext[slot] = -1;
+    if (tail < 0) {
+        hashPrev[slot] = -1;
+        bucketHead[bucket] = slot;
     } else {
-        assert(&queue == &pfqMissingTranslation);
-        queue_name = "PFTransQ";
+        while (hashNext[tail] >= 0) {
+            tail = hashNext[tail];
+        }
+        hashNext[tail] = slot;
+        hashPrev[slot] = tail;
     }
 
-    for (const_iterator it = queue.cbegin(); it != queue.cend();
-                                                            it++, pos++) {
-        Addr vaddr = it->pfInfo.getAddr();
-        /* Set paddr to 0 if not yet translated */
-        Addr paddr = it->pkt ? it->pkt->getAddr() : 0;
+    insertByPriority(slot);
+    return queued_dp;
+}
+
+void
+Queued::DeferredQueue::erase(DeferredPacket &dp)
+{
+    assert(&*slots[dp.slot] == &dp);
+    removeAt(positionOf(dp));
+    release(dp);
+}
+
+Queued::DeferredPacket *
+Queued::DeferredQueue::find(Addr addr, bool is_secure)
+{
+    for (int slot = bucketHead[bucketOf(addr)]; slot >= 0;
+         slot = hashNext[slot]) {
+        DeferredPacket &dp = *slots[slot];
+        if (dp.pfInfo.getAddr() == addr && dp.pfInfo.isSecure() == is_secure) {
+            return &dp;
+        }
+    }
+    return nullptr;
+}
+
+void
+Queued::DeferredQueue::raisePriority(DeferredPacket &dp, int32_t priority)
+{
+    assert(priority > dp.priority);
+    removeAt(positionOf(dp));
+    dp.priority = priority;
+    insertByPriority(dp.slot);
+}
+
+Queued::DeferredPacket &
+Queued::DeferredQueue::victim()
+{
+    assert(count > 0);
+    const int32_t lowest = at(count - 1).priority;
+    return at(partitionPoint([lowest](const DeferredPacket &other)
+        { return other.priority > lowest; }));
+}
+
+Queued::Queued(const QueuedPrefetcherParams &p)
+    : Base(p), pfq("PFQ", p.queue_size),
+      pfqMissingTranslation("PFTransQ",
+        p.max_prefetch_requests_with_pending_translation),
+      queueSize(p.queue_size),
+      missingTranslationQueueSize(
+        p.max_prefetch_requests_with_pending_translation),
+      latency(p.latency), queueSquash(p.queue_squash),
+      queueFilter(p.queue_filter), cacheSnoop(p.cache_snoop),
+      tagPrefetch(p.tag_prefetch),
+      throttleControlPct(p.throttle_control_percentage), statsQueued(this)
+{
+}
+
+void
+Queued::printQueue(const DeferredQueue &queue) const
+{
+    for (std::size_t pos = 0; pos < queue.size(); pos++) {
+        const DeferredPacket &dp = queue.at(pos);
+        Addr vaddr = dp.pfInfo.getAddr();
+        /* paddr is 0 if not yet translated */
         DPRINTF(HWPrefetchQueue, "%s[%d]: Prefetch Req VA: %#x PA: %#x "
-                "prio: %3d\n", queue_name, pos, vaddr, paddr, it->priority);
+                "prio: %3d\n", queue.name(), pos, vaddr, dp.paddr,
+                dp.priority);
     }
 }
 
@@ -178,20 +328,13 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
 
     // Squash queued prefetches if demand miss to same line
     if (queueSquash) {
-        auto itr = pfq.begin();
-        while (itr != pfq.end()) {
-            if (itr->pfInfo.getAddr() == blk_addr &&
-                itr->pfInfo.isSecure() == is_secure) {
-                DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
-                        "(cl: %#x), demand request going to the same addr\n",
-                        itr->pfInfo.getAddr(),
-                        blockAddress(itr->pfInfo.getAddr()));
-                delete itr->pkt;
-                itr = pfq.erase(itr);
-                statsQueued.pfRemovedDemand++;
-            } else {
-                ++itr;
-            }
+        while (DeferredPacket *dp = pfq.find(blk_addr, is_secure)) {
+            DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
+                    "(cl: %#x), demand request going to the same addr\n",
+                    dp->pfInfo.getAddr(),
+                    blockAddress(dp->pfInfo.getAddr()));
+            pfq.erase(*dp);
+            statsQueued.pfRemovedDemand++;
         }
     }
 
@@ -251,8 +394,8 @@ Queued::getPacket()
         return nullptr;
     }
 
-    PacketPtr pkt = pfq.front().pkt;
-    pfq.pop_front();
+    PacketPtr pkt = pfq.front().createPkt(blkSize, requestorId, tagPrefetch);
+    pfq.popFront();
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
@@ -288,13 +431,16 @@ void
 Queued::processMissingTranslations(unsigned max)
 {
     unsigned count = 0;
-    iterator it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end() && count < max) {
-        DeferredPacket &dp = *it;
-        // Increase the iterator first because dp.startTranslation can end up
-        // calling finishTranslation, which will erase "it"
-        it++;
-        dp.startTranslation(mmu);
+    std::size_t pos = 0;
+    while (pos < pfqMissingTranslation.size() && count < max) {
+        const std::size_t size = pfqMissingTranslation.size();
+        pfqMissingTranslation.at(pos).startTranslation(mmu);
+        // dp.startTranslation can end up calling finishTranslation, which
+        // removes the packet from the queue, so that the next one takes
+        // its position
+        if (pfqMissingTranslation.size() == size) {
+            pos++;
+        }
         count += 1;
     }
 }
@@ -303,66 +449,44 @@ void
 Queued::translationComplete(DeferredPacket *dp, bool failed,
                             const CacheAccessor &cache)
 {
-    auto it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end()) {
-        if (&(*it) == dp) {
-            break;
-        }
-        it++;
-    }
-    assert(it != pfqMissingTranslation.end());
     if (!failed) {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x succeeded: "
                 "paddr %#x \n", mmu->name(),
-                it->translationRequest->getVaddr(),
-                it->translationRequest->getPaddr());
-        Addr target_paddr = it->translationRequest->getPaddr();
+                dp->translationRequest->getVaddr(),
+                dp->translationRequest->getPaddr());
+        Addr target_paddr = dp->translationRequest->getPaddr();
         // check if this prefetch is already redundant
         if (cacheSnoop &&
-                (cache.inCache(target_paddr, it->pfInfo.isSecure()) ||
-                 cache.inMissQueue(target_paddr, it->pfInfo.isSecure()))) {
+                (cache.inCache(target_paddr, dp->pfInfo.isSecure()) ||
+                 cache.inMissQueue(target_paddr, dp->pfInfo.isSecure()))) {
             statsQueued.pfInCache++;
             DPRINTF(HWPrefetch, "Dropping redundant in "
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
         } else {
             Tick pf_time = curTick() + clockPeriod() * latency;
-            it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                          pf_time);
-            addToQueue(pfq, *it);
+            dp->setTarget(target_paddr, pf_time);
+            addToQueue(pfq, *dp);
         }
     } else {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x failed, dropping "
                 "prefetch request %#x \n", mmu->name(),
-                it->translationRequest->getVaddr());
+                dp->translationRequest->getVaddr());
     }
-    pfqMissingTranslation.erase(it);
+    pfqMissingTranslation.erase(*dp);
 }
 
 bool
-Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
+Queued::alreadyInQueue(DeferredQueue &queue,
                                  const PrefetchInfo &pfi, int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
-    }
+    DeferredPacket *dp = queue.find(pfi.getAddr(), pfi.isSecure());
 
     /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
+    if (dp) {
         statsQueued.pfBufferHit++;
-        if (it->priority < priority) {
+        if (dp->priority < priority) {
             /* Update priority value and position in the queue */
-            it->priority = priority;
-            iterator prev = it;
-            while (prev != queue.begin()) {
-                prev--;
-                /* If the packet has higher priority, swap */
-                if (*it > *prev) {
-                    std::swap(*it, *prev);
-                    it = prev;
-                }
-            }
+            queue.raisePriority(*dp, priority);
             DPRINTF(HWPrefetch, "Prefetch addr already in "
                 "prefetch queue, priority updated\n");
         } else {
@@ -370,14 +494,14 @@ Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
                 "prefetch queue\n");
         }
     }
-    return found;
+    return dp != nullptr;
 }
 
 RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = makeRequestPtr(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -467,8 +591,7 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
     DeferredPacket dpp(this, new_pfi, 0, priority, cache);
     if (has_target_pa) {
         Tick pf_time = curTick() + clockPeriod() * latency;
-        dpp.createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                      pf_time);
+        dpp.setTarget(target_paddr, pf_time);
         DPRINTF(HWPrefetch, "Prefetch queued. "
                 "addr:%#x priority: %3d tick:%lld.\n",
                 new_pfi.getAddr(), priority, pf_time);
@@ -484,50 +607,21 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
 }
 
 void
-Queued::addToQueue(std::list<DeferredPacket> &queue,
-                             DeferredPacket &dpp)
+Queued::addToQueue(DeferredQueue &queue, const DeferredPacket &dpp)
 {
     /* Verify prefetch buffer space for request */
-    if (queue.size() == queueSize) {
+    if (queue.full()) {
         statsQueued.pfRemovedFull++;
-        /* Lowest priority packet */
-        iterator it = queue.end();
-        panic_if (it == queue.begin(),
-            "Prefetch queue is both full and empty!");
-        --it;
-        /* Look for oldest in that level of priority */
-        panic_if (it == queue.begin(),
-            "Prefetch queue is full with 1 element!");
-        iterator prev = it;
-        bool cont = true;
-        /* While not at the head of the queue */
-        while (cont && prev != queue.begin()) {
-            prev--;
-            /* While at the same level of priority */
-            cont = prev->priority == it->priority;
-            if (cont)
-                /* update pointer */
-                it = prev;
-        }
+        panic_if(queue.empty(), "Prefetch queue is both full and empty!");
+        /* Lowest priority, oldest packet */
+        DeferredPacket &victim = queue.victim();
         DPRINTF(HWPrefetch, "Prefetch queue full, removing lowest priority "
-                            "oldest packet, addr: %#x\n",it->pfInfo.getAddr());
-        delete it->pkt;
-        queue.erase(it);
+                            "oldest packet, addr: %#x\n",
+                            victim.pfInfo.getAddr());
+        queue.erase(victim);
     }
 
-    if ((queue.size() == 0) || (dpp <= queue.back())) {
-        queue.emplace_back(dpp);
-    } else {
-        iterator it = queue.end();
-        do {
-            --it;
-        } while (it != queue.begin() && dpp > *it);
-        /* If we reach the head, we have to see if the new element is new head
-         * or not */
-        if (it == queue.begin() && dpp <= *it)
-            it++;
-        queue.insert(it, dpp);
-    }
+    queue.insert(dpp);
 
     if (debug::HWPrefetchQueue)
         printQueue(queue);
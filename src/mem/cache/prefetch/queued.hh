@@ -39,8 +39,10 @@
 #define __MEM_CACHE_PREFETCH_QUEUED_HH__
 
 #include <cstdint>
-#include <list>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "arch/generic/mmu.hh"
 #include "base/statistics.hh"
@@ -67,8 +69,8 @@ class Queued : public Base
         PrefetchInfo pfInfo;
         /** Time when this prefetch becomes ready */
         Tick tick;
-        /** The memory packet generated by this prefetch */
-        PacketPtr pkt;
+        /** Physical address to prefetch, 0 while not yet translated */
+        Addr paddr;
         /** The priority of this prefetch */
         int32_t priority;
         /** Request used when a translation is needed */
@@ -76,20 +78,21 @@ class Queued : public Base
         ThreadContext *tc;
         bool ongoingTranslation;
         const CacheAccessor *cache;
+        /** Slot of the queue holding this prefetch */
+        int slot;
 
         /**
          * Constructor
          * @param o QueuedPrefetcher in charge of this request
          * @param pfi PrefechInfo object associated to this packet
          * @param t Time when this prefetch becomes ready
-         * @param p PacketPtr with the memory request of the prefetch
          * @param prio This prefetch priority
          */
         DeferredPacket(Queued *o, PrefetchInfo const &pfi, Tick t,
             int32_t prio, const CacheAccessor &_cache)
-            : owner(o), pfInfo(pfi), tick(t), pkt(nullptr),
+            : owner(o), pfInfo(pfi), tick(t), paddr(0),
             priority(prio), translationRequest(), tc(nullptr),
-            ongoingTranslation(false), cache(&_cache) {
+            ongoingTranslation(false), cache(&_cache), slot(-1) {
         }
 
         bool operator>(const DeferredPacket& that) const
@@ -105,18 +108,31 @@ class Queued : public Base
             return !(*this > that);
         }
 
+        /**
+         * Set the physical address to prefetch. The memory packet is only
+         * created when the prefetch is issued, so that prefetches that are
+         * squashed or dropped from a full queue never allocate one.
+         * @param _paddr physical address of this prefetch
+         * @param t time when the prefetch becomes ready
+         */
+        void
+        setTarget(Addr _paddr, Tick t)
+        {
+            paddr = _paddr;
+            tick = t;
+        }
+
         /**
          * Create the associated memory packet
-         * @param paddr physical address of this packet
          * @param blk_size block size used by the prefetcher
          * @param requestor_id Requestor ID of the access that generated
          * this prefetch
          * @param tag_prefetch flag to indicate if the packet needs to be
          *        tagged
-         * @param t time when the prefetch becomes ready
+         * @return The new memory packet
          */
-        void createPkt(Addr paddr, unsigned blk_size, RequestorID requestor_id,
-                       bool tag_prefetch, Tick t);
+        PacketPtr createPkt(unsigned blk_size, RequestorID requestor_id,
+                            bool tag_prefetch) const;
 
         /**
          * Sets the translation request needed to obtain the physical address
@@ -141,11 +157,175 @@ class Queued : public Base
         void startTranslation(BaseMMU *mmu);
     };
 
-    std::list<DeferredPacket> pfq;
-    std::list<DeferredPacket> pfqMissingTranslation;
+    /**
+     * A bounded queue of deferred packets, kept in decreasing priority
+     * order, and in insertion order among equal priorities. The packets
+     * live in a fixed set of slots that never move, so that they can be
+     * handed to the MMU while being translated, and the order is a ring of
+     * slot indices, so that issuing the head is constant time and
+     * inserting only moves indices. Slots are also chained in an address
+     * hash, so that duplicates and squashed prefetches are found without
+     * walking the queue.
+     */
+    class DeferredQueue
+    {
+      private:
+        /** Name used when printing the queue. */
+        const std::string _name;
+
+        /** Maximum number of packets in the queue. */
+        const std::size_t capacity;
+
+        /** Packet storage, indexed by slot. */
+        std::vector<std::optional<DeferredPacket>> slots;
+
+        /** Slots not holding a packet. */
+        std::vector<int> freeSlots;
+
+        /** Ring of occupied slots, in priority order. */
+        std::vector<int> order;
+
+        /** Position of the first packet in the ring. */
+        std::size_t head;
+
+        /** Number of packets in the queue. */
+        std::size_t count;
+
+        /** Mask selecting a bucket from an address hash. */
+        const uint64_t bucketMask;
+
+        /** First slot of each bucket's chain, or -1. */
+        std::vector<int> bucketHead;
+
+        /** Next and previous slots in the chain, indexed by slot, or -1. */
+        std::vector<int> hashNext;
+        std::vector<int> hashPrev;
+
+        /** Get the bucket of a prefetch address. */
+        std::size_t
+        bucketOf(Addr addr) const
+        {
+            // Fibonacci hashing, using the well mixed upper bits
+            return ((addr * 0x9E3779B97F4A7C15ULL) >> 32) & bucketMask;
+        }
+
+        /** Get the slot at a position of the priority order. */
+        int
+        slotAt(std::size_t pos) const
+        {
+            return order[(head + pos) % capacity];
+        }
+
+        /**
+         * Find the first position of the priority order for which a
+         * predicate on its packet is false. The predicate must be true for
+         * a (possibly empty) prefix of the order, and false afterwards.
+         */
+        template <class Pred>
+        std::size_t
+        partitionPoint(Pred pred) const
+        {
+            std::size_t low = 0;
+            std::size_t high = count;
+            while (low < high) {
+                const std::size_t mid = (low + high) / 2;
+                if (pred(*slots[slotAt(mid)])) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            return low;
+        }
+
+        /** Find the position of a packet in the priority order. */
+        std::size_t positionOf(const DeferredPacket &dp) const;
+
+        /** Insert a slot at a position of the priority order. */
+        void insertAt(std::size_t pos, int slot);
+
+        /** Remove the slot at a position of the priority order. */
+        void removeAt(std::size_t pos);
+
+        /**
+         * Insert a slot in the priority order, after all packets with the
+         * same or a higher priority.
+         */
+        void insertByPriority(int slot);
+
+        /** Release the slot of a packet that left the queue. */
+        void release(DeferredPacket &dp);
+
+      public:
+        /**
+         * @param name Name used when printing the queue
+         * @param capacity Maximum number of packets in the queue, which
+         *        must be at least one
+         */
+        DeferredQueue(const std::string &name, std::size_t capacity);
+
+        const std::string &name() const { return _name; }
+
+        bool empty() const { return count == 0; }
+        std::size_t size() const { return count; }
+        bool full() const { return count == capacity; }
+
+        /**
+         * Get the packet at a position of the priority order.
+         * @param pos Position, where 0 is the head of the queue
+         */
+        DeferredPacket &at(std::size_t pos) { return *slots[slotAt(pos)]; }
+        const DeferredPacket &
+        at(std::size_t pos) const
+        {
+            return *slots[slotAt(pos)];
+        }
+
+        DeferredPacket &front() { return at(0); }
+        const DeferredPacket &front() const { return at(0); }
+
+        /** Remove the head of the queue. */
+        void popFront();
+
+        /**
+         * Add a copy of a packet in its priority order. The queue must not
+         * be full.
+         * @param dp The packet to add
+         * @return The queued packet
+         */
+        DeferredPacket &insert(const DeferredPacket &dp);
+
+        /**
+         * Remove a packet from the queue.
+         * @param dp A packet held by this queue
+         */
+        void erase(DeferredPacket &dp);
+
+        /**
+         * Find the oldest packet prefetching an address.
+         * @param addr The block address of the prefetch
+         * @param is_secure Whether the prefetch is to the secure space
+         * @return The packet, or nullptr if there is none
+         */
+        DeferredPacket *find(Addr addr, bool is_secure);
+
+        /**
+         * Raise the priority of a packet, moving it after all packets
+         * with the same or a higher priority.
+         * @param dp A packet held by this queue
+         * @param priority The new, higher, priority
+         */
+        void raisePriority(DeferredPacket &dp, int32_t priority);
+
+        /**
+         * Get the packet to drop when the queue is full: the oldest of
+         * the packets with the lowest priority.
+         */
+        DeferredPacket &victim();
+    };
 
-    using const_iterator = std::list<DeferredPacket>::const_iterator;
-    using iterator = std::list<DeferredPacket>::iterator;
+    DeferredQueue pfq;
+    DeferredQueue pfqMissingTranslation;
 
     // PARAMETERS
 
@@ -192,7 +372,7 @@ class Queued : public Base
     using AddrPriority = std::pair<Addr, int32_t>;
 
     Queued(const QueuedPrefetcherParams &p);
-    virtual ~Queued();
+    virtual ~Queued() = default;
 
     void
     notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi) override;
@@ -210,7 +390,7 @@ class Queued : public Base
         return pfq.empty() ? MaxTick : pfq.front().tick;
     }
 
-    void printQueue(const std::list<DeferredPacket> &queue) const;
+    void printQueue(const DeferredQueue &queue) const;
 
   private:
 
@@ -219,7 +399,7 @@ class Queued : public Base
      * @param queue selected queue to use
      * @param dpp DeferredPacket to add
      */
-    void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
+    void addToQueue(DeferredQueue &queue, const DeferredPacket &dpp);
 
     /**
      * Starts the translations of the queued prefetches with a
@@ -249,7 +429,7 @@ class Queued : public Base
      * @param priority priority of the prefetch request to be added
      * @return True if the prefetch request was found in the queue
      */
-    bool alreadyInQueue(std::list<DeferredPacket> &queue,
+    bool alreadyInQueue(DeferredQueue &queue,
                         const PrefetchInfo &pfi, int32_t priority);
 
     /**
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/cache/cache_probe_arg.hh"
+#include "mem/cache/prefetch/queued.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+// Requests are timestamped with the current tick
+GTestTickHandler tickHandler;
+
+/** Gives access to the queue types, which only Queued may use. */
+struct QueuedAccess : prefetch::Queued
+{
+    using Queued::DeferredPacket;
+    using Queued::DeferredQueue;
+};
+
+using DeferredPacket = QueuedAccess::DeferredPacket;
+using DeferredQueue = QueuedAccess::DeferredQueue;
+
+/** A cache that holds nothing, for packets that never look it up. */
+struct NoCacheAccessor : CacheAccessor
+{
+    bool inCache(Addr addr, bool is_secure) const override { return false; }
+
+    bool
+    hasBeenPrefetched(Addr addr, bool is_secure) const override
+    {
+        return false;
+    }
+
+    bool
+    hasBeenPrefetched(Addr addr, bool is_secure,
+        RequestorID requestor) const override
+    {
+        return false;
+    }
+
+    bool
+    inMissQueue(Addr addr, bool is_secure) const override
+    {
+        return false;
+    }
+
+    bool coalesce() const override { return false; }
+};
+
+class DeferredQueueTest : public ::testing::Test
+{
+  protected:
+    NoCacheAccessor cache;
+
+    /** Read misses, whose prefetch info carries no data. */
+    Packet pkt{makeRequestPtr(0, 64, 0, 0), MemCmd::ReadReq};
+    Packet securePkt{makeRequestPtr(0, 64, Request::SECURE, 0),
+                     MemCmd::ReadReq};
+
+    /** Make a prefetch of a block, with a priority. */
+    DeferredPacket
+    prefetch(Addr addr, int32_t priority, bool is_secure = false)
+    {
+        prefetch::Base::PrefetchInfo pfi(is_secure ? &securePkt : &pkt,
+                                         addr, true);
+        return DeferredPacket(nullptr, pfi, 0, priority, cache);
+    }
+
+    /** Get the addresses in the queue, from its head. */
+    static std::vector<Addr>
+    addresses(const DeferredQueue &queue)
+    {
+        std::vector<Addr> addrs;
+        for (std::size_t pos = 0; pos < queue.size(); pos++) {
+            addrs.push_back(queue.at(pos).pfInfo.getAddr());
+        }
+        return addrs;
+    }
+};
+
+} // anonymous namespace
+
+using DeferredQueueDeathTest = DeferredQueueTest;
+
+/** A queue without any room can not be built. */
+TEST_F(DeferredQueueDeathTest, ZeroCapacity)
+{
+    ASSERT_DEATH(DeferredQueue("PFQ", 0), "at least one prefetch");
+}
+
+/**
+ * Packets are kept by decreasing priority, and in insertion order among
+ * the same priority, also after the head is issued and the ring wraps.
+ */
+TEST_F(DeferredQueueTest, Order)
+{
+    DeferredQueue queue("PFQ", 4);
+    ASSERT_TRUE(queue.empty());
+
+    queue.insert(prefetch(0x100, 1));
+    queue.insert(prefetch(0x200, 3));
+    queue.insert(prefetch(0x300, 1));
+    queue.insert(prefetch(0x400, 2));
+    ASSERT_TRUE(queue.full());
+    ASSERT_EQ(addresses(queue),
+              std::vector<Addr>({0x200, 0x400, 0x100, 0x300}));
+
+    queue.popFront();
+    queue.popFront();
+    queue.insert(prefetch(0x500, 1));
+    queue.insert(prefetch(0x600, 5));
+    ASSERT_EQ(addresses(queue),
+              std::vector<Addr>({0x600, 0x100, 0x300, 0x500}));
+
+    // A raised packet goes after those already at its new priority
+    queue.popFront();
+    queue.insert(prefetch(0x700, 0));
+    queue.raisePriority(*queue.find(0x500, false), 5);
+    queue.raisePriority(*queue.find(0x700, false), 5);
+    ASSERT_EQ(addresses(queue),
+              std::vector<Addr>({0x500, 0x700, 0x100, 0x300}));
+
+    queue.erase(*queue.find(0x100, false));
+    ASSERT_EQ(addresses(queue), std::vector<Addr>({0x500, 0x700, 0x300}));
+    ASSERT_EQ(queue.front().priority, 5);
+}
+
+/**
+ * Lookups find the oldest packet of an address and security space, also
+ * when several addresses share a hash bucket.
+ */
+TEST_F(DeferredQueueTest, Find)
+{
+    DeferredQueue queue("PFQ", 64);
+
+    // The table has 128 buckets, so some of these share one
+    for (Addr addr = 0; addr < 48 * 0x40; addr += 0x40) {
+        queue.insert(prefetch(addr, addr % 3));
+    }
+    queue.insert(prefetch(0x40, 7));
+    queue.insert(prefetch(0x80, 0, true));
+
+    for (Addr addr = 0; addr < 48 * 0x40; addr += 0x40) {
+        DeferredPacket *dp = queue.find(addr, false);
+        ASSERT_NE(dp, nullptr);
+        ASSERT_EQ(dp->pfInfo.getAddr(), addr);
+        ASSERT_FALSE(dp->pfInfo.isSecure());
+    }
+    ASSERT_EQ(queue.find(48 * 0x40, false), nullptr);
+
+    // The duplicate is found after the original
+    ASSERT_EQ(queue.find(0x40, false)->priority, 1);
+    queue.erase(*queue.find(0x40, false));
+    ASSERT_EQ(queue.find(0x40, false)->priority, 7);
+
+    ASSERT_TRUE(queue.find(0x80, true)->pfInfo.isSecure());
+    queue.erase(*queue.find(0x80, true));
+    ASSERT_EQ(queue.find(0x80, true), nullptr);
+    ASSERT_NE(queue.find(0x80, false), nullptr);
+
+    // Removing packets unlinks them from their bucket
+    while (!queue.empty()) {
+        const Addr addr = queue.front().pfInfo.getAddr();
+        const bool is_secure = queue.front().pfInfo.isSecure();
+        queue.popFront();
+        ASSERT_EQ(queue.find(addr, is_secure), nullptr);
+    }
+}
+
+/** The victim is the oldest of the packets with the lowest priority. */
+TEST_F(DeferredQueueTest, Victim)
+{
+    DeferredQueue queue("PFQ", 5);
+
+    queue.insert(prefetch(0x100, 2));
+    ASSERT_EQ(queue.victim().pfInfo.getAddr(), 0x100);
+
+    queue.insert(prefetch(0x200, 1));
+    queue.insert(prefetch(0x300, 4));
+    queue.insert(prefetch(0x400, 1));
+    queue.insert(prefetch(0x500, 1));
+    ASSERT_EQ(queue.victim().pfInfo.getAddr(), 0x200);
+
+    queue.erase(queue.victim());
+    ASSERT_EQ(queue.victim().pfInfo.getAddr(), 0x400);
+
+    queue.raisePriority(*queue.find(0x400, false), 3);
+    queue.raisePriority(*queue.find(0x500, false), 3);
+    ASSERT_EQ(queue.victim().pfInfo.getAddr(), 0x100);
+
+    queue.erase(queue.victim());
+    ASSERT_EQ(queue.victim().pfInfo.getAddr(), 0x400);
+}
@@ -46,9 +46,12 @@
 #define __MEM_CACHE_QUEUE_HH__
 
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -122,6 +125,94 @@ class Queue : public Drainable, public Named
     /** The number of currently allocated entries. */
     int allocated;
 
+    /**
+     * Whether allocated entries are also indexed by block address. The
+     * index is a chained hash table whose chains keep allocation order, so
+     * lookups return the same entries as a scan of the allocation list.
+     */
+    const bool hashedLookup;
+
+    /** Mask selecting a bucket from an address hash. */
+    const uint64_t bucketMask;
+
+    /** First and last entry of each bucket's chain. */
+    std::vector<Entry*> bucketHead;
+    std::vector<Entry*> bucketTail;
+
+    /** Next and previous entries in the chain, indexed by entry. */
+    std::vector<Entry*> hashNext;
+    std::vector<Entry*> hashPrev;
+
+    /** Get the position of an entry in the storage. */
+    std::size_t
+    indexOf(const Entry *entry) const
+    {
+        return entry - entries.data();
+    }
+
+    /** Get the bucket a block address belongs to. */
+    std::size_t
+    bucketOf(Addr blk_addr) const
+    {
+        // Fibonacci hashing, using the well mixed upper bits
+        return ((blk_addr * 0x9E3779B97F4A7C15ULL) >> 32) & bucketMask;
+    }
+
+    /**
+     * Add a newly allocated entry to the address index. Must be called
+     * once the entry's block address is set, in allocation order.
+     *
+     * @param entry The allocated entry.
+     */
+    void
+    indexEntry(Entry *entry)
+    {
+        if (!hashedLookup) {
+            return;
+        }
+
+        const std::size_t bucket = bucketOf(entry->blkAddr);
+        const std::size_t index = indexOf(entry);
+        hashNext[index] = nullptr;
+        hashPrev[index] = bucketTail[bucket];
+        if (bucketTail[bucket]) {
+            hashNext[indexOf(bucketTail[bucket])] = entry;
+        } else {
+            bucketHead[bucket] = entry;
+        }
+        bucketTail[bucket] = entry;
+    }
+
+    /**
+     * Remove an entry from the address index.
+     *
+     * @param entry The entry being deallocated.
+     */
+    void
+    unindexEntry(Entry *entry)
+    {
+        if (!hashedLookup) {
+            return;
+        }
+
+        const std::size_t bucket = bucketOf(entry->blkAddr);
+        const std::size_t index = indexOf(entry);
+        Entry *next = hashNext[index];
+        Entry *prev = hashPrev[index];
+        if (prev) {
+            hashNext[indexOf(prev)] = next;
+        } else {
+            assert(bucketHead[bucket] == entry);
+            bucketHead[bucket] = next;
+        }
+        if (next) {
+            hashPrev[indexOf(next)] = prev;
+        } else {
+            assert(bucketTail[bucket] == entry);
+            bucketTail[bucket] = prev;
+        }
+    }
+
   public:
 
     /**
@@ -129,13 +220,21 @@ class Queue : public Drainable, public Named
      *
      * @param num_entries The number of entries in this queue.
      * @param reserve The extra overflow entries needed.
+     * @param hashed_lookup Whether entries are indexed by block address.
      */
     Queue(const std::string &_label, int num_entries, int reserve,
-            const std::string &name) :
+            const std::string &name, bool hashed_lookup = false) :
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
-        _numInService(0), allocated(0)
+        _numInService(0), allocated(0), hashedLookup(hashed_lookup),
+        // Keep the load factor at or below one half
+        bucketMask(hashed_lookup ?
+                   (uint64_t(1) << ceilLog2(2 * numEntries)) - 1 : 0),
+        bucketHead(hashed_lookup ? bucketMask + 1 : 0, nullptr),
+        bucketTail(hashed_lookup ? bucketMask + 1 : 0, nullptr),
+        hashNext(hashed_lookup ? numEntries : 0, nullptr),
+        hashPrev(hashed_lookup ? numEntries : 0, nullptr)
     {
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
@@ -168,6 +267,17 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
+        if (hashedLookup) {
+            for (Entry *entry = bucketHead[bucketOf(blk_addr)]; entry;
+                 entry = hashNext[indexOf(entry)]) {
+                if (!(ignore_uncacheable && entry->isUncacheable()) &&
+                    entry->matchBlockAddr(blk_addr, is_secure)) {
+                    return entry;
+                }
+            }
+            return nullptr;
+        }
+
         for (const auto& entry : allocatedList) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
@@ -206,6 +316,24 @@ class Queue : public Drainable, public Named
      */
     Entry* findPending(const QueueEntry* entry) const
     {
+        if (hashedLookup) {
+            // Entries that have not been sent downstream are on the ready
+            // list. If a single one conflicts it is the answer, otherwise
+            // the ready list order decides which one is the earliest.
+            Entry *match = nullptr;
+            unsigned num_matches = 0;
+            for (Entry *pending = bucketHead[bucketOf(entry->blkAddr)];
+                 pending; pending = hashNext[indexOf(pending)]) {
+                if (!pending->inService && pending->conflictAddr(entry)) {
+                    match = pending;
+                    num_matches++;
+                }
+            }
+            if (num_matches <= 1) {
+                return match;
+            }
+        }
+
         for (const auto& ready_entry : readyList) {
             if (ready_entry->conflictAddr(entry)) {
                 return ready_entry;
@@ -240,6 +368,7 @@ class Queue : public Drainable, public Named
     virtual void
     deallocate(Entry *entry)
     {
+        unindexEntry(entry);
         allocatedList.erase(entry->allocIter);
         freeList.push_front(entry);
         allocated--;
@@ -29,10 +29,12 @@
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_BASE_HH__
 
+#include <cstdint>
 #include <memory>
 
 #include "base/compiler.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "mem/cache/replacement_policies/replacement_data_pool.hh"
 #include "mem/packet.hh"
 #include "params/BaseReplacementPolicy.hh"
 #include "sim/sim_object.hh"
@@ -40,11 +42,6 @@
 namespace gem5
 {
 
-/**
- * Replacement candidates as chosen by the indexing policy.
- */
-typedef std::vector<ReplaceableEntry*> ReplacementCandidates;
-
 namespace replacement_policy
 {
 
@@ -109,6 +106,23 @@ class Base : public SimObject
      * @return A shared pointer to the new replacement data.
      */
     virtual std::shared_ptr<ReplacementData> instantiateEntry() = 0;
+
+    /**
+     * Instantiate the replacement data entry of a way of a set. Structures
+     * that know the position of their entries use this, so that policies
+     * can keep their replacement data in per-set arrays. The ways of a set
+     * are instantiated in order. By default the position is ignored.
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry within its set.
+     * @param assoc The number of ways of the set.
+     * @return A shared pointer to the new replacement data.
+     */
+    virtual std::shared_ptr<ReplacementData>
+    instantiateSetEntry(uint32_t set, uint32_t way, uint32_t assoc)
+    {
+        return instantiateEntry();
+    }
 };
 
 } // namespace replacement_policy
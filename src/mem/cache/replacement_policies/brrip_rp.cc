@@ -51,8 +51,8 @@ BRRIP::BRRIP(const Params &p)
 void
 BRRIP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
+    BRRIPReplData* casted_replacement_data =
+        static_cast<BRRIPReplData*>(replacement_data.get());
 
     // Invalidate entry
     casted_replacement_data->valid = false;
@@ -61,8 +61,8 @@ BRRIP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 void
 BRRIP::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
+    BRRIPReplData* casted_replacement_data =
+        static_cast<BRRIPReplData*>(replacement_data.get());
 
     // Update RRPV if not 0 yet
     // Every hit in HP mode makes the entry the last to be evicted, while
@@ -77,8 +77,8 @@ BRRIP::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 void
 BRRIP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
+    BRRIPReplData* casted_replacement_data =
+        static_cast<BRRIPReplData*>(replacement_data.get());
 
     // Reset RRPV
     // Replacement data is inserted as "long re-reference" if lower than btp,
@@ -102,14 +102,14 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
 
     // Store victim->rrpv in a variable to improve code readability
-    int victim_RRPV = std::static_pointer_cast<BRRIPReplData>(
-                        victim->replacementData)->rrpv;
+    int victim_RRPV = static_cast<BRRIPReplData*>(
+                        victim->replacementData.get())->rrpv;
 
     // Visit all candidates to find victim
     for (const auto& candidate : candidates) {
-        std::shared_ptr<BRRIPReplData> candidate_repl_data =
-            std::static_pointer_cast<BRRIPReplData>(
-                candidate->replacementData);
+        BRRIPReplData* candidate_repl_data =
+            static_cast<BRRIPReplData*>(
+                candidate->replacementData.get());
 
         // Stop searching for victims if an invalid entry is found
         if (!candidate_repl_data->valid) {
@@ -126,15 +126,15 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
 
     // Get difference of victim's RRPV to the highest possible RRPV in
     // order to update the RRPV of all the other entries accordingly
-    int diff = std::static_pointer_cast<BRRIPReplData>(
-        victim->replacementData)->rrpv.saturate();
+    int diff = static_cast<BRRIPReplData*>(
+        victim->replacementData.get())->rrpv.saturate();
 
     // No need to update RRPV if there is no difference
     if (diff > 0){
         // Update RRPV of all candidates
         for (const auto& candidate : candidates) {
-            std::static_pointer_cast<BRRIPReplData>(
-                candidate->replacementData)->rrpv += diff;
+            static_cast<BRRIPReplData*>(
+                candidate->replacementData.get())->rrpv += diff;
         }
     }
 
@@ -144,7 +144,13 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 BRRIP::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new BRRIPReplData(numRRPVBits));
+    return replDataPool.instantiate(numRRPVBits);
+}
+
+std::shared_ptr<ReplacementData>
+BRRIP::instantiateSetEntry(uint32_t set, uint32_t way, uint32_t assoc)
+{
+    return replDataTable.instantiate(set, way, assoc, numRRPVBits);
 }
 
 } // namespace replacement_policy
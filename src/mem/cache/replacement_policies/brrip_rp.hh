@@ -90,6 +90,14 @@ class BRRIP : public Base
         }
     };
 
+  private:
+    /** Storage of the replacement data of entries without a position. */
+    ReplacementDataPool<BRRIPReplData> replDataPool;
+
+    /** The replacement data of each set, indexed by way. */
+    ReplacementDataTable<BRRIPReplData> replDataTable;
+
+  protected:
     /**
      * Number of RRPV bits. An entry that saturates its RRPV has the longest
      * possible re-reference interval, that is, it is likely not to be used
@@ -157,6 +165,18 @@ class BRRIP : public Base
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+
+    /**
+     * Instantiate the replacement data entry of a way, in the array of its
+     * set.
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry within its set.
+     * @param assoc The number of ways of the set.
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateSetEntry(uint32_t set,
+        uint32_t way, uint32_t assoc) override;
 };
 
 } // namespace replacement_policy
@@ -50,8 +50,8 @@ Dueling::Dueling(const Params &p)
 void
 Dueling::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<DuelerReplData> casted_replacement_data =
-        std::static_pointer_cast<DuelerReplData>(replacement_data);
+    DuelerReplData* casted_replacement_data =
+        static_cast<DuelerReplData*>(replacement_data.get());
     replPolicyA->invalidate(casted_replacement_data->replDataA);
     replPolicyB->invalidate(casted_replacement_data->replDataB);
 }
@@ -60,8 +60,8 @@ void
 Dueling::touch(const std::shared_ptr<ReplacementData>& replacement_data,
     const PacketPtr pkt)
 {
-    std::shared_ptr<DuelerReplData> casted_replacement_data =
-        std::static_pointer_cast<DuelerReplData>(replacement_data);
+    DuelerReplData* casted_replacement_data =
+        static_cast<DuelerReplData*>(replacement_data.get());
     replPolicyA->touch(casted_replacement_data->replDataA, pkt);
     replPolicyB->touch(casted_replacement_data->replDataB, pkt);
 }
@@ -69,8 +69,8 @@ Dueling::touch(const std::shared_ptr<ReplacementData>& replacement_data,
 void
 Dueling::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<DuelerReplData> casted_replacement_data =
-        std::static_pointer_cast<DuelerReplData>(replacement_data);
+    DuelerReplData* casted_replacement_data =
+        static_cast<DuelerReplData*>(replacement_data.get());
     replPolicyA->touch(casted_replacement_data->replDataA);
     replPolicyB->touch(casted_replacement_data->replDataB);
 }
@@ -79,8 +79,8 @@ void
 Dueling::reset(const std::shared_ptr<ReplacementData>& replacement_data,
     const PacketPtr pkt)
 {
-    std::shared_ptr<DuelerReplData> casted_replacement_data =
-        std::static_pointer_cast<DuelerReplData>(replacement_data);
+    DuelerReplData* casted_replacement_data =
+        static_cast<DuelerReplData*>(replacement_data.get());
     replPolicyA->reset(casted_replacement_data->replDataA, pkt);
     replPolicyB->reset(casted_replacement_data->replDataB, pkt);
 
@@ -88,14 +88,14 @@ Dueling::reset(const std::shared_ptr<ReplacementData>& replacement_data,
     // implies in the replacement of an entry, which was either caused by
     // a miss, an external invalidation, or the initialization of the table
     // entry (when warming up)
-    duelingMonitor.sample(static_cast<Dueler*>(casted_replacement_data.get()));
+    duelingMonitor.sample(static_cast<Dueler*>(casted_replacement_data));
 }
 
 void
 Dueling::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<DuelerReplData> casted_replacement_data =
-        std::static_pointer_cast<DuelerReplData>(replacement_data);
+    DuelerReplData* casted_replacement_data =
+        static_cast<DuelerReplData*>(replacement_data.get());
     replPolicyA->reset(casted_replacement_data->replDataA);
     replPolicyB->reset(casted_replacement_data->replDataB);
 
@@ -103,7 +103,7 @@ Dueling::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
     // implies in the replacement of an entry, which was either caused by
     // a miss, an external invalidation, or the initialization of the table
     // entry (when warming up)
-    duelingMonitor.sample(static_cast<Dueler*>(casted_replacement_data.get()));
+    duelingMonitor.sample(static_cast<Dueler*>(casted_replacement_data));
 }
 
 ReplaceableEntry*
@@ -121,8 +121,8 @@ Dueling::getVictim(const ReplacementCandidates& candidates) const
     // If the entry is a sample, it can only be used with a certain policy.
     bool team;
     bool is_sample = duelingMonitor.isSample(static_cast<Dueler*>(
-        std::static_pointer_cast<DuelerReplData>(
-            candidates[0]->replacementData).get()), team);
+        static_cast<DuelerReplData*>(
+            candidates[0]->replacementData.get())), team);
 
     // All replacement candidates must be set appropriately, so that the
     // proper replacement data is used. A replacement policy X must be used
@@ -142,21 +142,21 @@ Dueling::getVictim(const ReplacementCandidates& candidates) const
     // replacement data of the selected team
     std::vector<std::shared_ptr<ReplacementData>> dueling_replacement_data;
     for (auto& candidate : candidates) {
-        std::shared_ptr<DuelerReplData> dueler_repl_data =
-            std::static_pointer_cast<DuelerReplData>(
-            candidate->replacementData);
+        DuelerReplData* dueler_repl_data =
+            static_cast<DuelerReplData*>(
+            candidate->replacementData.get());
 
         // As of now we assume that all candidates are either part of
         // the same sampled team, or are not samples.
         bool candidate_team;
         panic_if(
-            duelingMonitor.isSample(dueler_repl_data.get(), candidate_team) &&
+            duelingMonitor.isSample(dueler_repl_data, candidate_team) &&
             (team != candidate_team),
             "Not all sampled candidates belong to the same team");
 
         // Copy the original entry's data, re-routing its replacement data
         // to the selected one
-        dueling_replacement_data.push_back(dueler_repl_data);
+        dueling_replacement_data.push_back(candidate->replacementData);
         candidate->replacementData = team_a ? dueler_repl_data->replDataA :
             dueler_repl_data->replDataB;
     }
@@ -176,10 +176,24 @@ Dueling::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 Dueling::instantiateEntry()
 {
-    DuelerReplData* replacement_data = new DuelerReplData(
-        replPolicyA->instantiateEntry(), replPolicyB->instantiateEntry());
-    duelingMonitor.initEntry(static_cast<Dueler*>(replacement_data));
-    return std::shared_ptr<DuelerReplData>(replacement_data);
+    std::shared_ptr<ReplacementData> replacement_data =
+        replDataPool.instantiate(replPolicyA->instantiateEntry(),
+                                 replPolicyB->instantiateEntry());
+    duelingMonitor.initEntry(static_cast<Dueler*>(
+        static_cast<DuelerReplData*>(replacement_data.get())));
+    return replacement_data;
+}
+
+std::shared_ptr<ReplacementData>
+Dueling::instantiateSetEntry(uint32_t set, uint32_t way, uint32_t assoc)
+{
+    std::shared_ptr<ReplacementData> replacement_data =
+        replDataPool.instantiate(
+            replPolicyA->instantiateSetEntry(set, way, assoc),
+            replPolicyB->instantiateSetEntry(set, way, assoc));
+    duelingMonitor.initEntry(static_cast<Dueler*>(
+        static_cast<DuelerReplData*>(replacement_data.get())));
+    return replacement_data;
 }
 
 Dueling::DuelingStats::DuelingStats(statistics::Group* parent)
@@ -70,6 +70,11 @@ class Dueling : public Base
         }
     };
 
+  private:
+    /** Dense storage of the replacement data of all entries. */
+    ReplacementDataPool<DuelerReplData> replDataPool;
+
+  protected:
     /** Sub-replacement policy used in this multiple container. */
     Base* const replPolicyA;
     /** Sub-replacement policy used in this multiple container. */
@@ -110,6 +115,8 @@ class Dueling : public Base
     ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
                                                                      override;
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+    std::shared_ptr<ReplacementData> instantiateSetEntry(uint32_t set,
+        uint32_t way, uint32_t assoc) override;
 };
 
 } // namespace replacement_policy
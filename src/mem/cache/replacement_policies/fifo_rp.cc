@@ -49,8 +49,8 @@ void
 FIFO::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset insertion tick
-    std::static_pointer_cast<FIFOReplData>(
-        replacement_data)->tickInserted = ++timeTicks;
+    static_cast<FIFOReplData*>(
+        replacement_data.get())->tickInserted = ++timeTicks;
 }
 
 void
@@ -63,8 +63,8 @@ void
 FIFO::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set insertion tick
-    std::static_pointer_cast<FIFOReplData>(
-        replacement_data)->tickInserted = ++timeTicks;
+    static_cast<FIFOReplData*>(
+        replacement_data.get())->tickInserted = ++timeTicks;
 }
 
 ReplaceableEntry*
@@ -77,10 +77,10 @@ FIFO::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<FIFOReplData>(
-                    candidate->replacementData)->tickInserted <
-                std::static_pointer_cast<FIFOReplData>(
-                    victim->replacementData)->tickInserted) {
+        if (static_cast<FIFOReplData*>(
+                    candidate->replacementData.get())->tickInserted <
+                static_cast<FIFOReplData*>(
+                    victim->replacementData.get())->tickInserted) {
             victim = candidate;
         }
     }
@@ -91,7 +91,7 @@ FIFO::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 FIFO::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new FIFOReplData());
+    return replDataPool.instantiate();
 }
 
 } // namespace replacement_policy
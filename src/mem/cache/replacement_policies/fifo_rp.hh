@@ -62,6 +62,9 @@ class FIFO : public Base
     };
 
   private:
+    /** Dense storage of the replacement data of all entries. */
+    ReplacementDataPool<FIFOReplData> replDataPool;
+
     /**
      * A counter that tracks the number of
      * ticks since being created to avoid a tie
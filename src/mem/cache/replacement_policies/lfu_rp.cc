@@ -48,21 +48,21 @@ void
 LFU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount = 0;
+    static_cast<LFUReplData*>(replacement_data.get())->refCount = 0;
 }
 
 void
 LFU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount++;
+    static_cast<LFUReplData*>(replacement_data.get())->refCount++;
 }
 
 void
 LFU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Reset reference count
-    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount = 1;
+    static_cast<LFUReplData*>(replacement_data.get())->refCount = 1;
 }
 
 ReplaceableEntry*
@@ -75,10 +75,10 @@ LFU::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<LFUReplData>(
-                    candidate->replacementData)->refCount <
-                std::static_pointer_cast<LFUReplData>(
-                    victim->replacementData)->refCount) {
+        if (static_cast<LFUReplData*>(
+                    candidate->replacementData.get())->refCount <
+                static_cast<LFUReplData*>(
+                    victim->replacementData.get())->refCount) {
             victim = candidate;
         }
     }
@@ -89,7 +89,7 @@ LFU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 LFU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new LFUReplData());
+    return replDataPool.instantiate();
 }
 
 } // namespace replacement_policy
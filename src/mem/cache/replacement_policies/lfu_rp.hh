@@ -62,6 +62,10 @@ class LFU : public Base
         LFUReplData() : refCount(0) {}
     };
 
+  private:
+    /** Dense storage of the replacement data of all entries. */
+    ReplacementDataPool<LFUReplData> replDataPool;
+
   public:
     typedef LFURPParams Params;
     LFU(const Params &p);
@@ -49,24 +49,24 @@ void
 LRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = Tick(0);
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = Tick(0);
 }
 
 void
 LRU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
 }
 
 void
 LRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    static_cast<LRUReplData*>(
+        replacement_data.get())->lastTouchTick = curTick();
 }
 
 ReplaceableEntry*
@@ -79,10 +79,10 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<LRUReplData>(
-                    candidate->replacementData)->lastTouchTick <
-                std::static_pointer_cast<LRUReplData>(
-                    victim->replacementData)->lastTouchTick) {
+        if (static_cast<LRUReplData*>(
+                    candidate->replacementData.get())->lastTouchTick <
+                static_cast<LRUReplData*>(
+                    victim->replacementData.get())->lastTouchTick) {
             victim = candidate;
         }
     }
@@ -93,7 +93,13 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 LRU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new LRUReplData());
+    return replDataPool.instantiate();
+}
+
+std::shared_ptr<ReplacementData>
+LRU::instantiateSetEntry(uint32_t set, uint32_t way, uint32_t assoc)
+{
+    return replDataTable.instantiate(set, way, assoc);
 }
 
 } // namespace replacement_policy
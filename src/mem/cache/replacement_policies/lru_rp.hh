@@ -60,6 +60,13 @@ class LRU : public Base
         LRUReplData() : lastTouchTick(0) {}
     };
 
+  private:
+    /** Storage of the replacement data of entries without a position. */
+    ReplacementDataPool<LRUReplData> replDataPool;
+
+    /** The replacement data of each set, indexed by way. */
+    ReplacementDataTable<LRUReplData> replDataTable;
+
   public:
     typedef LRURPParams Params;
     LRU(const Params &p);
@@ -107,6 +114,18 @@ class LRU : public Base
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+
+    /**
+     * Instantiate the replacement data entry of a way, in the array of its
+     * set.
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry within its set.
+     * @param assoc The number of ways of the set.
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateSetEntry(uint32_t set,
+        uint32_t way, uint32_t assoc) override;
 };
 
 } // namespace replacement_policy
@@ -62,6 +62,10 @@ class MRU : public Base
         MRUReplData() : lastTouchTick(0) {}
     };
 
+  private:
+    /** Dense storage of the replacement data of all entries. */
+    ReplacementDataPool<MRUReplData> replDataPool;
+
   public:
     typedef MRURPParams Params;
     MRU(const Params &p);
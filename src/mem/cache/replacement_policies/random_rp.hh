@@ -63,6 +63,10 @@ class Random : public Base
         RandomReplData() : valid(false) {}
     };
 
+  private:
+    /** Dense storage of the replacement data of all entries. */
+    ReplacementDataPool<RandomReplData> replDataPool;
+
   public:
     typedef RandomRPParams Params;
     Random(const Params &p);
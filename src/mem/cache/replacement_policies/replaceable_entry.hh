@@ -29,8 +29,11 @@
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEABLE_ENTRY_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEABLE_ENTRY_HH__
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -121,6 +124,46 @@ class ReplaceableEntry
     }
 };
 
+/**
+ * Replacement candidates as chosen by the indexing policy. This is a view
+ * of a contiguous array of entries owned by someone else, usually a set of
+ * the indexing policy, so looking up and passing around candidates does
+ * not allocate. It is only valid as long as the array it refers to.
+ */
+class ReplacementCandidates
+{
+  public:
+    typedef ReplaceableEntry* const* const_iterator;
+
+    ReplacementCandidates() : _data(nullptr), _size(0) {}
+
+    ReplacementCandidates(ReplaceableEntry* const* data, std::size_t size)
+      : _data(data), _size(size)
+    {}
+
+    /** View the entries of a vector, which must outlive the view. */
+    ReplacementCandidates(const std::vector<ReplaceableEntry*>& entries)
+      : _data(entries.data()), _size(entries.size())
+    {}
+
+    const_iterator begin() const { return _data; }
+    const_iterator end() const { return _data + _size; }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    ReplaceableEntry*
+    operator[](std::size_t idx) const
+    {
+        assert(idx < _size);
+        return _data[idx];
+    }
+
+  private:
+    ReplaceableEntry* const* _data;
+    std::size_t _size;
+};
+
 } // namespace gem5
 
 #endif // __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEABLE_ENTRY_HH_
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_POOL_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_POOL_HH__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/logging.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+/**
+ * Dense storage for the replacement data of a policy. Instead of giving
+ * every entry its own heap object and reference count, entries are
+ * constructed back to back in chunks, and the pointers handed out share
+ * the ownership of their chunk. Tag stores instantiate the replacement
+ * data of their entries in set and way order, so the replacement data of
+ * a set ends up contiguous in memory.
+ *
+ * Chunks start small, so that tiny tables do not pay for a large chunk,
+ * and grow geometrically up to a fixed size. A chunk is released once the
+ * pool and all the entries carved from it are gone.
+ *
+ * @tparam Data The replacement data type of the policy.
+ */
+template <typename Data>
+class ReplacementDataPool
+{
+  private:
+    /** Number of entries of the first chunk. */
+    static constexpr std::size_t minChunkEntries = 64;
+
+    /** Maximum number of entries of a chunk. */
+    static constexpr std::size_t maxChunkEntries = 4096;
+
+    /** Number of entries of the next chunk to be allocated. */
+    std::size_t nextChunkEntries = minChunkEntries;
+
+    /** The chunk entries are currently being constructed in. */
+    std::shared_ptr<std::vector<Data>> chunk;
+
+  public:
+    /**
+     * Construct a new replacement data entry in the pool.
+     *
+     * @param args The arguments forwarded to the entry's constructor.
+     * @return A pointer to the entry, sharing ownership of its chunk.
+     */
+    template <typename... Args>
+    std::shared_ptr<ReplacementData>
+    instantiate(Args&&... args)
+    {
+        // The chunk never reallocates, so that handed out entries stay put
+        if (!chunk || chunk->size() == chunk->capacity()) {
+            chunk = std::make_shared<std::vector<Data>>();
+            chunk->reserve(nextChunkEntries);
+            nextChunkEntries = std::min(2 * nextChunkEntries,
+                                        maxChunkEntries);
+        }
+
+        chunk->emplace_back(std::forward<Args>(args)...);
+        return std::shared_ptr<ReplacementData>(chunk, &chunk->back());
+    }
+};
+
+/**
+ * The replacement data of a policy, kept in one array per set and indexed
+ * by way. The arrays are owned by the policy, and the pointers handed out
+ * for the entries share the ownership of their set's array, so that the
+ * replacement state of a set is contiguous and can be reached by way.
+ *
+ * The ways of a set must be instantiated in order, as the tag stores do
+ * when they initialize their entries set by set. A policy may be shared
+ * by several tag stores, so instantiating way 0 of a set that already
+ * has ways starts a new array for the set, which belongs to the next
+ * owner. The table only keeps the latest array of each set; earlier ones
+ * live on through the entries handed out for them.
+ *
+ * @tparam Data The replacement data type of the policy.
+ */
+template <typename Data>
+class ReplacementDataTable
+{
+  public:
+    /** The replacement data of the ways of a set. */
+    typedef std::vector<Data> Row;
+
+  private:
+    /** The arrays of all sets, indexed by set. */
+    std::vector<std::shared_ptr<Row>> rows;
+
+  public:
+    /**
+     * Construct the replacement data of the next way of a set.
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry within its set.
+     * @param assoc The number of ways of the set.
+     * @param args The arguments forwarded to the entry's constructor.
+     * @return A pointer to the entry, sharing ownership of its set's array.
+     */
+    template <typename... Args>
+    std::shared_ptr<ReplacementData>
+    instantiate(uint32_t set, uint32_t way, uint32_t assoc, Args&&... args)
+    {
+        if (set >= rows.size())
+            rows.resize(set + 1);
+
+        // Reserve the whole set upfront, so that the array never
+        // reallocates and handed out entries stay put
+        std::shared_ptr<Row> &row = rows[set];
+        if (!row || (way == 0 && !row->empty())) {
+            row = std::make_shared<Row>();
+            row->reserve(assoc);
+        }
+        panic_if(way != row->size() || way >= row->capacity(),
+                 "Way %u of set %u instantiated out of order.", way, set);
+
+        row->emplace_back(std::forward<Args>(args)...);
+        return std::shared_ptr<ReplacementData>(row, &row->back());
+    }
+
+    /**
+     * The replacement data of a set.
+     *
+     * @param set The set.
+     * @return The set's array, or nullptr if none of its ways exist.
+     */
+    Row *
+    row(uint32_t set) const
+    {
+        return set < rows.size() ? rows[set].get() : nullptr;
+    }
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_POOL_HH__
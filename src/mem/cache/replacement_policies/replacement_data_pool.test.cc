@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "mem/cache/replacement_policies/replacement_data_pool.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+struct TestReplData : ReplacementData
+{
+    int value;
+    int *destroyed;
+
+    TestReplData(int value, int *destroyed)
+      : value(value), destroyed(destroyed)
+    {}
+
+    ~TestReplData() { (*destroyed)++; }
+};
+
+} // anonymous namespace
+
+/** Entries are constructed with the given arguments, back to back. */
+TEST(ReplacementDataPoolTest, ConsecutiveEntries)
+{
+    int destroyed = 0;
+    ReplacementDataPool<TestReplData> pool;
+    std::shared_ptr<ReplacementData> first = pool.instantiate(1, &destroyed);
+    std::shared_ptr<ReplacementData> second = pool.instantiate(2, &destroyed);
+
+    TestReplData *first_data = static_cast<TestReplData*>(first.get());
+    TestReplData *second_data = static_cast<TestReplData*>(second.get());
+    ASSERT_EQ(first_data->value, 1);
+    ASSERT_EQ(second_data->value, 2);
+    ASSERT_EQ(first_data + 1, second_data);
+}
+
+/** Entries never move, even when new chunks are allocated. */
+TEST(ReplacementDataPoolTest, StableEntries)
+{
+    int destroyed = 0;
+    ReplacementDataPool<TestReplData> pool;
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    for (int i = 0; i < 10000; i++) {
+        entries.push_back(pool.instantiate(i, &destroyed));
+    }
+
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_EQ(static_cast<TestReplData*>(entries[i].get())->value, i);
+    }
+    ASSERT_EQ(destroyed, 0);
+}
+
+/** Entries keep their storage alive after the pool is gone. */
+TEST(ReplacementDataPoolTest, EntriesOutlivePool)
+{
+    int destroyed = 0;
+    std::shared_ptr<ReplacementData> entry;
+    {
+        ReplacementDataPool<TestReplData> pool;
+        entry = pool.instantiate(42, &destroyed);
+        pool.instantiate(43, &destroyed);
+    }
+
+    ASSERT_EQ(destroyed, 0);
+    ASSERT_EQ(static_cast<TestReplData*>(entry.get())->value, 42);
+
+    entry.reset();
+    ASSERT_EQ(destroyed, 2);
+}
+
+/** The ways of a set are stored contiguously, indexed by way. */
+TEST(ReplacementDataTableTest, WayIndexedRows)
+{
+    int destroyed = 0;
+    ReplacementDataTable<TestReplData> table;
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    for (uint32_t set = 0; set < 3; set++) {
+        for (uint32_t way = 0; way < 4; way++) {
+            entries.push_back(table.instantiate(set, way, 4,
+                                                set * 4 + way, &destroyed));
+        }
+    }
+
+    for (uint32_t set = 0; set < 3; set++) {
+        ReplacementDataTable<TestReplData>::Row *row = table.row(set);
+        ASSERT_NE(row, nullptr);
+        ASSERT_EQ(row->size(), 4u);
+        for (uint32_t way = 0; way < 4; way++) {
+            EXPECT_EQ((*row)[way].value, int(set * 4 + way));
+            EXPECT_EQ(&(*row)[way], entries[set * 4 + way].get());
+        }
+    }
+    EXPECT_EQ(table.row(3), nullptr);
+}
+
+/** Sets may be instantiated in any order, but not their ways. */
+TEST(ReplacementDataTableTest, SetOrder)
+{
+    int destroyed = 0;
+    ReplacementDataTable<TestReplData> table;
+    auto high = table.instantiate(7, 0, 2, 70, &destroyed);
+    auto low = table.instantiate(1, 0, 2, 10, &destroyed);
+    EXPECT_EQ(table.row(0), nullptr);
+    EXPECT_EQ((*table.row(7))[0].value, 70);
+    EXPECT_EQ((*table.row(1))[0].value, 10);
+
+    // Skipping a way, or going past the associativity, is an error
+    EXPECT_ANY_THROW(table.instantiate(1, 2, 2, 12, &destroyed));
+    table.instantiate(1, 1, 2, 11, &destroyed);
+    EXPECT_ANY_THROW(table.instantiate(1, 2, 2, 12, &destroyed));
+}
+
+/** Each tag store sharing the table gets its own array per set. */
+TEST(ReplacementDataTableTest, SeveralOwners)
+{
+    int destroyed = 0;
+    ReplacementDataTable<TestReplData> table;
+    std::vector<std::shared_ptr<ReplacementData>> first, second;
+    for (uint32_t set = 0; set < 2; set++) {
+        for (uint32_t way = 0; way < 2; way++) {
+            first.push_back(table.instantiate(set, way, 2,
+                                              set * 2 + way, &destroyed));
+        }
+    }
+    for (uint32_t set = 0; set < 2; set++) {
+        for (uint32_t way = 0; way < 2; way++) {
+            second.push_back(table.instantiate(set, way, 2,
+                                               10 + set * 2 + way,
+                                               &destroyed));
+        }
+    }
+
+    // The table refers to the latest owner's arrays, while the first
+    // owner's entries keep theirs, still contiguous
+    for (uint32_t set = 0; set < 2; set++) {
+        EXPECT_EQ(&(*table.row(set))[0], second[set * 2].get());
+        EXPECT_EQ(static_cast<TestReplData*>(first[set * 2 + 1].get()),
+                  static_cast<TestReplData*>(first[set * 2].get()) + 1);
+        for (uint32_t way = 0; way < 2; way++) {
+            EXPECT_EQ(static_cast<TestReplData*>(
+                first[set * 2 + way].get())->value, int(set * 2 + way));
+            EXPECT_EQ(static_cast<TestReplData*>(
+                second[set * 2 + way].get())->value,
+                int(10 + set * 2 + way));
+        }
+    }
+    EXPECT_EQ(destroyed, 0);
+
+    // Ways other than the first must still come in order
+    EXPECT_ANY_THROW(table.instantiate(0, 1, 2, 20, &destroyed));
+}
+
+/** Entries keep the array of their set alive after the table is gone. */
+TEST(ReplacementDataTableTest, EntriesOutliveTable)
+{
+    int destroyed = 0;
+    std::shared_ptr<ReplacementData> entry;
+    {
+        ReplacementDataTable<TestReplData> table;
+        table.instantiate(0, 0, 2, 1, &destroyed);
+        entry = table.instantiate(0, 1, 2, 2, &destroyed);
+        table.instantiate(1, 0, 2, 3, &destroyed);
+    }
+
+    // Only the other set is gone
+    ASSERT_EQ(destroyed, 1);
+    ASSERT_EQ(static_cast<TestReplData*>(entry.get())->value, 2);
+
+    entry.reset();
+    ASSERT_EQ(destroyed, 3);
+}
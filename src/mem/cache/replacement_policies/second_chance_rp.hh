@@ -68,13 +68,18 @@ class SecondChance : public FIFO
         SecondChanceReplData() : FIFOReplData(), hasSecondChance(false) {}
     };
 
+  private:
+    /** Dense storage of the replacement data of all entries. */
+    ReplacementDataPool<SecondChanceReplData> replDataPool;
+
+  protected:
     /**
      * Use replacement data's second chance.
      *
      * @param replacement_data Entry that will use its second chance.
      */
     void useSecondChance(
-        const std::shared_ptr<SecondChanceReplData>& replacement_data) const;
+        const std::shared_ptr<ReplacementData>& replacement_data) const;
 
   public:
     typedef SecondChanceRPParams Params;
@@ -93,6 +93,11 @@ class SHiP : public BRRIP
         bool wasReReferenced() const;
     };
 
+  private:
+    /** Dense storage of the replacement data of all entries. */
+    ReplacementDataPool<SHiPReplData> replDataPool;
+
+  protected:
     /**
      * Saturation percentage at which an entry starts being inserted as
      * intermediate re-reference.
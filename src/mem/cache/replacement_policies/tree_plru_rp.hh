@@ -122,7 +122,7 @@ class TreePLRU : public Base
     /**
      * Holds the latest temporary tree instance created by instantiateEntry().
      */
-    PLRUTree* treeInstance;
+    std::shared_ptr<PLRUTree> treeInstance;
 
   protected:
     /**
@@ -154,6 +154,19 @@ class TreePLRU : public Base
         TreePLRUReplData(const uint64_t index, std::shared_ptr<PLRUTree> tree);
     };
 
+  private:
+    /** Storage of the replacement data of entries without a position. */
+    ReplacementDataPool<TreePLRUReplData> replDataPool;
+
+    /** The replacement data of each set, indexed by way. */
+    ReplacementDataTable<TreePLRUReplData> replDataTable;
+
+    /**
+     * The tree of each set, for entries instantiated by position. It
+     * belongs to the latest owner to instantiate the set.
+     */
+    std::vector<std::shared_ptr<PLRUTree>> setTrees;
+
   public:
     typedef TreePLRURPParams Params;
     TreePLRU(const Params &p);
@@ -207,6 +220,19 @@ class TreePLRU : public Base
      * @return A shared pointer to the new replacement data.
      */
     std::shared_ptr<ReplacementData> instantiateEntry() override;
+
+    /**
+     * Instantiate the replacement data entry of a way, as the leaf of the
+     * tree of its set. If the sets don't have numLeaves ways, the position
+     * is ignored and entries share trees as with instantiateEntry().
+     *
+     * @param set The set of the entry.
+     * @param way The way of the entry within its set.
+     * @param assoc The number of ways of the set.
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateSetEntry(uint32_t set,
+        uint32_t way, uint32_t assoc) override;
 };
 
 } // namespace replacement_policy
@@ -52,7 +52,7 @@ WeightedLRU::touch(const std::shared_ptr<ReplacementData>& replacement_data,
     int occupancy) const
 {
     LRU::touch(replacement_data);
-    std::static_pointer_cast<WeightedLRUReplData>(replacement_data)->
+    static_cast<WeightedLRUReplData*>(replacement_data.get())->
                                                   last_occ_ptr = occupancy;
 }
 
@@ -67,13 +67,13 @@ WeightedLRU::getVictim(const ReplacementCandidates& candidates) const
     // If two blocks have the same weight, evict the oldest one.
     for (const auto& candidate : candidates) {
         // candidate's replacement_data
-        std::shared_ptr<WeightedLRUReplData> candidate_replacement_data =
-            std::static_pointer_cast<WeightedLRUReplData>(
-                                             candidate->replacementData);
+        WeightedLRUReplData* candidate_replacement_data =
+            static_cast<WeightedLRUReplData*>(
+                                             candidate->replacementData.get());
         // victim's replacement_data
-        std::shared_ptr<WeightedLRUReplData> victim_replacement_data =
-            std::static_pointer_cast<WeightedLRUReplData>(
-                                             victim->replacementData);
+        WeightedLRUReplData* victim_replacement_data =
+            static_cast<WeightedLRUReplData*>(
+                                             victim->replacementData.get());
 
         if (candidate_replacement_data->last_occ_ptr <
                     victim_replacement_data->last_occ_ptr) {
@@ -93,7 +93,7 @@ WeightedLRU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 WeightedLRU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new WeightedLRUReplData);
+    return replDataPool.instantiate();
 }
 
 } // namespace replacement_policy
@@ -59,6 +59,11 @@ class WeightedLRU : public LRU
          */
         WeightedLRUReplData() : LRUReplData(), last_occ_ptr(0) {}
     };
+
+  private:
+    /** Dense storage of the replacement data of all entries. */
+    ReplacementDataPool<WeightedLRUReplData> replDataPool;
+
   public:
     typedef WeightedLRURPParams Params;
     WeightedLRU(const Params &p);
@@ -95,6 +95,16 @@ class BaseSetAssoc(BaseTags):
     )
 
 
+class PackedSetAssoc(BaseSetAssoc):
+    type = "PackedSetAssoc"
+    cxx_header = "mem/cache/tags/packed_set_assoc.hh"
+    cxx_class = "gem5::PackedSetAssoc"
+
+    # The packed lookup requires all ways of an address to be in the same
+    # set, so only the SetAssociative indexing policy is supported
+    indexing_policy = SetAssociative()
+
+
 class SectorTags(BaseTags):
     type = "SectorTags"
     cxx_header = "mem/cache/tags/sector_tags.hh"
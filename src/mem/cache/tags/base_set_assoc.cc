@@ -81,7 +81,8 @@ BaseSetAssoc::tagsInit()
         blk->data = &dataBlks[blkSize*blk_index];
 
         // Associate a replacement data entry to the block
-        blk->replacementData = replacementPolicy->instantiateEntry();
+        blk->replacementData = replacementPolicy->instantiateSetEntry(
+            blk->getSet(), blk->getWay(), indexingPolicy->getAssoc());
     }
 }
 
@@ -68,9 +68,6 @@ CompressedTags::tagsInit()
         // allocation conditions
         superblock->setBlkSize(blkSize);
 
-        // Associate a replacement data entry to the block
-        superblock->replacementData = replacementPolicy->instantiateEntry();
-
         // Initialize all blocks in this superblock
         superblock->blks.resize(numBlocksPerSector, nullptr);
         for (unsigned k = 0; k < numBlocksPerSector; ++k){
@@ -86,9 +83,6 @@ CompressedTags::tagsInit()
             // Associate superblock to this block
             blk->setSectorBlock(superblock);
 
-            // Associate the superblock replacement data to this block
-            blk->replacementData = superblock->replacementData;
-
             // Set its index and sector offset
             blk->setSectorOffset(k);
 
@@ -98,6 +92,13 @@ CompressedTags::tagsInit()
 
         // Link block to indexing policy
         indexingPolicy->setEntry(superblock, superblock_index);
+
+        // Associate a replacement data entry to the superblock and its blocks
+        superblock->replacementData = replacementPolicy->instantiateSetEntry(
+            superblock->getSet(), superblock->getWay(),
+            indexingPolicy->getAssoc());
+        for (auto *blk : superblock->blks)
+            blk->replacementData = superblock->replacementData;
     }
 }
 
@@ -107,7 +108,7 @@ CompressedTags::findVictim(Addr addr, const bool is_secure,
                            std::vector<CacheBlk*>& evict_blks)
 {
     // Get all possible locations of this superblock
-    const std::vector<ReplaceableEntry*> superblock_entries =
+    const ReplacementCandidates superblock_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     // Check if the superblock this address belongs to has been allocated. If
@@ -69,9 +69,10 @@ SetAssociative::regenerateAddr(const Addr tag, const ReplaceableEntry* entry)
     return (tag << tagShift) | (entry->getSet() << setShift);
 }
 
-std::vector<ReplaceableEntry*>
+ReplacementCandidates
 SetAssociative::getPossibleEntries(const Addr addr) const
 {
+    // The ways of a set are contiguous, so they can be viewed in place
     return sets[extractSet(addr)];
 }
 
@@ -81,7 +81,12 @@ class ReplaceableEntry;
  */
 class SetAssociative : public BaseIndexingPolicy
 {
-  protected:
+  public:
+    /**
+     * Convenience typedef.
+     */
+    typedef SetAssociativeParams Params;
+
     /**
      * Apply a hash function to calculate address set.
      *
@@ -90,12 +95,6 @@ class SetAssociative : public BaseIndexingPolicy
      */
     virtual uint32_t extractSet(const Addr addr) const;
 
-  public:
-    /**
-     * Convenience typedef.
-     */
-    typedef SetAssociativeParams Params;
-
     /**
      * Construct and initialize this policy.
      */
@@ -115,7 +114,7 @@ class SetAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
+    ReplacementCandidates getPossibleEntries(const Addr addr) const
                                                                      override;
 
     /**
@@ -85,6 +85,13 @@ class SkewedAssociative : public BaseIndexingPolicy
      */
     const int msbShift;
 
+    /**
+     * The entries gathered by the last getPossibleEntries() call. The ways
+     * of an address are spread over different sets, so they are copied
+     * here to be viewed contiguously.
+     */
+    mutable std::vector<ReplaceableEntry*> candidates;
+
     /**
      * The hash function itself. Uses the hash function H, as described in
      * "Skewed-Associative Caches", from Seznec et al. (section 3.3): It
@@ -160,7 +167,7 @@ class SkewedAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
+    ReplacementCandidates getPossibleEntries(const Addr addr) const
                                                                    override;
 
     /**
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of a dense array of packed lookup keys.
+ */
+
+#include "mem/cache/tags/packed_keys.hh"
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+PackedKeys::PackedKeys(unsigned num_sets, unsigned assoc)
+    : vectorsPerSet(divCeil(assoc, keysPerVector)),
+      keys(num_sets * vectorsPerSet)
+{
+    clear();
+}
+
+void
+PackedKeys::clear()
+{
+    for (auto &row_vector : keys) {
+        row_vector = KeyVector{};
+    }
+}
+
+int
+PackedKeys::find(uint32_t set, Addr tag, bool is_secure) const
+{
+    const KeyVector needle = KeyVector{} + packKey(tag, is_secure);
+    const KeyVector *row = &keys[set * vectorsPerSet];
+
+    for (unsigned v = 0; v < vectorsPerSet; v++) {
+        // Compare all keys of the vector at once, and gather the result
+        // into a mask of matching ways. Tags are unique within a set, so
+        // at most one way can match.
+        const auto match = row[v] == needle;
+        uint64_t mask = 0;
+        for (unsigned lane = 0; lane < keysPerVector; lane++) {
+            mask |= uint64_t(match[lane] & 1) << lane;
+        }
+
+        if (mask)
+            return v * keysPerVector + findLsbSet(mask);
+    }
+
+    return -1;
+}
+
+} // namespace gem5
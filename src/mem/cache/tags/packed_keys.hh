@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a dense array of packed lookup keys, one row per set.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PACKED_KEYS_HH__
+#define __MEM_CACHE_TAGS_PACKED_KEYS_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * The tag, valid and secure bits of every way of a set associative
+ * structure, packed into 64-bit keys and stored set by set in a
+ * contiguous array. A lookup compares the searched key against a whole
+ * row of ways with vector compares, so that only the dense key array is
+ * touched to find a way.
+ *
+ * The owner keeps the keys in sync with its entries by mirroring every
+ * operation that changes an entry's identity: insertion, invalidation and
+ * moves.
+ */
+class PackedKeys
+{
+  public:
+    /** Number of keys compared by a single vector compare. */
+    static constexpr unsigned keysPerVector = 4;
+
+    /**
+     * @param num_sets Number of sets.
+     * @param assoc Number of ways of a set.
+     */
+    PackedKeys(unsigned num_sets, unsigned assoc);
+
+    /** Invalidate the keys of all ways. */
+    void clear();
+
+    /**
+     * Set the key of a way that now holds a valid entry.
+     *
+     * @param set The set of the way.
+     * @param way The way within the set.
+     * @param tag The tag of the entry.
+     * @param is_secure Whether the entry is in the secure space.
+     */
+    void
+    insert(uint32_t set, uint32_t way, Addr tag, bool is_secure)
+    {
+        setKey(set, way, packKey(tag, is_secure));
+    }
+
+    /** Invalidate the key of a way. */
+    void invalidate(uint32_t set, uint32_t way) { setKey(set, way, 0); }
+
+    /**
+     * Move the key of a way to another, invalidating the source.
+     *
+     * @param src_set The set of the source way.
+     * @param src_way The source way.
+     * @param dest_set The set of the destination way.
+     * @param dest_way The destination way.
+     */
+    void
+    move(uint32_t src_set, uint32_t src_way,
+         uint32_t dest_set, uint32_t dest_way)
+    {
+        setKey(dest_set, dest_way, getKey(src_set, src_way));
+        setKey(src_set, src_way, 0);
+    }
+
+    /**
+     * Find the way of a set holding a valid entry with the given tag.
+     *
+     * @param set The set to search.
+     * @param tag The tag to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return The matching way, or -1 if there is none.
+     */
+    int find(uint32_t set, Addr tag, bool is_secure) const;
+
+  protected:
+    /** A vector of keys, compared as a single unit. */
+    typedef uint64_t KeyVector
+        __attribute__((vector_size(keysPerVector * sizeof(uint64_t))));
+
+    /** Number of key vectors in a set's row. */
+    const unsigned vectorsPerSet;
+
+    /**
+     * The packed keys, one row of vectorsPerSet vectors per set. Ways past
+     * the associativity hold an invalid key, so that rows can always be
+     * compared as a whole.
+     */
+    std::vector<KeyVector> keys;
+
+    /**
+     * Pack the lookup key of a valid entry.
+     *
+     * @param tag The entry's tag.
+     * @param is_secure Whether the entry is in the secure space.
+     * @return The packed key. Invalid ways are represented by key 0.
+     */
+    static uint64_t
+    packKey(Addr tag, bool is_secure)
+    {
+        return (tag << 2) | (uint64_t(is_secure) << 1) | 1;
+    }
+
+    /** Get the key of a way. */
+    uint64_t
+    getKey(uint32_t set, uint32_t way) const
+    {
+        return keys[set * vectorsPerSet + way / keysPerVector]
+            [way % keysPerVector];
+    }
+
+    /** Set the key of a way. */
+    void
+    setKey(uint32_t set, uint32_t way, uint64_t key)
+    {
+        keys[set * vectorsPerSet + way / keysPerVector]
+            [way % keysPerVector] = key;
+    }
+};
+
+} // namespace gem5
+
+#endif //__MEM_CACHE_TAGS_PACKED_KEYS_HH__
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/cache/tags/packed_keys.hh"
+
+using namespace gem5;
+
+/** All ways start invalid, including those of tag 0. */
+TEST(PackedKeysTest, InitiallyEmpty)
+{
+    PackedKeys keys(4, 8);
+    for (uint32_t set = 0; set < 4; set++) {
+        EXPECT_EQ(keys.find(set, 0, false), -1);
+        EXPECT_EQ(keys.find(set, 0, true), -1);
+        EXPECT_EQ(keys.find(set, 0x1234, false), -1);
+    }
+}
+
+/** Inserted tags are found in their own set and way only. */
+TEST(PackedKeysTest, Insert)
+{
+    PackedKeys keys(4, 8);
+    keys.insert(1, 0, 0x10, false);
+    keys.insert(1, 5, 0x20, false);
+    keys.insert(2, 7, 0x10, false);
+    keys.insert(3, 3, 0, false);
+
+    EXPECT_EQ(keys.find(1, 0x10, false), 0);
+    EXPECT_EQ(keys.find(1, 0x20, false), 5);
+    EXPECT_EQ(keys.find(2, 0x10, false), 7);
+    EXPECT_EQ(keys.find(3, 0, false), 3);
+
+    EXPECT_EQ(keys.find(0, 0x10, false), -1);
+    EXPECT_EQ(keys.find(2, 0x20, false), -1);
+    EXPECT_EQ(keys.find(1, 0x30, false), -1);
+}
+
+/** The secure bit is part of the key. */
+TEST(PackedKeysTest, Secure)
+{
+    PackedKeys keys(2, 4);
+    keys.insert(0, 1, 0x42, true);
+    EXPECT_EQ(keys.find(0, 0x42, true), 1);
+    EXPECT_EQ(keys.find(0, 0x42, false), -1);
+
+    keys.insert(0, 2, 0x42, false);
+    EXPECT_EQ(keys.find(0, 0x42, true), 1);
+    EXPECT_EQ(keys.find(0, 0x42, false), 2);
+}
+
+/** Reinserting a way replaces its previous key. */
+TEST(PackedKeysTest, Replace)
+{
+    PackedKeys keys(1, 4);
+    keys.insert(0, 2, 0x100, false);
+    keys.insert(0, 2, 0x200, false);
+    EXPECT_EQ(keys.find(0, 0x100, false), -1);
+    EXPECT_EQ(keys.find(0, 0x200, false), 2);
+}
+
+/** Invalidated ways are no longer found, others are unaffected. */
+TEST(PackedKeysTest, Invalidate)
+{
+    PackedKeys keys(2, 8);
+    for (uint32_t way = 0; way < 8; way++) {
+        keys.insert(0, way, way, false);
+        keys.insert(1, way, way, false);
+    }
+
+    keys.invalidate(0, 0);
+    keys.invalidate(0, 6);
+    EXPECT_EQ(keys.find(0, 0, false), -1);
+    EXPECT_EQ(keys.find(0, 6, false), -1);
+    EXPECT_EQ(keys.find(1, 0, false), 0);
+    EXPECT_EQ(keys.find(1, 6, false), 6);
+    for (uint32_t way : {1, 2, 3, 4, 5, 7})
+        EXPECT_EQ(keys.find(0, way, false), int(way));
+
+    keys.clear();
+    for (uint32_t way = 0; way < 8; way++) {
+        EXPECT_EQ(keys.find(0, way, false), -1);
+        EXPECT_EQ(keys.find(1, way, false), -1);
+    }
+}
+
+/** Moving a way's key invalidates the source way. */
+TEST(PackedKeysTest, Move)
+{
+    PackedKeys keys(2, 8);
+    keys.insert(0, 1, 0x77, true);
+
+    // Across key vectors of the same set
+    keys.move(0, 1, 0, 6);
+    EXPECT_EQ(keys.find(0, 0x77, true), 6);
+
+    // Within a key vector
+    keys.move(0, 6, 0, 4);
+    EXPECT_EQ(keys.find(0, 0x77, true), 4);
+
+    // To another set
+    keys.move(0, 4, 1, 2);
+    EXPECT_EQ(keys.find(0, 0x77, true), -1);
+    EXPECT_EQ(keys.find(1, 0x77, true), 2);
+    EXPECT_EQ(keys.find(1, 0x77, false), -1);
+}
+
+/**
+ * With an associativity that isn't a multiple of the vector width, the
+ * padding ways of a row never match, and rows don't overlap.
+ */
+TEST(PackedKeysTest, OddAssociativity)
+{
+    const unsigned assoc = 5;
+    PackedKeys keys(3, assoc);
+    for (uint32_t set = 0; set < 3; set++) {
+        for (uint32_t way = 0; way < assoc; way++)
+            keys.insert(set, way, set * assoc + way, false);
+    }
+
+    for (uint32_t set = 0; set < 3; set++) {
+        for (uint32_t way = 0; way < assoc; way++) {
+            EXPECT_EQ(keys.find(set, set * assoc + way, false), int(way));
+        }
+        // Tags of the other sets aren't found
+        EXPECT_EQ(keys.find(set, ((set + 1) % 3) * assoc, false), -1);
+    }
+
+    keys.invalidate(1, assoc - 1);
+    EXPECT_EQ(keys.find(1, 2 * assoc - 1, false), -1);
+    EXPECT_EQ(keys.find(2, 2 * assoc, false), 0);
+}
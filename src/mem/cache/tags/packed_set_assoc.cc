@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of a set associative tag store with packed per-set keys.
+ */
+
+#include "mem/cache/tags/packed_set_assoc.hh"
+
+#include <cassert>
+
+#include "base/logging.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+
+namespace gem5
+{
+
+PackedSetAssoc::PackedSetAssoc(const Params &p)
+    : BaseSetAssoc(p),
+      setIndexing(dynamic_cast<const SetAssociative*>(p.indexing_policy)),
+      keys(numBlocks / p.assoc, p.assoc)
+{
+    fatal_if(!setIndexing, "%s requires a SetAssociative indexing policy",
+             name());
+}
+
+void
+PackedSetAssoc::tagsInit()
+{
+    BaseSetAssoc::tagsInit();
+
+    // All blocks start invalid
+    keys.clear();
+}
+
+void
+PackedSetAssoc::updateKey(const CacheBlk *blk)
+{
+    if (blk->isValid()) {
+        keys.insert(blk->getSet(), blk->getWay(), blk->getTag(),
+                    blk->isSecure());
+    } else {
+        keys.invalidate(blk->getSet(), blk->getWay());
+    }
+}
+
+CacheBlk*
+PackedSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    const uint32_t set = setIndexing->extractSet(addr);
+    const int way = keys.find(set, extractTag(addr), is_secure);
+    if (way < 0)
+        return nullptr;
+
+    CacheBlk *blk =
+        static_cast<CacheBlk*>(indexingPolicy->getEntry(set, way));
+    assert(blk->matchTag(extractTag(addr), is_secure));
+    return blk;
+}
+
+void
+PackedSetAssoc::invalidate(CacheBlk *blk)
+{
+    BaseSetAssoc::invalidate(blk);
+    updateKey(blk);
+}
+
+void
+PackedSetAssoc::insertBlock(const PacketPtr pkt, CacheBlk *blk)
+{
+    BaseSetAssoc::insertBlock(pkt, blk);
+    updateKey(blk);
+}
+
+void
+PackedSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
+{
+    BaseSetAssoc::moveBlock(src_blk, dest_blk);
+    keys.move(src_blk->getSet(), src_blk->getWay(),
+              dest_blk->getSet(), dest_blk->getWay());
+}
+
+} // namespace gem5
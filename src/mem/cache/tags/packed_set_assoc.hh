@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a set associative tag store that keeps the tag, valid and
+ * secure bits of every way in a dense per-set array.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PACKED_SET_ASSOC_HH__
+#define __MEM_CACHE_TAGS_PACKED_SET_ASSOC_HH__
+
+#include "base/types.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/cache/tags/base_set_assoc.hh"
+#include "mem/cache/tags/packed_keys.hh"
+#include "mem/packet.hh"
+#include "params/PackedSetAssoc.hh"
+
+namespace gem5
+{
+
+class SetAssociative;
+
+/**
+ * A set associative tag store with a structure-of-arrays lookup path.
+ *
+ * The blocks are still regular CacheBlk objects, but a copy of each way's
+ * tag, valid and secure bits is kept in a PackedKeys array. A lookup only
+ * touches the dense key array on a miss, and only the matching block on a
+ * hit. The keys are kept in sync by the tag store operations that change a
+ * block's identity (insertion, invalidation and moves).
+ *
+ * Only the SetAssociative indexing policy is supported, as all ways of an
+ * address must live in the same row.
+ */
+class PackedSetAssoc : public BaseSetAssoc
+{
+  protected:
+    /** The indexing policy, used to extract an address' set. */
+    const SetAssociative *setIndexing;
+
+    /** The packed keys of all ways, mirroring the blocks' state. */
+    PackedKeys keys;
+
+    /**
+     * Refresh the packed key of a block from its current state.
+     *
+     * @param blk The block whose key must be updated.
+     */
+    void updateKey(const CacheBlk *blk);
+
+  public:
+    /** Convenience typedef. */
+    typedef PackedSetAssocParams Params;
+
+    /**
+     * Construct and initialize this tag store.
+     */
+    PackedSetAssoc(const Params &p);
+
+    void tagsInit() override;
+
+    /**
+     * Find a block by comparing the packed keys of all ways of its set.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block, or nullptr if not present.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
+    void invalidate(CacheBlk *blk) override;
+
+    void insertBlock(const PacketPtr pkt, CacheBlk *blk) override;
+
+    void moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk) override;
+};
+
+} // namespace gem5
+
+#endif //__MEM_CACHE_TAGS_PACKED_SET_ASSOC_HH__
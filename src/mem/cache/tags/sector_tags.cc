@@ -82,9 +82,6 @@ SectorTags::tagsInit()
         // Locate next cache sector
         SectorBlk* sec_blk = &secBlks[sec_blk_index];
 
-        // Associate a replacement data entry to the sector
-        sec_blk->replacementData = replacementPolicy->instantiateEntry();
-
         // Initialize all blocks in this sector
         sec_blk->blks.resize(numBlocksPerSector);
         for (unsigned k = 0; k < numBlocksPerSector; ++k){
@@ -100,9 +97,6 @@ SectorTags::tagsInit()
             // Associate sector block to this block
             blk->setSectorBlock(sec_blk);
 
-            // Associate the sector replacement data to this block
-            blk->replacementData = sec_blk->replacementData;
-
             // Set its index and sector offset
             blk->setSectorOffset(k);
 
@@ -112,6 +106,13 @@ SectorTags::tagsInit()
 
         // Link block to indexing policy
         indexingPolicy->setEntry(sec_blk, sec_blk_index);
+
+        // Associate a replacement data entry to the sector and its blocks
+        sec_blk->replacementData = replacementPolicy->instantiateSetEntry(
+            sec_blk->getSet(), sec_blk->getWay(),
+            indexingPolicy->getAssoc());
+        for (auto *blk : sec_blk->blks)
+            blk->replacementData = sec_blk->replacementData;
     }
 }
 
@@ -257,7 +258,7 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
     const Addr offset = extractSectorOffset(addr);
 
     // Find all possible sector entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
+    const ReplacementCandidates entries =
         indexingPolicy->getPossibleEntries(addr);
 
     // Search for block
@@ -277,7 +278,7 @@ SectorTags::findVictim(Addr addr, const bool is_secure, const std::size_t size,
                        std::vector<CacheBlk*>& evict_blks)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> sector_entries =
+    const ReplacementCandidates sector_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     // Check if the sector this address belongs to has been allocated
@@ -131,6 +131,7 @@ CfiMemory::ProgramBuffer::writeback()
     if (parent.blocks.isLocked(blockPointer)) {
         return false;
     } else {
+        parent.restoreRange(parent.start() + blockPointer, bytesWritten);
         std::memcpy(parent.toHostAddr(parent.start() + blockPointer),
             buffer.data(), bytesWritten);
         return true;
@@ -754,6 +755,7 @@ CfiMemory::cfiQuery(Addr flash_address)
 void
 CfiMemory::BlockData::erase(PacketPtr pkt)
 {
+    parent.restoreRange(pkt->getAddr(), blockSize);
     auto host_address = parent.toHostAddr(pkt->getAddr());
     std::memset(host_address, 0xff, blockSize);
 }
@@ -0,0 +1,472 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/chunked_store.hh"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "base/logging.hh"
+#include "base/thread_pool.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace chunked_store
+{
+
+namespace
+{
+
+const char magic[8] = {'g', 'e', 'm', '5', 'p', 'm', 'e', 'm'};
+const uint32_t version = 1;
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t size;
+    uint64_t chunkSize;
+    uint64_t numChunks;
+};
+
+static_assert(sizeof(Header) == 40, "Unexpected chunked store header size");
+static_assert(sizeof(IndexEntry) == 16, "Unexpected chunked store index size");
+
+bool
+allZero(const uint8_t *data, uint64_t size)
+{
+    // Compare word by word, the stores are page aligned.
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if (word)
+            return false;
+    }
+    for (; i < size; i++) {
+        if (data[i])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Hash a chunk, used to find chunks that may not have changed. Matching
+ * chunks are still compared byte by byte.
+ */
+uint64_t
+hashChunk(const uint8_t *data, uint64_t size)
+{
+    return (uint64_t)crc32(0, data, size) << 32 | adler32(1, data, size);
+}
+
+bool
+preadAll(int fd, void *buf, size_t len, off_t offset)
+{
+    uint8_t *dst = static_cast<uint8_t *>(buf);
+    while (len) {
+        ssize_t ret = pread(fd, dst, len, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        dst += ret;
+        len -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool
+write(const std::string &path, const uint8_t *data, uint64_t size,
+      uint64_t chunk_size, ThreadPool &pool, const Reader *parent,
+      const std::string &parent_path)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out || chunk_size == 0 || chunk_size > UINT32_MAX)
+        return false;
+
+    // A delta is only possible against a file with the same geometry
+    // that records what its chunks contain.
+    if (parent && (parent->size() != size ||
+                   parent->chunkSize() != chunk_size ||
+                   !parent->hasHashes())) {
+        parent = nullptr;
+    }
+
+    std::string parent_ref;
+    if (parent) {
+        // Refer to the parent relative to this file, so that chains of
+        // checkpoints can be moved around together.
+        namespace fs = std::filesystem;
+        fs::path abs_parent = fs::absolute(parent_path);
+        parent_ref = abs_parent.lexically_relative(
+            fs::absolute(path).parent_path()).string();
+        if (parent_ref.empty())
+            parent_ref = abs_parent.string();
+    }
+
+    Header hdr;
+    std::memcpy(hdr.magic, magic, sizeof(magic));
+    hdr.version = version;
+    hdr.flags = HasHashes | (parent ? HasParent : 0);
+    hdr.size = size;
+    hdr.chunkSize = chunk_size;
+    hdr.numChunks = (size + chunk_size - 1) / chunk_size;
+
+    std::vector<IndexEntry> index(hdr.numChunks);
+    std::vector<uint64_t> hashes(hdr.numChunks);
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    out.write(reinterpret_cast<const char *>(index.data()),
+              index.size() * sizeof(IndexEntry));
+    out.write(reinterpret_cast<const char *>(hashes.data()),
+              hashes.size() * sizeof(uint64_t));
+    if (parent) {
+        uint32_t len = parent_ref.size();
+        out.write(reinterpret_cast<const char *>(&len), sizeof(len));
+        out.write(parent_ref.data(), len);
+    }
+    uint64_t offset = out.tellp();
+
+    // Compress a batch of chunks in parallel, then append them in order.
+    // Batching bounds the memory used for compressed buffers.
+    const size_t batch = pool.size() * 4;
+    std::vector<std::vector<uint8_t>> buffers(batch);
+    for (size_t first = 0; first < hdr.numChunks; first += batch) {
+        size_t count = std::min<size_t>(batch, hdr.numChunks - first);
+
+        pool.parallelFor(count, [&](size_t i) {
+            size_t chunk = first + i;
+            uint64_t start = chunk * chunk_size;
+            uint64_t bytes = std::min(chunk_size, size - start);
+            IndexEntry &entry = index[chunk];
+            std::vector<uint8_t> &buf = buffers[i];
+
+            entry.length = 0;
+            if (allZero(data + start, bytes)) {
+                entry.type = ChunkType::Zero;
+                hashes[chunk] = 0;
+                return;
+            }
+
+            // The hashes only find candidates, they are not collision
+            // resistant, so the parent's data has to match as well
+            hashes[chunk] = hashChunk(data + start, bytes);
+            if (parent && !parent->isZero(chunk) &&
+                    parent->hash(chunk) == hashes[chunk]) {
+                thread_local std::vector<uint8_t> parent_data;
+                parent_data.resize(bytes);
+                if (parent->readChunk(chunk, parent_data.data(), false) &&
+                        std::memcmp(parent_data.data(), data + start,
+                                    bytes) == 0) {
+                    entry.type = ChunkType::Parent;
+                    return;
+                }
+            }
+
+            uLongf len = compressBound(bytes);
+            buf.resize(len);
+            if (compress2(buf.data(), &len, data + start, bytes,
+                          Z_BEST_SPEED) == Z_OK && len < bytes) {
+                entry.type = ChunkType::Deflate;
+                entry.length = len;
+            } else {
+                entry.type = ChunkType::Raw;
+                entry.length = bytes;
+            }
+        });
+
+        for (size_t i = 0; i < count; i++) {
+            IndexEntry &entry = index[first + i];
+            entry.offset = offset;
+            if (entry.type == ChunkType::Deflate) {
+                out.write(reinterpret_cast<const char *>(buffers[i].data()),
+                          entry.length);
+            } else if (entry.type == ChunkType::Raw) {
+                out.write(reinterpret_cast<const char *>(
+                              data + (first + i) * chunk_size),
+                          entry.length);
+            }
+            offset += entry.length;
+        }
+
+        if (!out)
+            return false;
+    }
+
+    out.seekp(sizeof(hdr));
+    out.write(reinterpret_cast<const char *>(index.data()),
+              index.size() * sizeof(IndexEntry));
+    out.write(reinterpret_cast<const char *>(hashes.data()),
+              hashes.size() * sizeof(uint64_t));
+    out.close();
+
+    return !out.fail();
+}
+
+Reader::~Reader()
+{
+    if (fd >= 0)
+        close(fd);
+}
+
+bool
+Reader::isChunked(const std::string &path)
+{
+    std::ifstream f(path, std::ios::binary);
+    char buf[sizeof(magic)];
+    return f.read(buf, sizeof(buf)) &&
+        std::memcmp(buf, magic, sizeof(magic)) == 0;
+}
+
+bool
+Reader::open(const std::string &path, unsigned level)
+{
+    if (level >= maxDepth)
+        return false;
+
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    Header hdr;
+    if (!preadAll(fd, &hdr, sizeof(hdr), 0) ||
+            std::memcmp(hdr.magic, magic, sizeof(magic)) != 0 ||
+            hdr.version != version || hdr.chunkSize == 0 ||
+            hdr.numChunks != (hdr.size + hdr.chunkSize - 1) / hdr.chunkSize) {
+        return false;
+    }
+
+    _size = hdr.size;
+    _chunkSize = hdr.chunkSize;
+    index.resize(hdr.numChunks);
+    off_t pos = sizeof(hdr);
+    if (!preadAll(fd, index.data(), index.size() * sizeof(IndexEntry), pos))
+        return false;
+    pos += index.size() * sizeof(IndexEntry);
+
+    if (hdr.flags & HasHashes) {
+        hashes.resize(hdr.numChunks);
+        if (!preadAll(fd, hashes.data(), hashes.size() * sizeof(uint64_t),
+                      pos)) {
+            return false;
+        }
+        pos += hashes.size() * sizeof(uint64_t);
+    }
+
+    if (hdr.flags & HasParent) {
+        uint32_t len;
+        if (!preadAll(fd, &len, sizeof(len), pos))
+            return false;
+        std::string ref(len, '\0');
+        if (!preadAll(fd, ref.data(), len, pos + sizeof(len)))
+            return false;
+
+        namespace fs = std::filesystem;
+        fs::path parent_path(ref);
+        if (parent_path.is_relative())
+            parent_path = fs::path(path).parent_path() / parent_path;
+
+        parent = std::make_unique<Reader>();
+        if (!parent->open(parent_path.string(), level + 1) ||
+                parent->size() != _size || parent->chunkSize() != _chunkSize) {
+            return false;
+        }
+    }
+
+    // Resolve every chunk to the file holding its data once, rather than
+    // on every read
+    owner.resize(index.size());
+    for (size_t chunk = 0; chunk < index.size(); chunk++) {
+        if (index[chunk].type != ChunkType::Parent) {
+            owner[chunk] = this;
+        } else if (parent) {
+            owner[chunk] = parent->owner[chunk];
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64_t
+Reader::chunkBytes(size_t chunk) const
+{
+    return std::min(_chunkSize, _size - chunk * _chunkSize);
+}
+
+bool
+Reader::readChunk(size_t chunk, uint8_t *dst, bool sparse) const
+{
+    if (owner[chunk] != this)
+        return owner[chunk]->readChunk(chunk, dst, sparse);
+
+    const IndexEntry &entry = index[chunk];
+    const uint64_t bytes = chunkBytes(chunk);
+
+    if (entry.type == ChunkType::Zero) {
+        if (!sparse)
+            std::memset(dst, 0, bytes);
+        return true;
+    }
+
+    // Per-thread buffers so chunks can be read concurrently.
+    thread_local std::vector<uint8_t> compressed;
+    thread_local std::vector<uint8_t> plain;
+
+    uint8_t *target = dst;
+    if (sparse) {
+        plain.resize(bytes);
+        target = plain.data();
+    }
+
+    if (entry.type == ChunkType::Raw) {
+        if (entry.length != bytes ||
+                !preadAll(fd, target, bytes, entry.offset)) {
+            return false;
+        }
+    } else if (entry.type == ChunkType::Deflate) {
+        compressed.resize(entry.length);
+        if (!preadAll(fd, compressed.data(), entry.length, entry.offset))
+            return false;
+        uLongf len = bytes;
+        if (uncompress(target, &len, compressed.data(),
+                       entry.length) != Z_OK || len != bytes) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    if (sparse) {
+        // Only copy the pages that are non-zero, so we don't fault in
+        // pages of the destination that would stay zero anyway.
+        static const uint64_t page = sysconf(_SC_PAGE_SIZE);
+        for (uint64_t off = 0; off < bytes; off += page) {
+            uint64_t len = std::min(page, bytes - off);
+            if (!allZero(target + off, len))
+                std::memcpy(dst + off, target + off, len);
+        }
+    }
+
+    return true;
+}
+
+bool
+Reader::readAll(uint8_t *dst, ThreadPool &pool) const
+{
+    std::atomic<bool> ok{true};
+    pool.parallelFor(numChunks(), [&](size_t chunk) {
+        if (!readChunk(chunk, dst + chunk * _chunkSize, true))
+            ok = false;
+    });
+    return ok;
+}
+
+LazyFill::LazyFill(std::unique_ptr<Reader> _reader, uint8_t *_base,
+                   const std::string &_path)
+    : reader(std::move(_reader)), base(_base), path(_path),
+      filled(new std::atomic<bool>[reader->numChunks()]), remaining(0)
+{
+    // Zero chunks are already in place in a fresh store.
+    size_t pending = 0;
+    for (size_t i = 0; i < reader->numChunks(); i++) {
+        filled[i] = reader->isZero(i);
+        pending += !filled[i];
+    }
+    remaining = pending;
+}
+
+void
+LazyFill::fillChunk(size_t chunk)
+{
+    std::lock_guard<std::mutex> lock(m);
+    if (filled[chunk].load(std::memory_order_relaxed))
+        return;
+
+    fatal_if(!reader->readChunk(chunk, base + chunk * reader->chunkSize(),
+                                true),
+             "Read failed on physical memory checkpoint file '%s'\n", path);
+    filled[chunk].store(true, std::memory_order_release);
+    remaining--;
+}
+
+void
+LazyFill::fillRange(uint64_t offset, uint64_t size)
+{
+    const uint64_t chunk_size = reader->chunkSize();
+    const size_t last = (offset + std::max<uint64_t>(size, 1) - 1) /
+        chunk_size;
+    for (size_t chunk = offset / chunk_size; chunk <= last; chunk++) {
+        if (!filled[chunk].load(std::memory_order_acquire))
+            fillChunk(chunk);
+    }
+}
+
+void
+LazyFill::fillAll(ThreadPool &pool)
+{
+    if (complete())
+        return;
+
+    // Chunks are independent, so the lock is only needed against
+    // concurrent fill() calls from other event queues, which cannot
+    // happen while the simulation is stopped to hand out the store.
+    pool.parallelFor(reader->numChunks(), [this](size_t chunk) {
+        if (filled[chunk].load(std::memory_order_acquire))
+            return;
+        fatal_if(!reader->readChunk(chunk,
+                                    base + chunk * reader->chunkSize(),
+                                    true),
+                 "Read failed on physical memory checkpoint file '%s'\n",
+                 path);
+        filled[chunk].store(true, std::memory_order_release);
+        remaining--;
+    });
+}
+
+} // namespace chunked_store
+} // namespace memory
+} // namespace gem5
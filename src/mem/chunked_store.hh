@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CHUNKED_STORE_HH__
+#define __MEM_CHUNKED_STORE_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * Chunked checkpoint format for backing stores.
+ *
+ * The legacy checkpoint format for a backing store is a single gzip
+ * stream, which has to be produced and consumed sequentially. The
+ * chunked format instead splits the store into fixed size chunks that
+ * are compressed independently, so they can be compressed and
+ * decompressed in parallel and read individually. Chunks that only
+ * contain zeros are recorded in the index without any data.
+ *
+ * Since chunks can be read individually, a restored store can also be
+ * filled lazily, one chunk at a time, when it is first accessed (see
+ * LazyFill).
+ *
+ * A file may also be a delta against a parent file of the same geometry.
+ * Every file records a content hash per chunk. Chunks whose hash matches
+ * the parent, and whose data turns out to be the same, are stored as
+ * references to the parent. Readers
+ * open the chain of parents and resolve such chunks transparently. Each
+ * file of the chain stays open while it is read from, so writers should
+ * bound the length of the chains they create (see Reader::depth()).
+ *
+ * Layout (all integers are stored in host byte order):
+ *
+ * @verbatim
+ *   header: magic[8] version:u32 flags:u32
+ *           size:u64 chunk_size:u64 num_chunks:u64
+ *   index:  { offset:u64 length:u32 type:u32 } * num_chunks
+ *   hashes: { hash:u64 } * num_chunks               (if HasHashes)
+ *   parent: path_len:u32 path[path_len]            (if HasParent)
+ *   data:   compressed chunks
+ * @endverbatim
+ *
+ * The parent path is relative to the directory of the file unless it
+ * is absolute.
+ */
+
+namespace gem5
+{
+
+class ThreadPool;
+
+namespace memory
+{
+
+namespace chunked_store
+{
+
+/** How a chunk is stored in the file. */
+enum class ChunkType : uint32_t
+{
+    Zero = 0,       ///< All zero, no data stored.
+    Deflate = 1,    ///< zlib compressed.
+    Raw = 2,        ///< Stored uncompressed since it did not compress.
+    Parent = 3,     ///< Same as in the parent file, no data stored.
+};
+
+/** Header flags. */
+enum Flags : uint32_t
+{
+    HasHashes = 0x1,
+    HasParent = 0x2,
+};
+
+class Reader;
+
+struct IndexEntry
+{
+    uint64_t offset;
+    uint32_t length;
+    ChunkType type;
+};
+
+/**
+ * Write a backing store to a chunked checkpoint file.
+ *
+ * @param path File to write.
+ * @param data Host pointer to the store.
+ * @param size Size of the store in bytes.
+ * @param chunk_size Size of each independently compressed chunk.
+ * @param pool Host threads used for compression.
+ * @param parent Optional reader for a previous checkpoint of the same
+ *        store. Chunks that did not change since are stored as
+ *        references to it, which makes the new file a delta.
+ * @param parent_path Path of the parent file.
+ * @return False if the file could not be written.
+ */
+bool write(const std::string &path, const uint8_t *data, uint64_t size,
+           uint64_t chunk_size, ThreadPool &pool,
+           const Reader *parent=nullptr,
+           const std::string &parent_path="");
+
+/**
+ * Random access reader for a chunked checkpoint file. Chunks can be
+ * read concurrently from multiple threads.
+ */
+class Reader
+{
+  private:
+    int fd = -1;
+    uint64_t _size = 0;
+    uint64_t _chunkSize = 0;
+    std::vector<IndexEntry> index;
+
+    /** Content hash per chunk, empty for files written without. */
+    std::vector<uint64_t> hashes;
+
+    /** Reader for the parent of a delta file. */
+    std::unique_ptr<Reader> parent;
+
+    /**
+     * Reader of the chain holding the data of each chunk, i.e., this one
+     * or one of its ancestors, so reading a chunk never walks the chain.
+     */
+    std::vector<const Reader *> owner;
+
+    /** Open a file at the given depth of a chain. */
+    bool open(const std::string &path, unsigned level);
+
+  public:
+    /**
+     * Longest chain of files a reader opens. Writers are expected to
+     * keep chains much shorter; this only stops corrupt or cyclic
+     * parent references.
+     */
+    static constexpr unsigned maxDepth = 64;
+
+    Reader() = default;
+    ~Reader();
+
+    Reader(const Reader &) = delete;
+    Reader &operator=(const Reader &) = delete;
+
+    /** Open a file, its chain of parents, and read their indices. */
+    bool open(const std::string &path) { return open(path, 0); }
+
+    /** Check whether the given file is a chunked checkpoint. */
+    static bool isChunked(const std::string &path);
+
+    uint64_t size() const { return _size; }
+    uint64_t chunkSize() const { return _chunkSize; }
+    size_t numChunks() const { return index.size(); }
+
+    /** Size in bytes of the given chunk; only the last may be short. */
+    uint64_t chunkBytes(size_t chunk) const;
+
+    ChunkType chunkType(size_t chunk) const { return index[chunk].type; }
+
+    bool
+    isZero(size_t chunk) const
+    {
+        return owner[chunk]->index[chunk].type == ChunkType::Zero;
+    }
+
+    /** Whether the file records chunk hashes, needed to be a parent. */
+    bool hasHashes() const { return !hashes.empty(); }
+
+    /** Content hash of a chunk, only valid if hasHashes(). */
+    uint64_t hash(size_t chunk) const { return hashes[chunk]; }
+
+    /** Number of files in the chain, including this one. */
+    unsigned
+    depth() const
+    {
+        return 1 + (parent ? parent->depth() : 0);
+    }
+
+    /**
+     * Decompress a chunk.
+     *
+     * @param chunk Chunk number.
+     * @param dst Destination, chunkBytes(chunk) long.
+     * @param sparse Only write the host pages that are non-zero, which
+     *        avoids faulting in untouched pages of a fresh mapping. The
+     *        destination must then already be zero.
+     * @return False if the chunk could not be read.
+     */
+    bool readChunk(size_t chunk, uint8_t *dst, bool sparse) const;
+
+    /**
+     * Decompress the whole store in parallel. The destination must be
+     * zero filled; zero chunks and zero pages are not written.
+     */
+    bool readAll(uint8_t *dst, ThreadPool &pool) const;
+};
+
+/**
+ * Fills a backing store from a chunked checkpoint on demand.
+ *
+ * Everything that accesses the store through a host pointer has to call
+ * fill() for the bytes it is about to touch first, which decompresses the
+ * chunks covering them on first use. Writes to chunks that have not been
+ * filled yet would otherwise be overwritten by the fill. Consumers that
+ * need the whole store, such as KVM or a new checkpoint, call fillAll().
+ *
+ * The store must be zero when the fill is created, which is the case for
+ * a freshly mapped backing store. Chunks can be filled concurrently from
+ * multiple event queues.
+ */
+class LazyFill
+{
+  private:
+    const std::unique_ptr<Reader> reader;
+    uint8_t *const base;
+    const std::string path;
+
+    /** Per chunk flag, set once the chunk holds its checkpoint data. */
+    std::unique_ptr<std::atomic<bool>[]> filled;
+    /** Chunks that still need to be filled. */
+    std::atomic<size_t> remaining;
+
+    std::mutex m;
+
+    void fillChunk(size_t chunk);
+    void fillRange(uint64_t offset, uint64_t size);
+
+  public:
+    /**
+     * @param reader An opened reader for the checkpoint.
+     * @param base Host pointer to the (zero filled) backing store.
+     * @param path Name of the checkpoint file, for error messages.
+     */
+    LazyFill(std::unique_ptr<Reader> reader, uint8_t *base,
+             const std::string &path);
+
+    /** Whether every chunk has been filled. */
+    bool
+    complete() const
+    {
+        return remaining.load(std::memory_order_acquire) == 0;
+    }
+
+    /** Number of chunks that have not been filled yet. */
+    size_t pending() const { return remaining; }
+
+    /** Make sure the given host bytes hold their checkpoint data. */
+    void
+    fill(const uint8_t *host_addr, uint64_t size)
+    {
+        if (!complete())
+            fillRange(host_addr - base, size);
+    }
+
+    /** Fill all remaining chunks in parallel and close the checkpoint. */
+    void fillAll(ThreadPool &pool);
+};
+
+} // namespace chunked_store
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_CHUNKED_STORE_HH__
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/thread_pool.hh"
+#include "mem/chunked_store.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+class ChunkedStoreTest : public testing::Test
+{
+  protected:
+    std::string path;
+    ThreadPool pool{4};
+
+    void
+    SetUp() override
+    {
+        char name[] = "/tmp/chunked_store.test.XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override { std::remove(path.c_str()); }
+
+    /** A store with compressible, incompressible and zero chunks. */
+    static std::vector<uint8_t>
+    makeStore(size_t size)
+    {
+        std::vector<uint8_t> store(size, 0);
+        uint32_t lfsr = 0xace1;
+        for (size_t i = 0; i < size; i++) {
+            size_t chunk = i / 4096;
+            if (chunk % 3 == 0) {
+                store[i] = i & 0x7;
+            } else if (chunk % 3 == 1) {
+                lfsr = lfsr * 1103515245 + 12345;
+                store[i] = lfsr >> 16;
+            }
+        }
+        return store;
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(ChunkedStoreTest, RoundTrip)
+{
+    // Not a multiple of the chunk size to exercise a short last chunk.
+    auto store = makeStore(4096 * 10 + 123);
+    ASSERT_TRUE(chunked_store::write(path, store.data(), store.size(),
+                                     4096, pool));
+    ASSERT_TRUE(chunked_store::Reader::isChunked(path));
+
+    chunked_store::Reader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.size(), store.size());
+    EXPECT_EQ(reader.chunkSize(), 4096u);
+    ASSERT_EQ(reader.numChunks(), 11u);
+    EXPECT_EQ(reader.chunkBytes(10), 123u);
+
+    EXPECT_FALSE(reader.isZero(0));
+    EXPECT_FALSE(reader.isZero(1));
+    EXPECT_TRUE(reader.isZero(2));
+
+    std::vector<uint8_t> restored(store.size(), 0);
+    ASSERT_TRUE(reader.readAll(restored.data(), pool));
+    EXPECT_EQ(restored, store);
+}
+
+TEST_F(ChunkedStoreTest, ReadChunk)
+{
+    auto store = makeStore(4096 * 4);
+    ASSERT_TRUE(chunked_store::write(path, store.data(), store.size(),
+                                     4096, pool));
+
+    chunked_store::Reader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    std::vector<uint8_t> chunk(4096, 0xff);
+    for (size_t i = 0; i < reader.numChunks(); i++) {
+        ASSERT_TRUE(reader.readChunk(i, chunk.data(), false));
+        EXPECT_EQ(std::memcmp(chunk.data(), store.data() + i * 4096, 4096),
+                  0);
+    }
+}
+
+TEST_F(ChunkedStoreTest, LazyFill)
+{
+    auto store = makeStore(4096 * 6);
+    ASSERT_TRUE(chunked_store::write(path, store.data(), store.size(),
+                                     4096, pool));
+
+    auto reader = std::make_unique<chunked_store::Reader>();
+    ASSERT_TRUE(reader->open(path));
+
+    std::vector<uint8_t> restored(store.size(), 0);
+    chunked_store::LazyFill fill(std::move(reader), restored.data(), path);
+
+    // Chunks 2 and 5 are zero and need no filling.
+    EXPECT_EQ(fill.pending(), 4u);
+    EXPECT_FALSE(fill.complete());
+
+    // An access straddling chunks 0 and 1 fills both, and nothing else.
+    fill.fill(restored.data() + 4090, 12);
+    EXPECT_EQ(fill.pending(), 2u);
+    EXPECT_EQ(std::memcmp(restored.data(), store.data(), 4096 * 2), 0);
+    EXPECT_NE(std::memcmp(restored.data() + 4096 * 3,
+                          store.data() + 4096 * 3, 4096), 0);
+
+    fill.fillAll(pool);
+    EXPECT_TRUE(fill.complete());
+    EXPECT_EQ(restored, store);
+}
+
+TEST_F(ChunkedStoreTest, Delta)
+{
+    auto store = makeStore(4096 * 6);
+    ASSERT_TRUE(chunked_store::write(path, store.data(), store.size(),
+                                     4096, pool));
+    chunked_store::Reader base;
+    ASSERT_TRUE(base.open(path));
+    ASSERT_TRUE(base.hasHashes());
+
+    // Change one chunk, clear another and fill a zero one.
+    store[4096 * 1 + 17] ^= 0x5a;
+    std::memset(store.data() + 4096 * 3, 0, 4096);
+    std::memset(store.data() + 4096 * 5, 0x11, 4096);
+
+    std::string delta_path = path + ".delta";
+    ASSERT_TRUE(chunked_store::write(delta_path, store.data(), store.size(),
+                                     4096, pool, &base, path));
+
+    chunked_store::Reader delta;
+    ASSERT_TRUE(delta.open(delta_path));
+    EXPECT_EQ(delta.depth(), 2u);
+    EXPECT_EQ(delta.chunkType(0), chunked_store::ChunkType::Parent);
+    EXPECT_NE(delta.chunkType(1), chunked_store::ChunkType::Parent);
+    EXPECT_EQ(delta.chunkType(2), chunked_store::ChunkType::Zero);
+    EXPECT_EQ(delta.chunkType(3), chunked_store::ChunkType::Zero);
+    EXPECT_EQ(delta.chunkType(4), chunked_store::ChunkType::Parent);
+    EXPECT_NE(delta.chunkType(5), chunked_store::ChunkType::Parent);
+
+    std::vector<uint8_t> restored(store.size(), 0);
+    ASSERT_TRUE(delta.readAll(restored.data(), pool));
+    EXPECT_EQ(restored, store);
+
+    // A delta is useless without its parent.
+    std::remove(path.c_str());
+    chunked_store::Reader orphan;
+    EXPECT_FALSE(orphan.open(delta_path));
+    std::remove(delta_path.c_str());
+}
+
+/** Chunks with the same hash as the parent but other data are stored. */
+TEST_F(ChunkedStoreTest, DeltaHashCollision)
+{
+    auto store = makeStore(4096 * 3);
+    ASSERT_TRUE(chunked_store::write(path, store.data(), store.size(),
+                                     4096, pool));
+
+    // Find the hash of a changed chunk, and make the parent record it
+    // for its own chunk, as if the two collided
+    auto changed = store;
+    changed[4096 * 1 + 17] ^= 0x5a;
+    std::string changed_path = path + ".changed";
+    ASSERT_TRUE(chunked_store::write(changed_path, changed.data(),
+                                     changed.size(), 4096, pool));
+    uint64_t changed_hash;
+    {
+        chunked_store::Reader reader;
+        ASSERT_TRUE(reader.open(changed_path));
+        changed_hash = reader.hash(1);
+    }
+    std::remove(changed_path.c_str());
+    {
+        std::fstream f(path, std::ios::binary | std::ios::in |
+                       std::ios::out);
+        f.seekp(40 + 3 * sizeof(chunked_store::IndexEntry) +
+                1 * sizeof(uint64_t));
+        f.write(reinterpret_cast<const char *>(&changed_hash),
+                sizeof(changed_hash));
+        ASSERT_TRUE(f.good());
+    }
+
+    chunked_store::Reader base;
+    ASSERT_TRUE(base.open(path));
+    ASSERT_EQ(base.hash(1), changed_hash);
+
+    std::string delta_path = path + ".delta";
+    ASSERT_TRUE(chunked_store::write(delta_path, changed.data(),
+                                     changed.size(), 4096, pool, &base,
+                                     path));
+
+    chunked_store::Reader delta;
+    ASSERT_TRUE(delta.open(delta_path));
+    EXPECT_EQ(delta.chunkType(0), chunked_store::ChunkType::Parent);
+    EXPECT_NE(delta.chunkType(1), chunked_store::ChunkType::Parent);
+
+    std::vector<uint8_t> restored(changed.size(), 0);
+    ASSERT_TRUE(delta.readAll(restored.data(), pool));
+    EXPECT_EQ(restored, changed);
+    std::remove(delta_path.c_str());
+}
+
+TEST_F(ChunkedStoreTest, DeltaChain)
+{
+    // Each delta changes one chunk, so the chunks of the last one are
+    // spread over every file of the chain.
+    auto store = makeStore(4096 * 6);
+    std::vector<std::string> files = {path};
+    ASSERT_TRUE(chunked_store::write(path, store.data(), store.size(),
+                                     4096, pool));
+    for (size_t i = 1; i < 4; i++) {
+        chunked_store::Reader parent;
+        ASSERT_TRUE(parent.open(files.back()));
+        store[4096 * i + 5] ^= 0xff;
+        files.push_back(path + ".delta" + std::to_string(i));
+        ASSERT_TRUE(chunked_store::write(files.back(), store.data(),
+                                         store.size(), 4096, pool, &parent,
+                                         files[i - 1]));
+    }
+
+    chunked_store::Reader last;
+    ASSERT_TRUE(last.open(files.back()));
+    EXPECT_EQ(last.depth(), 4u);
+
+    std::vector<uint8_t> restored(store.size(), 0);
+    ASSERT_TRUE(last.readAll(restored.data(), pool));
+    EXPECT_EQ(restored, store);
+
+    std::vector<uint8_t> chunk(4096);
+    for (size_t i = 0; i < last.numChunks(); i++) {
+        std::fill(chunk.begin(), chunk.end(), 0);
+        ASSERT_TRUE(last.readChunk(i, chunk.data(), false));
+        EXPECT_TRUE(std::equal(chunk.begin(), chunk.end(),
+                               store.begin() + 4096 * i));
+    }
+
+    for (size_t i = 1; i < files.size(); i++)
+        std::remove(files[i].c_str());
+}
+
+TEST_F(ChunkedStoreTest, CyclicDelta)
+{
+    // A delta that refers to itself must not be followed forever.
+    auto store = makeStore(4096 * 2);
+    ASSERT_TRUE(chunked_store::write(path, store.data(), store.size(),
+                                     4096, pool));
+    {
+        chunked_store::Reader parent;
+        ASSERT_TRUE(parent.open(path));
+        ASSERT_TRUE(chunked_store::write(path, store.data(), store.size(),
+                                         4096, pool, &parent, path));
+    }
+
+    chunked_store::Reader cyclic;
+    EXPECT_FALSE(cyclic.open(path));
+}
+
+TEST_F(ChunkedStoreTest, NotChunked)
+{
+    FILE *f = fopen(path.c_str(), "w");
+    ASSERT_NE(f, nullptr);
+    fputs("not a chunked store", f);
+    fclose(f);
+
+    chunked_store::Reader reader;
+    EXPECT_FALSE(chunked_store::Reader::isChunked(path));
+    EXPECT_FALSE(reader.open(path));
+}
@@ -62,6 +62,8 @@ CoherentXBar::CoherentXBar(const CoherentXBarParams &p)
       maxRoutingTableSizeCheck(p.max_routing_table_size),
       pointOfCoherency(p.point_of_coherency),
       pointOfUnification(p.point_of_unification),
+      backInvalidateEvent([this]{ backInvalidate(); },
+                          name() + ".backInvalidate"),
 
       ADD_STAT(snoops, statistics::units::Count::get(), "Total snoops"),
       ADD_STAT(snoopTraffic, statistics::units::Byte::get(), "Total snoop traffic"),
@@ -181,6 +183,11 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     // store the old header delay so we can restore it if needed
     Tick old_header_delay = pkt->headerDelay;
 
+    // a WriteClean with the dirty data of a line the snoop filter
+    // back-invalidated stops at the memory below
+    const bool back_inval_write = pkt->cmd == MemCmd::WriteClean &&
+        backInvalidationWrites.count(pkt->id);
+
     // a request sees the frontend and forward latency
     Tick xbar_delay = (frontendLatency + forwardLatency) * clockPeriod();
 
@@ -285,7 +292,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
             // make sure that the write request (e.g., WriteClean)
             // will stop at the memory below if this crossbar is its
             // destination
-            if (pkt->isWrite() && is_destination) {
+            if (pkt->isWrite() && (is_destination || back_inval_write)) {
                 pkt->clearWriteThrough();
             }
 
@@ -305,6 +312,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     if (snoopFilter && snoop_caches) {
         // Let the snoop filter know about the success of the send operation
         snoopFilter->finishRequest(!success, addr, pkt->isSecure());
+        scheduleBackInvalidate();
     }
 
     // check if we were successful in sending the packet onwards
@@ -361,6 +369,10 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
             snoops++;
             snoopTraffic += pkt_size;
         }
+
+        if (back_inval_write) {
+            backInvalidationWrites.erase(pkt->id);
+        }
     }
 
     if (sink_packet)
@@ -384,7 +396,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     if (success &&
         ((pkt->isClean() && pkt->satisfied()) ||
          pkt->cmd == MemCmd::WriteClean) &&
-        is_destination) {
+        is_destination && !back_inval_write) {
         PacketPtr deferred_rsp = pkt->isWrite() ? nullptr : pkt;
         auto cmo_lookup = outstandingCMO.find(pkt->id);
         if (cmo_lookup != outstandingCMO.end()) {
@@ -428,6 +440,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
         if (snoopFilter && !system->bypassCaches()) {
             // let the snoop filter inspect the response and update its state
             snoopFilter->updateResponse(rsp_pkt, *cpuSidePorts[rsp_port_id]);
+            scheduleBackInvalidate();
         }
 
         // we send the response after the current packet, even if the
@@ -484,6 +497,7 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     if (snoopFilter && !system->bypassCaches()) {
         // let the snoop filter inspect the response and update its state
         snoopFilter->updateResponse(pkt, *cpuSidePorts[cpu_side_port_id]);
+        scheduleBackInvalidate();
     }
 
     // send the packet through the destination CPU-side port and pay for
@@ -724,6 +738,49 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
     snoopFanout.sample(fanout);
 }
 
+void
+CoherentXBar::backInvalidate()
+{
+    for (const auto &victim : snoopFilter->takeBackInvalidations()) {
+        // Cleaning to the point of coherency makes any dirty copy
+        // travel as a write-through WriteClean, so caches between the
+        // holder and this crossbar do not allocate it on the way
+        Request::Flags flags = Request::CLEAN | Request::INVALIDATE |
+            Request::DST_POC;
+        if (victim.secure) {
+            flags.set(Request::SECURE);
+        }
+        RequestPtr req = makeRequestPtr(victim.addr, system->cacheLineSize(),
+                                        flags, snoopFilter->getRequestorId());
+
+        Packet pkt(req, MemCmd::CleanInvalidReq);
+        pkt.setExpressSnoop();
+        pkt.setBackInvalidation();
+
+        DPRINTF(CoherentXBar, "%s: %s to %d holders\n", __func__,
+                pkt.print(), victim.ports.size());
+
+        // in atomic mode the WriteClean passes by while snooping
+        backInvalidationWrites.emplace(pkt.id, req);
+        for (const auto &p : victim.ports) {
+            if (system->isTimingMode()) {
+                p->sendTimingSnoopReq(&pkt);
+            } else {
+                p->sendAtomicSnoop(&pkt);
+            }
+        }
+        snoopFanout.sample(victim.ports.size());
+
+        // caches do not respond to cache maintenance operations, but
+        // write back a dirty copy and mark the operation satisfied
+        panic_if(pkt.cacheResponding(), "%s: %s got a response\n",
+                 name(), pkt.print());
+        if (!pkt.satisfied()) {
+            backInvalidationWrites.erase(pkt.id);
+        }
+    }
+}
+
 void
 CoherentXBar::recvReqRetry(PortID mem_side_port_id)
 {
@@ -752,6 +809,11 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
     // the request
     const bool is_destination = isDestination(pkt);
 
+    // a WriteClean with the dirty data of a line the snoop filter
+    // back-invalidated stops at the memory below
+    const bool back_inval_write = pkt->cmd == MemCmd::WriteClean &&
+        backInvalidationWrites.erase(pkt->id);
+
     const bool snoop_caches = !system->bypassCaches() &&
         pkt->cmd != MemCmd::WriteClean;
     if (snoop_caches) {
@@ -772,6 +834,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
             // avoid situations where atomic upward snoops sneak in
             // between and change the filter state
             snoopFilter->finishRequest(false, pkt->getAddr(), pkt->isSecure());
+            scheduleBackInvalidate();
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -809,7 +872,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
             // make sure that the write request (e.g., WriteClean)
             // will stop at the memory below if this crossbar is its
             // destination
-            if (pkt->isWrite() && is_destination) {
+            if (pkt->isWrite() && (is_destination || back_inval_write)) {
                 pkt->clearWriteThrough();
             }
 
@@ -835,6 +898,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
     // if lower levels have replied, tell the snoop filter
     if (!system->bypassCaches() && snoopFilter && pkt->isResponse()) {
         snoopFilter->updateResponse(pkt, *cpuSidePorts[cpu_side_port_id]);
+        scheduleBackInvalidate();
     }
 
     // if we got a response from a snooper, restore it here
@@ -859,7 +923,8 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
         assert(it != outstandingCMO.end());
         // we are responding right away
         outstandingCMO.erase(it);
-    } else if (pkt->cmd == MemCmd::WriteClean && isDestination(pkt)) {
+    } else if (pkt->cmd == MemCmd::WriteClean && isDestination(pkt) &&
+               !back_inval_write) {
         // if this is the destination of the operation, the xbar
         // sends the responce to the cache clean operation only
         // after having encountered the cache clean request
@@ -1014,6 +1079,12 @@ CoherentXBar::recvFunctional(PacketPtr pkt, PortID cpu_side_port_id)
                 cpuSidePorts[cpu_side_port_id]->name(), pkt->print());
     }
 
+    // a cache restoring warm state keeps the block it is reading
+    if (snoopFilter && pkt->isWarmFill()) {
+        snoopFilter->updateWarmFill(pkt, *cpuSidePorts[cpu_side_port_id]);
+        scheduleBackInvalidate();
+    }
+
     if (!system->bypassCaches()) {
         // forward to all snoopers but the source
         forwardFunctional(pkt, cpu_side_port_id);
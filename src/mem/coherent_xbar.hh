@@ -274,6 +274,14 @@ class CoherentXBar : public BaseXBar
      */
     std::unordered_map<PacketId, PacketPtr> outstandingCMO;
 
+    /**
+     * Store the back-invalidations that found a dirty copy, keeping
+     * their requests alive, until the WriteClean with the dirty data
+     * passes by. Such a WriteClean ends at the memory below this
+     * crossbar, rather than at the point of coherency.
+     */
+    std::unordered_map<PacketId, RequestPtr> backInvalidationWrites;
+
     /**
      * Keep a pointer to the system to be allow to querying memory system
      * properties.
@@ -299,6 +307,26 @@ class CoherentXBar : public BaseXBar
     /** Is this crossbar the point of unification? **/
     const bool pointOfUnification;
 
+    /**
+     * Invalidate the copies of the lines the snoop filter evicted, by
+     * sending their holders a cache clean and invalidate as an express
+     * snoop.
+     */
+    void backInvalidate();
+
+    /** Event to back-invalidate the lines the snoop filter evicted. */
+    EventFunctionWrapper backInvalidateEvent;
+
+    /** Schedule a back-invalidation if the snoop filter evicted lines. */
+    void
+    scheduleBackInvalidate()
+    {
+        if (snoopFilter->needsBackInvalidation() &&
+            !backInvalidateEvent.scheduled()) {
+            schedule(backInvalidateEvent, clockEdge());
+        }
+    }
+
     /**
      * Upstream caches need this packet until true is returned, so
      * hold it for deletion until a subsequent call
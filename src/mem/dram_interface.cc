@@ -282,14 +282,15 @@ DRAMInterface::activateBank(Rank& rank_ref, Bank& bank_ref,
 
 void
 DRAMInterface::prechargeBank(Rank& rank_ref, Bank& bank, Tick pre_tick,
-                             bool auto_or_preall, bool trace)
+                             bool auto_or_preall, bool trace, bool sample)
 {
     // make sure the bank has an open row
     assert(bank.openRow != Bank::NO_ROW);
 
     // sample the bytes per activate here since we are closing
     // the page
-    stats.bytesPerActivate.sample(bank.bytesAccessed);
+    if (sample)
+        stats.bytesPerActivate.sample(bank.bytesAccessed);
 
     bank.openRow = Bank::NO_ROW;
 
@@ -1354,15 +1355,24 @@ DRAMInterface::Rank::processRefreshEvent()
             // already are, update their availability
             Tick act_allowed_at = pre_at + dram.tRP;
 
+            // every open page closes at once, so sample their bytes
+            // per activate as a single batch
+            std::vector<Counter> bytes_per_activate;
+            bytes_per_activate.reserve(banks.size());
+
             for (auto &b : banks) {
                 if (b.openRow != Bank::NO_ROW) {
-                    dram.prechargeBank(*this, b, pre_at, true, false);
+                    bytes_per_activate.push_back(b.bytesAccessed);
+                    dram.prechargeBank(*this, b, pre_at, true, false, false);
                 } else {
                     b.actAllowedAt = std::max(b.actAllowedAt, act_allowed_at);
                     b.preAllowedAt = std::max(b.preAllowedAt, pre_at);
                 }
             }
 
+            dram.stats.bytesPerActivate.sampleN(bytes_per_activate.data(),
+                                                bytes_per_activate.size());
+
             // precharge all banks in rank
             cmdList.push_back(Command(MemCommand::PREA, 0, pre_at));
 
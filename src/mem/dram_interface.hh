@@ -571,10 +571,12 @@ class DRAMInterface : public MemInterface
      * @param pre_tick Time when the precharge takes place
      * @param auto_or_preall Is this an auto-precharge or precharge all command
      * @param trace Is this an auto precharge then do not add to trace
+     * @param sample Sample bytesPerActivate here; a precharge all
+     *               samples every open bank in one batch instead
      */
     void prechargeBank(Rank& rank_ref, Bank& bank_ref,
                        Tick pre_tick, bool auto_or_preall = false,
-                       bool trace = true);
+                       bool trace = true, bool sample = true);
 
     struct DRAMStats : public statistics::Group
     {
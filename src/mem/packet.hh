@@ -59,6 +59,7 @@
 #include "base/flags.hh"
 #include "base/logging.hh"
 #include "base/printable.hh"
+#include "base/slab_pool.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
 #include "mem/request.hh"
@@ -353,6 +354,9 @@ class Packet : public Printable, public Extensible<Packet>
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// Set together with DYNAMIC_DATA when the data was allocated
+        /// from the packet data pools rather than with new [].
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -360,11 +364,53 @@ class Packet : public Printable, public Extensible<Packet>
 
         // Signal block present to squash prefetch and cache evict packets
         // through express snoop flag
-        BLOCK_CACHED          = 0x00010000
+        BLOCK_CACHED          = 0x00010000,
+
+        /// Functional read of a block that a cache installs while
+        /// restoring warm state from a checkpoint; snoop filters record
+        /// the requesting cache as a holder, and caches holding the
+        /// block mark it shared.
+        WARM_FILL              = 0x00020000,
+
+        /// Cache clean and invalidate snoop a finite snoop filter sends
+        /// to the holders of a line it evicted; a dirty copy queued for
+        /// writeback is written back as a WriteClean.
+        BACK_INVALIDATION      = 0x00040000
     };
 
     Flags flags;
 
+    /** Largest payload allocated from the packet data pools */
+    static constexpr unsigned maxPooledDataSize = 128;
+
+    /**
+     * Allocate a payload from the pool of the smallest size class that
+     * fits it. The payload size does not change once a packet has data,
+     * so it selects the same pool when the payload is freed.
+     */
+    static PacketDataPtr
+    allocatePooledData(unsigned size)
+    {
+        if (size <= 16)
+            return (PacketDataPtr)SlabPool<16>::allocate();
+        else if (size <= 64)
+            return (PacketDataPtr)SlabPool<64>::allocate();
+        else
+            return (PacketDataPtr)SlabPool<maxPooledDataSize>::allocate();
+    }
+
+    /** Return a payload obtained from allocatePooledData(). */
+    static void
+    freePooledData(PacketDataPtr p, unsigned size)
+    {
+        if (size <= 16)
+            SlabPool<16>::deallocate(p);
+        else if (size <= 64)
+            SlabPool<64>::deallocate(p);
+        else
+            SlabPool<maxPooledDataSize>::deallocate(p);
+    }
+
   public:
     typedef MemCmd::Command Command;
 
@@ -759,6 +805,10 @@ class Packet : public Printable, public Extensible<Packet>
     void setBlockCached()          { flags.set(BLOCK_CACHED); }
     bool isBlockCached() const     { return flags.isSet(BLOCK_CACHED); }
     void clearBlockCached()        { flags.clear(BLOCK_CACHED); }
+    void setWarmFill()             { flags.set(WARM_FILL); }
+    bool isWarmFill() const        { return flags.isSet(WARM_FILL); }
+    void setBackInvalidation()     { flags.set(BACK_INVALIDATION); }
+    bool isBackInvalidation() const { return flags.isSet(BACK_INVALIDATION); }
 
     /**
      * QoS Value getter
@@ -1054,6 +1104,25 @@ class Packet : public Printable, public Extensible<Packet>
         deleteData();
     }
 
+    /**
+     * Packets are allocated from a per-thread pool as they are created
+     * and destroyed for almost every memory access.
+     * @{
+     */
+    static void *
+    operator new(std::size_t size)
+    {
+        assert(size == sizeof(Packet));
+        return SlabPool<sizeof(Packet)>::allocate();
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        SlabPool<sizeof(Packet)>::deallocate(p);
+    }
+    /** @} */
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1355,10 +1424,12 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA))
+            freePooledData(data, getSize());
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1371,7 +1442,13 @@ class Packet : public Printable, public Extensible<Packet>
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            if (getSize() <= maxPooledDataSize) {
+                // Payloads up to a cache line or two come from pools
+                flags.set(POOLED_DATA);
+                data = allocatePooledData(getSize());
+            } else {
+                data = new uint8_t[getSize()];
+            }
         }
     }
 
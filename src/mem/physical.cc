@@ -39,6 +39,7 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
@@ -47,14 +48,19 @@
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <string>
 
 #include "base/intmath.hh"
+#include "base/thread_pool.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/chunked_store.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -70,19 +76,111 @@
 #endif
 #endif
 
+/**
+ * Memory policies for the mbind system call, as defined in
+ * linux/mempolicy.h. The system call is used directly rather than
+ * through libnuma to avoid the dependency.
+ */
+#if defined(__linux__) && defined(SYS_mbind)
+#define GEM5_MPOL_BIND 2
+#define GEM5_MPOL_INTERLEAVE 3
+#endif
+
 namespace gem5
 {
 
 namespace memory
 {
 
+namespace
+{
+
+/**
+ * Get the default size of the pages in the hugetlb pool of the host.
+ *
+ * @return Huge page size in bytes, or 0 if not known
+ */
+uint64_t
+hostHugePageSize()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    uint64_t kbytes;
+    while (meminfo >> key) {
+        if (key == "Hugepagesize:" && meminfo >> kbytes)
+            return kbytes * 1024;
+        meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return 0;
+}
+
+/**
+ * Ask the host kernel to back a mapping with transparent huge pages.
+ *
+ * @return Whether the advice was accepted
+ */
+bool
+adviseHugePages(uint8_t *pmem, uint64_t size)
+{
+#if defined(MADV_HUGEPAGE)
+    return madvise(pmem, size, MADV_HUGEPAGE) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Set the NUMA memory policy of a mapping before it is first touched.
+ *
+ * @param pmem Start of the mapping
+ * @param size Size of the mapping
+ * @param interleave Interleave across the nodes rather than bind
+ * @param nodes Host nodes to use
+ * @return Whether the policy was applied
+ */
+bool
+placeOnNodes(uint8_t *pmem, uint64_t size, bool interleave,
+             const std::vector<unsigned> &nodes)
+{
+#if defined(GEM5_MPOL_BIND)
+    constexpr unsigned bits = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> mask;
+    for (auto node : nodes) {
+        if (node / bits >= mask.size())
+            mask.resize(node / bits + 1, 0);
+        mask[node / bits] |= 1UL << (node % bits);
+    }
+    // the kernel ignores the last bit of the mask, hence the + 1
+    return syscall(SYS_mbind, pmem, size,
+                   interleave ? GEM5_MPOL_INTERLEAVE : GEM5_MPOL_BIND,
+                   mask.data(), mask.size() * bits + 1, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               uint64_t checkpoint_chunk_size,
+                               unsigned checkpoint_threads,
+                               bool lazy_restore,
+                               bool delta_checkpoints,
+                               unsigned delta_max_chain,
+                               HostHugePages huge_pages,
+                               HostNumaPolicy numa_policy,
+                               const std::vector<unsigned> &numa_nodes) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
+    checkpointChunkSize(checkpoint_chunk_size),
+    checkpointThreads(checkpoint_threads), lazyRestore(lazy_restore),
+    deltaCheckpoints(delta_checkpoints), deltaMaxChain(delta_max_chain),
+    hugePages(huge_pages), numaPolicy(numa_policy), numaNodes(numa_nodes),
+    hugePageBytes(0), numaPlacedBytes(0),
     pageSize(sysconf(_SC_PAGE_SIZE))
 {
     // Register cleanup callback if requested.
@@ -93,6 +191,10 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+    fatal_if(numaPolicy != HostNumaPolicy::local && numaNodes.empty(),
+             "%s: NUMA placement of the backing store needs host nodes\n",
+             name());
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -238,9 +340,30 @@ PhysicalMemory::createBackingStore(
         map_flags |= MAP_NORESERVE;
     }
 
-    uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
-                                    PROT_READ | PROT_WRITE,
-                                    map_flags, shm_fd, map_offset);
+    uint8_t* pmem = (uint8_t*) MAP_FAILED;
+    bool huge_mapped = false;
+
+    // the hugetlb pool can only back private mappings that are a
+    // multiple of the huge page size, anything else is left to
+    // transparent huge pages
+    if (hugePages == HostHugePages::hugetlb) {
+#if defined(MAP_HUGETLB)
+        uint64_t huge_size = hostHugePageSize();
+        if (shm_fd == -1 && huge_size && range.size() % huge_size == 0) {
+            pmem = (uint8_t*) mmap(NULL, range.size(),
+                                   PROT_READ | PROT_WRITE,
+                                   map_flags | MAP_HUGETLB, -1, 0);
+            huge_mapped = pmem != (uint8_t*) MAP_FAILED;
+        }
+#endif
+        warn_if(!huge_mapped, "Could not map range %s from the hugetlb "
+                "pool, using transparent huge pages\n", range.to_string());
+    }
+
+    if (!huge_mapped) {
+        pmem = (uint8_t*) mmap(NULL, range.size(), PROT_READ | PROT_WRITE,
+                               map_flags, shm_fd, map_offset);
+    }
 
     if (pmem == (uint8_t*) MAP_FAILED) {
         perror("mmap");
@@ -248,11 +371,39 @@ PhysicalMemory::createBackingStore(
               range.to_string());
     }
 
+    if (!huge_mapped && hugePages != HostHugePages::none) {
+        huge_mapped = adviseHugePages(pmem, range.size());
+        warn_if(!huge_mapped, "Host does not support transparent huge "
+                "pages for range %s\n", range.to_string());
+    }
+    if (huge_mapped)
+        hugePageBytes += range.size();
+
+    // the policy has to be in place before the memory is touched, as
+    // pages are placed when they are first faulted in
+    if (numaPolicy != HostNumaPolicy::local) {
+        bool interleave = numaPolicy == HostNumaPolicy::interleave;
+        std::vector<unsigned> nodes = interleave ? numaNodes :
+            std::vector<unsigned>{
+                numaNodes[backingStore.size() % numaNodes.size()]};
+        if (placeOnNodes(pmem, range.size(), interleave, nodes)) {
+            numaPlacedBytes += range.size();
+            DPRINTF(AddrRanges, "Placed backing store for range %s on "
+                    "host nodes %s\n", range.to_string(),
+                    interleave ? "(interleaved)" : std::to_string(nodes[0]));
+        } else {
+            warn("Could not place range %s on the requested host NUMA "
+                 "nodes\n", range.to_string());
+        }
+    }
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map,
                               shm_fd, map_offset);
+    storeMemories.push_back(_memories);
+    lastStoreFile.emplace_back();
 
     // point the memories to their backing store
     for (const auto& m : _memories) {
@@ -264,11 +415,29 @@ PhysicalMemory::createBackingStore(
 
 PhysicalMemory::~PhysicalMemory()
 {
+    // stop any lazy restore before the stores go away
+    lazyFills.clear();
+
     // unmap the backing store
     for (auto& s : backingStore)
         munmap((char*)s.pmem, s.range.size());
 }
 
+void
+PhysicalMemory::completeLazyRestore() const
+{
+    bool pending = false;
+    for (const auto &fill : lazyFills)
+        pending |= !fill->complete();
+    if (!pending)
+        return;
+
+    DPRINTF(Checkpoint, "Completing lazy restore of physical memory\n");
+    ThreadPool pool(checkpointThreads);
+    for (const auto &fill : lazyFills)
+        fill->fillAll(pool);
+}
+
 bool
 PhysicalMemory::isMemAddr(Addr addr) const
 {
@@ -347,6 +516,10 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     SERIALIZE_CONTAINER(lal_addr);
     SERIALIZE_CONTAINER(lal_cid);
 
+    // lazily restored stores have to be complete before they are
+    // written out again
+    completeLazyRestore();
+
     // serialize the backing stores
     unsigned int nbr_of_stores = backingStore.size();
     SERIALIZE_SCALAR(nbr_of_stores);
@@ -378,6 +551,46 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+
+    if (checkpointChunkSize) {
+        // Version 2 stores are split in independently compressed
+        // chunks, version 1 (the default when absent) is a gzip stream
+        unsigned store_format = 2;
+        SERIALIZE_SCALAR(store_format);
+
+        // Chunks that did not change since the last checkpoint are
+        // only referenced from the new one
+        chunked_store::Reader parent;
+        const std::string &parent_file = lastStoreFile[store_id];
+        bool delta = deltaCheckpoints && !parent_file.empty() &&
+            parent_file != filepath && parent.open(parent_file);
+        warn_if(deltaCheckpoints && !parent_file.empty() && !delta,
+                "Can't open parent memory checkpoint '%s', writing a full "
+                "checkpoint\n", parent_file);
+        // Every file of a chain is kept open while restoring, so start a
+        // new chain rather than growing a long one
+        if (delta && parent.depth() >= deltaMaxChain) {
+            DPRINTF(Checkpoint, "Writing %s in full, %s is the end of a "
+                    "chain of %d files\n", filename, parent_file,
+                    parent.depth());
+            delta = false;
+        }
+        if (delta) {
+            DPRINTF(Checkpoint, "Writing %s as a delta against %s\n",
+                    filename, parent_file);
+        }
+
+        ThreadPool pool(checkpointThreads);
+        fatal_if(!chunked_store::write(filepath, pmem, range.size(),
+                                       checkpointChunkSize, pool,
+                                       delta ? &parent : nullptr,
+                                       parent_file),
+                 "Write failed on physical memory checkpoint file '%s'\n",
+                 filename);
+        lastStoreFile[store_id] = filepath;
+        return;
+    }
+
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
     if (compressed_mem == NULL)
         fatal("Can't open physical memory checkpoint file '%s'\n",
@@ -443,11 +656,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -462,6 +670,52 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    unsigned store_format = 1;
+    optParamIn(cp, "store_format", store_format, false);
+
+    if (store_format == 2) {
+        auto reader = std::make_unique<chunked_store::Reader>();
+        fatal_if(!reader->open(filepath),
+                 "Can't open physical memory checkpoint file '%s'", filename);
+        fatal_if(reader->size() != range.size(),
+                 "Physical memory checkpoint file '%s' has size %lld, "
+                 "expected %lld\n", filename, reader->size(), range.size());
+        DPRINTF(Checkpoint, "Restoring %s from a chain of %d files\n",
+                filename, reader->depth());
+
+        // the restored checkpoint is the base of the next delta
+        lastStoreFile[store_id] = filepath;
+
+        if (lazyRestore) {
+            // leave the store empty and let the memories fill in the
+            // chunks as they are accessed
+            auto fill = std::make_unique<chunked_store::LazyFill>(
+                std::move(reader), pmem, filepath);
+            DPRINTF(Checkpoint, "Restoring %s lazily, %d chunks pending\n",
+                    filename, fill->pending());
+            for (auto *m : storeMemories[store_id])
+                m->setLazyFill(fill.get());
+            lazyFills.push_back(std::move(fill));
+            return;
+        }
+
+        ThreadPool pool(checkpointThreads);
+        fatal_if(!reader->readAll(pmem, pool),
+                 "Read failed on physical memory checkpoint file '%s'\n",
+                 filename);
+        return;
+    }
+
+    fatal_if(store_format != 1,
+             "Unknown physical memory checkpoint format %d\n", store_format);
+    warn_if(lazyRestore, "Physical memory checkpoint file '%s' is not "
+            "chunked, it cannot be restored lazily\n", filename);
+
+    // mmap memoryfile
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
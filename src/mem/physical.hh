@@ -39,11 +39,15 @@
 #define __MEM_PHYSICAL_HH__
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/HostHugePages.hh"
+#include "enums/HostNumaPolicy.hh"
+#include "mem/chunked_store.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -156,12 +160,58 @@ class PhysicalMemory : public Serializable
     const std::string sharedBackstore;
     uint64_t sharedBackstoreSize;
 
+    // Chunk size used when checkpointing the backing stores in the
+    // chunked format, or 0 to use a single gzip stream
+    const uint64_t checkpointChunkSize;
+
+    // Number of host threads used to (de)compress chunked checkpoints,
+    // 0 for one per host core
+    const unsigned checkpointThreads;
+
+    // Fill chunked checkpoints into the backing store on first use
+    // rather than when the checkpoint is restored
+    const bool lazyRestore;
+
+    // Write chunked checkpoints as deltas against the last checkpoint
+    // written or restored
+    const bool deltaCheckpoints;
+
+    // Longest chain of delta checkpoints, including the full checkpoint
+    // at its base; a full checkpoint is written instead of a longer one
+    const unsigned deltaMaxChain;
+
+    // The last chunked checkpoint file of each backing store, which
+    // the next delta checkpoint refers to
+    mutable std::vector<std::string> lastStoreFile;
+
+    // Host page size and placement used for the backing stores
+    const HostHugePages hugePages;
+    const HostNumaPolicy numaPolicy;
+    const std::vector<unsigned> numaNodes;
+
+    // Bytes of backing store that got the requested huge pages and
+    // NUMA placement, respectively
+    uint64_t hugePageBytes;
+    uint64_t numaPlacedBytes;
+
     long pageSize;
 
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // The memories using each backing store, indexed like backingStore
+    std::vector<std::vector<AbstractMemory*>> storeMemories;
+
+    // Backing stores that are still being restored lazily
+    std::vector<std::unique_ptr<chunked_store::LazyFill>> lazyFills;
+
+    /**
+     * Finish all lazy restores, so that the backing stores can be
+     * accessed directly.
+     */
+    void completeLazyRestore() const;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -191,7 +241,15 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   uint64_t checkpoint_chunk_size=0,
+                   unsigned checkpoint_threads=0,
+                   bool lazy_restore=false,
+                   bool delta_checkpoints=false,
+                   unsigned delta_max_chain=8,
+                   HostHugePages huge_pages=HostHugePages::none,
+                   HostNumaPolicy numa_policy=HostNumaPolicy::local,
+                   const std::vector<unsigned> &numa_nodes={});
 
     /**
      * Unmap all the backing store we have used.
@@ -230,6 +288,23 @@ class PhysicalMemory : public Serializable
      */
     uint64_t totalSize() const { return size; }
 
+    /**
+     * Get the number of bytes of backing store that are backed by
+     * huge pages on the host, either from the hugetlb pool or
+     * transparently.
+     *
+     * @return Bytes backed by huge pages
+     */
+    uint64_t hugePageBacked() const { return hugePageBytes; }
+
+    /**
+     * Get the number of bytes of backing store that were placed
+     * according to the requested NUMA policy.
+     *
+     * @return Bytes with the requested NUMA placement
+     */
+    uint64_t numaPlaced() const { return numaPlacedBytes; }
+
      /**
      * Get the pointers to the backing store for external host
      * access. Note that memory in the guest should be accessed using
@@ -240,10 +315,18 @@ class PhysicalMemory : public Serializable
      * the OS-visible global address map and thus are allowed to
      * overlap.
      *
+     * Any lazily restored checkpoint data is filled in first, since
+     * the caller may access the memory without going through the
+     * memories.
+     *
      * @return Pointers to the memory backing store
      */
-    std::vector<BackingStoreEntry> getBackingStore() const
-    { return backingStore; }
+    std::vector<BackingStoreEntry>
+    getBackingStore() const
+    {
+        completeLazyRestore();
+        return backingStore;
+    }
 
     /**
      * Perform an untimed memory access and update all the state
@@ -121,7 +121,7 @@ MemTraceProbe::handleRequest(const probing::PacketInfo &pkt_info)
         pkt_msg.set_pc(pkt_info.pc);
     pkt_msg.set_pkt_id(pkt_info.id);
 
-    traceStream->write(pkt_msg);
+    traceStream->write(pkt_msg, pkt_msg.tick());
 }
 
 } // namespace gem5
@@ -60,6 +60,7 @@
 #include "base/compiler.hh"
 #include "base/extensible.hh"
 #include "base/flags.hh"
+#include "base/slab_pool.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
@@ -94,6 +95,16 @@ class ThreadContext;
 typedef std::shared_ptr<Request> RequestPtr;
 typedef uint16_t RequestorID;
 
+/**
+ * Create a request in the same way as std::make_shared<Request>. The
+ * request and its reference count are allocated together from a
+ * per-thread pool, which avoids the cost of the global allocator for
+ * the many short-lived requests of the memory system. The result is an
+ * ordinary RequestPtr.
+ */
+template <typename... Args>
+RequestPtr makeRequestPtr(Args&&... args);
+
 class Request : public Extensible<Request>
 {
   public:
@@ -530,7 +541,7 @@ class Request : public Extensible<Request>
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = makeRequestPtr();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
@@ -612,8 +623,8 @@ class Request : public Extensible<Request>
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = makeRequestPtr(*this);
+        req2 = makeRequestPtr(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -1121,6 +1132,14 @@ class Request : public Extensible<Request>
     /** @} */
 };
 
+template <typename... Args>
+RequestPtr
+makeRequestPtr(Args&&... args)
+{
+    return std::allocate_shared<Request>(SlabAllocator<Request>(),
+                                         std::forward<Args>(args)...);
+}
+
 } // namespace gem5
 
 #endif // __MEM_REQUEST_HH__
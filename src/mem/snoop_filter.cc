@@ -42,6 +42,9 @@
 
 #include "mem/snoop_filter.hh"
 
+#include <algorithm>
+
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
@@ -52,17 +55,158 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopFilter(const SnoopFilterParams &p)
+    : SimObject(p),
+      cachedLocations(p.max_capacity / p.system->cacheLineSize()),
+      linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
+      maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+      assoc(p.assoc), numSets(assoc ? maxEntryCount / assoc : 0),
+      setLines(std::size_t(numSets) * assoc, MaxAddr),
+      nextVictim(numSets, 0),
+      requestorId(assoc ? p.system->getRequestorId(this) :
+                  Request::invldRequestorId),
+      stats(this)
+{
+    fatal_if(assoc && (maxEntryCount % assoc || !isPowerOf2(numSets)),
+             "%s: %d lines in sets of %d ways is not a power of two "
+             "number of sets\n", name(), maxEntryCount, assoc);
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(Addr line_addr, SnoopItem *sf_item)
 {
-    SnoopItem& sf_item = sf_it->second;
-    if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+    if ((sf_item->requested | sf_item->holder).none()) {
+        cachedLocations.erase(sf_item);
+        if (assoc) {
+            unplaceLine(line_addr);
+        }
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
 }
 
+bool
+SnoopFilter::isPlaced(Addr line_addr)
+{
+    const Addr *ways = setOf(line_addr);
+    return std::find(ways, ways + assoc, line_addr) != ways + assoc;
+}
+
+bool
+SnoopFilter::placeLine(Addr line_addr)
+{
+    Addr *ways = setOf(line_addr);
+    Addr *free_way = std::find(ways, ways + assoc, MaxAddr);
+    if (free_way != ways + assoc) {
+        *free_way = line_addr;
+        return true;
+    }
+
+    // The set is full, replace the next line in round-robin order
+    // that the caches above are not currently requesting
+    unsigned &next = nextVictim[(line_addr / linesize) & (numSets - 1)];
+    for (unsigned i = 0; i < assoc; i++) {
+        const unsigned way = (next + i) % assoc;
+        const SnoopItem *victim = cachedLocations.find(ways[way]);
+        assert(victim);
+        if (victim->requested.none()) {
+            DPRINTF(SnoopFilter, "%s: evicting %#x for %#x\n", __func__,
+                    ways[way], line_addr);
+            pendingEvictions.push_back(ways[way]);
+            ways[way] = line_addr;
+            next = (way + 1) % assoc;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+SnoopFilter::trackLine(Addr line_addr)
+{
+    if (!placeLine(line_addr)) {
+        DPRINTF(SnoopFilter, "%s: no victim for %#x\n", __func__, line_addr);
+        unplacedLines.push_back(line_addr);
+    }
+}
+
+void
+SnoopFilter::retryPlacement(Addr line_addr, bool allow_eviction)
+{
+    const Addr set = (line_addr / linesize) & (numSets - 1);
+    for (auto it = unplacedLines.begin(); it != unplacedLines.end(); ) {
+        if (((*it / linesize) & (numSets - 1)) != set) {
+            ++it;
+            continue;
+        }
+
+        // The line may have been dropped, or dropped and placed
+        // again, while it waited
+        if (!cachedLocations.find(*it) || isPlaced(*it)) {
+            it = unplacedLines.erase(it);
+            continue;
+        }
+
+        Addr *ways = setOf(*it);
+        if (!allow_eviction && std::find(ways, ways + assoc, MaxAddr) ==
+            ways + assoc) {
+            return;
+        }
+        if (!placeLine(*it))
+            return;
+
+        DPRINTF(SnoopFilter, "%s: placed %#x\n", __func__, *it);
+        it = unplacedLines.erase(it);
+    }
+}
+
+void
+SnoopFilter::unplaceLine(Addr line_addr)
+{
+    Addr *ways = setOf(line_addr);
+    Addr *way = std::find(ways, ways + assoc, line_addr);
+    if (way != ways + assoc) {
+        *way = MaxAddr;
+        // Hand the free way to a line waiting for one
+        if (!unplacedLines.empty())
+            retryPlacement(line_addr, false);
+    }
+}
+
+std::vector<SnoopFilter::BackInvalidation>
+SnoopFilter::takeBackInvalidations()
+{
+    std::vector<BackInvalidation> victims;
+    std::vector<Addr> deferred;
+    for (const Addr line_addr : pendingEvictions) {
+        // The line may have been dropped, or dropped and tracked
+        // again, since it was evicted
+        SnoopItem *sf_it = cachedLocations.find(line_addr);
+        if (!sf_it || isPlaced(line_addr))
+            continue;
+
+        // A response to a request in flight may still have to come
+        // from one of the holders, so try again later
+        if (sf_it->requested.any()) {
+            deferred.push_back(line_addr);
+            continue;
+        }
+
+        DPRINTF(SnoopFilter, "%s: %#x SF value %x.%x\n", __func__,
+                line_addr, sf_it->requested, sf_it->holder);
+        victims.push_back({line_addr & ~Addr(LineSecure),
+                           bool(line_addr & LineSecure),
+                           maskToPortList(sf_it->holder)});
+        stats.backInvalidations++;
+
+        sf_it->holder = 0;
+        eraseIfNullEntry(line_addr, sf_it);
+    }
+    pendingEvictions.swap(deferred);
+    return victims;
+}
+
 std::pair<SnoopFilter::SnoopList, Cycles>
 SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
                            cpu_side_port)
@@ -78,21 +222,23 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    SnoopItem *sf_it = cachedLocations.find(line_addr);
+    bool is_hit = (sf_it != nullptr);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
     // portlist.
+    reqLookupResult.valid = is_hit || allocate;
+    reqLookupResult.lineAddr = line_addr;
+    reqLookupResult.isNew = !is_hit;
     if (!is_hit && !allocate)
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
+    // If no hit in snoop filter create a new element
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        sf_it = &cachedLocations.findOrInsert(line_addr);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    SnoopItem& sf_item = *sf_it;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -159,24 +305,32 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.valid) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
-        assert(reqLookupResult.it->first == \
+        assert(reqLookupResult.lineAddr == \
                 (is_secure ? ((addr & ~(Addr(linesize - 1))) | LineSecure) : \
                  (addr & ~(Addr(linesize - 1)))));
+        reqLookupResult.valid = false;
+
+        SnoopItem *sf_it = cachedLocations.find(reqLookupResult.lineAddr);
+        assert(sf_it);
         if (will_retry) {
             SnoopItem retry_item = reqLookupResult.retryItem;
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            *sf_it = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
+        } else if (assoc && reqLookupResult.isNew &&
+                   (sf_it->requested | sf_it->holder).any()) {
+            // The line is tracked for good now, make room for it
+            trackLine(reqLookupResult.lineAddr);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(reqLookupResult.lineAddr, sf_it);
     }
 }
 
@@ -191,10 +345,13 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    SnoopItem *sf_it = cachedLocations.find(line_addr);
+    bool is_hit = (sf_it != nullptr);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    // A finite filter may briefly track more lines while the lines it
+    // evicted wait for their back-invalidation
+    panic_if(!assoc && !is_hit &&
+             (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -204,7 +361,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -234,7 +391,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_it);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -264,7 +421,7 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    SnoopItem& sf_item = cachedLocations.findOrInsert(line_addr);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -311,8 +468,8 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    SnoopItem *sf_it = cachedLocations.find(line_addr);
+    bool is_hit = sf_it != nullptr;
 
     // Nothing to do if it is not a hit
     if (!is_hit)
@@ -322,7 +479,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = *sf_it;
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -330,7 +487,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_it);
     }
 }
 
@@ -353,12 +510,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    SnoopItem *sf_it = cachedLocations.find(line_addr);
+    if (!sf_it)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -377,7 +534,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_it);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -386,6 +543,47 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     }
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
+
+    // Lines that found no victim in this set may find one now that
+    // the request completed
+    if (!unplacedLines.empty())
+        retryPlacement(line_addr, true);
+}
+
+void
+SnoopFilter::updateWarmFill(const Packet* cpkt, const ResponsePort&
+                            cpu_side_port)
+{
+    DPRINTF(SnoopFilter, "%s: src %s packet %s\n",
+            __func__, cpu_side_port.name(), cpkt->print());
+
+    assert(cpkt->isWarmFill());
+
+    if (cpkt->req->isUncacheable() || !cpu_side_port.isSnooping())
+        return;
+
+    Addr line_addr = cpkt->getBlockAddr(linesize);
+    if (cpkt->isSecure()) {
+        line_addr |= LineSecure;
+    }
+    bool is_hit = (cachedLocations.find(line_addr) != nullptr);
+
+    panic_if(!assoc && !is_hit &&
+             (cachedLocations.size() >= maxEntryCount),
+             "snoop filter exceeded capacity of %d cache blocks\n",
+             maxEntryCount);
+
+    // The cache only announces the blocks it keeps once its restore is
+    // over, so the holder bit stays accurate
+    SnoopItem& sf_item = cachedLocations.findOrInsert(line_addr);
+    sf_item.holder |= portToMask(cpu_side_port);
+
+    DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
+            __func__, sf_item.requested, sf_item.holder);
+
+    if (assoc && !is_hit) {
+        trackLine(line_addr);
+    }
 }
 
 SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
@@ -405,7 +603,10 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
+               "(>1) holders of the requested data."),
+      ADD_STAT(backInvalidations, statistics::units::Count::get(),
+               "Number of lines evicted from a finite snoop filter whose "
+               "holders were back-invalidated.")
 {}
 
 void
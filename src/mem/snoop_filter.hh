@@ -44,12 +44,14 @@
 #define __MEM_SNOOP_FILTER_HH__
 
 #include <bitset>
-#include <unordered_map>
+#include <cstddef>
 #include <utility>
+#include <vector>
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
+#include "mem/snoop_filter_table.hh"
 #include "params/SnoopFilter.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
@@ -85,6 +87,11 @@ namespace gem5
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * By default the filter tracks every line held above it. With a
+ * non-zero associativity it is finite instead, and holds max_capacity
+ * worth of lines in sets. A line that does not fit in its set evicts
+ * another one, whose holders the crossbar then back-invalidates.
  */
 class SnoopFilter : public SimObject
 {
@@ -95,13 +102,7 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
-        maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
-    {
-    }
+    SnoopFilter (const SnoopFilterParams &p);
 
     /**
      * Init a new snoop filter and tell it about all the cpu_sideports
@@ -200,6 +201,48 @@ class SnoopFilter : public SimObject
      */
     void updateResponse(const Packet *cpkt, const ResponsePort& cpu_side_port);
 
+    /**
+     * Record a cache above as a holder of a block it installs while
+     * restoring warm state from a checkpoint. The block is fetched with
+     * a functional read, which does not otherwise update the filter.
+     *
+     * @param cpkt          Pointer to const Packet holding the warm fill.
+     * @param cpu_side_port ResponsePort of the cache installing the block.
+     */
+    void updateWarmFill(const Packet *cpkt, const ResponsePort& cpu_side_port);
+
+    /**
+     * A line a finite snoop filter evicted to make room for another,
+     * and the ports whose copies of it have to be invalidated.
+     */
+    struct BackInvalidation
+    {
+        /** Line address, without the status bits. */
+        Addr addr;
+        bool secure;
+        SnoopList ports;
+    };
+
+    /**
+     * Check if the filter evicted lines whose holders have to be
+     * back-invalidated.
+     */
+    bool needsBackInvalidation() const { return !pendingEvictions.empty(); }
+
+    /**
+     * Stop tracking the lines the filter evicted. Lines that were
+     * dropped by the caches above in the meantime are skipped, and
+     * lines with requests in flight are kept for a later call. The
+     * caller must invalidate the copies held through the returned
+     * ports.
+     *
+     * @return The evicted lines and the ports holding them.
+     */
+    std::vector<BackInvalidation> takeBackInvalidations();
+
+    /** Get the requestor id to use for back-invalidations. */
+    RequestorID getRequestorId() const { return requestorId; }
+
     virtual void regStats();
 
   protected:
@@ -220,10 +263,9 @@ class SnoopFilter : public SimObject
         SnoopMask requested;
         SnoopMask holder;
     };
-    /**
-     * HashMap of SnoopItems indexed by line address
-     */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
+
+    /** Hash table of the tracked lines. */
+    typedef SnoopFilterTable<SnoopItem> SnoopFilterCache;
 
     /**
      * Simple factory methods for standard return values.
@@ -261,9 +303,52 @@ class SnoopFilter : public SimObject
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(Addr line_addr, SnoopItem *sf_item);
+
+    /**
+     * Get the ways of the set a line maps to in a finite snoop filter.
+     */
+    Addr *
+    setOf(Addr line_addr)
+    {
+        return &setLines[((line_addr / linesize) & (numSets - 1)) * assoc];
+    }
+
+    /** Check if a line occupies a way of its set. */
+    bool isPlaced(Addr line_addr);
 
-    /** Simple hash set of cached addresses. */
+    /**
+     * Let a line occupy a way of its set. If the set is full, the line
+     * replaces one without requests in flight, which is queued for
+     * back-invalidation.
+     *
+     * @return False if every line of the set has a request in flight.
+     */
+    bool placeLine(Addr line_addr);
+
+    /**
+     * Place a newly tracked line. If it does not fit, it is tracked
+     * without a way until a request in its set completes, or a way of
+     * its set is freed.
+     */
+    void trackLine(Addr line_addr);
+
+    /**
+     * Place the lines waiting for a way in the set of a line, in the
+     * order they started waiting.
+     *
+     * @param line_addr A line of the set.
+     * @param allow_eviction Whether the waiting lines may evict others.
+     */
+    void retryPlacement(Addr line_addr, bool allow_eviction);
+
+    /**
+     * Free the way a line occupies, if any, and give it to a line
+     * waiting for one.
+     */
+    void unplaceLine(Addr line_addr);
+
+    /** Hash table of cached addresses. */
     SnoopFilterCache cachedLocations;
 
     /**
@@ -274,27 +359,25 @@ class SnoopFilter : public SimObject
      */
     struct ReqLookupResult
     {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /**
+         * Whether lookupRequest found or created an entry. The entry is
+         * looked up again by address in finishRequest, as pointers into
+         * the table do not survive other insertions and erasures.
+         */
+        bool valid = false;
+
+        /** Line address of the entry, including the status bits. */
+        Addr lineAddr = 0;
+
+        /** Whether lookupRequest created the entry. */
+        bool isNew = false;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
          * in case finishRequest needs to undo changes made in lookupRequest
          * (because of crossbar retry)
          */
-        SnoopItem retryItem;
-
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
+        SnoopItem retryItem{0, 0};
     } reqLookupResult;
 
     /** List of all attached snooping CPU-side ports. */
@@ -308,6 +391,27 @@ class SnoopFilter : public SimObject
     /** Max capacity in terms of cache blocks tracked, for sanity checking */
     const unsigned maxEntryCount;
 
+    /**
+     * Associativity of a finite snoop filter, or zero if the filter
+     * tracks every line held above it.
+     */
+    const unsigned assoc;
+    /** Number of sets of a finite snoop filter. */
+    const unsigned numSets;
+    /** Lines occupying the ways of each set, or MaxAddr if free. */
+    std::vector<Addr> setLines;
+    /** Next way to consider for replacement, per set. */
+    std::vector<unsigned> nextVictim;
+    /** Evicted lines that still have to be back-invalidated. */
+    std::vector<Addr> pendingEvictions;
+    /**
+     * Tracked lines that found no victim in their set, as every line
+     * of it had a request in flight.
+     */
+    std::vector<Addr> unplacedLines;
+    /** Requestor id of back-invalidations. */
+    const RequestorID requestorId;
+
     /**
      * Use the lower bits of the address to keep track of the line status
      */
@@ -329,6 +433,8 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        statistics::Scalar backInvalidations;
     } stats;
 };
 
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Open-addressing hash table of per-line snoop filter state.
+ */
+
+#ifndef __MEM_SNOOP_FILTER_TABLE_HH__
+#define __MEM_SNOOP_FILTER_TABLE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Open-addressing hash table of items indexed by line address.
+ * Collisions are resolved by linear probing, and erasing an entry
+ * shifts the entries that follow it back instead of leaving a
+ * tombstone, so lookups do not degrade as lines come and go. The
+ * table starts small and doubles as it fills, up to a size derived
+ * from the capacity of the snoop filter, so its memory is bounded.
+ *
+ * Pointers to items are only valid until the next insertion or
+ * erasure, as both may move entries around.
+ *
+ * @tparam Item Default constructible, copyable per-line state.
+ */
+template <typename Item>
+class SnoopFilterTable
+{
+  public:
+    /** Number of slots a table starts with, unless it is smaller. */
+    static constexpr std::size_t initialSlots = 1024;
+
+    /**
+     * @param max_entries Number of lines the table must be able to
+     *                    track at a reasonable load factor.
+     */
+    SnoopFilterTable(std::size_t max_entries);
+
+    /**
+     * Find the item of a line.
+     *
+     * @param line_addr Line address, including the status bits.
+     * @return The item, or nullptr if the line is not tracked.
+     */
+    Item *find(Addr line_addr);
+
+    /**
+     * Find the item of a line, inserting a default constructed one if
+     * the line is not tracked yet.
+     *
+     * @param line_addr Line address, including the status bits.
+     * @return The line's item.
+     */
+    Item &findOrInsert(Addr line_addr);
+
+    /**
+     * Stop tracking the line of an item.
+     *
+     * @param item An item returned by find or findOrInsert.
+     */
+    void erase(Item *item);
+
+    /** Get the number of tracked lines. */
+    std::size_t size() const { return numEntries; }
+
+    /** Get the current number of slots. */
+    std::size_t slots() const { return keys.size(); }
+
+    /** Get the slot a line address hashes to. */
+    std::size_t
+    homeSlot(Addr line_addr) const
+    {
+        // Fibonacci hashing, using the well mixed upper bits
+        return (line_addr * 0x9E3779B97F4A7C15ULL) >> (64 - slotBits);
+    }
+
+  private:
+    /** Key of the empty slots; never a valid (aligned) line address. */
+    static constexpr Addr emptyKey = MaxAddr;
+
+    /**
+     * Find the slot holding a line address or, if the line is not in
+     * the table, the empty slot that ends its probe sequence.
+     */
+    std::size_t probe(Addr line_addr) const;
+
+    /** Double the number of slots and re-insert all entries. */
+    void grow();
+
+    /** Maximum number of slots the table may grow to. */
+    const std::size_t maxSlots;
+
+    /** Log2 of the current number of slots. */
+    unsigned slotBits;
+
+    /** Number of lines currently tracked. */
+    std::size_t numEntries;
+
+    /** Line addresses, or emptyKey, per slot. */
+    std::vector<Addr> keys;
+
+    /** Items, per slot. */
+    std::vector<Item> items;
+};
+
+template <typename Item>
+SnoopFilterTable<Item>::SnoopFilterTable(std::size_t max_entries)
+    : maxSlots(std::size_t(1) << ceilLog2(std::max<std::size_t>(
+                   2 * max_entries, 2))),
+      slotBits(floorLog2(std::min<std::size_t>(maxSlots, initialSlots))),
+      numEntries(0), keys(std::size_t(1) << slotBits, emptyKey),
+      items(std::size_t(1) << slotBits)
+{
+}
+
+template <typename Item>
+std::size_t
+SnoopFilterTable<Item>::probe(Addr line_addr) const
+{
+    const std::size_t mask = keys.size() - 1;
+    std::size_t slot = homeSlot(line_addr);
+    while (keys[slot] != line_addr && keys[slot] != emptyKey) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+template <typename Item>
+Item *
+SnoopFilterTable<Item>::find(Addr line_addr)
+{
+    const std::size_t slot = probe(line_addr);
+    return keys[slot] == line_addr ? &items[slot] : nullptr;
+}
+
+template <typename Item>
+Item &
+SnoopFilterTable<Item>::findOrInsert(Addr line_addr)
+{
+    assert(line_addr != emptyKey);
+
+    std::size_t slot = probe(line_addr);
+    if (keys[slot] == line_addr) {
+        return items[slot];
+    }
+
+    // Keep the load factor at or below one half while the table may
+    // grow, and always leave an empty slot to terminate probing
+    if (2 * (numEntries + 1) > keys.size() && keys.size() < maxSlots) {
+        grow();
+        slot = probe(line_addr);
+    }
+    panic_if(numEntries + 1 >= keys.size(),
+             "Snoop filter table is full with %d lines\n", numEntries);
+
+    keys[slot] = line_addr;
+    items[slot] = Item();
+    numEntries++;
+    return items[slot];
+}
+
+template <typename Item>
+void
+SnoopFilterTable<Item>::erase(Item *item)
+{
+    const std::size_t mask = keys.size() - 1;
+    std::size_t hole = item - items.data();
+    assert(hole < keys.size() && keys[hole] != emptyKey);
+
+    // Shift back the entries of the probe sequence that follows the
+    // hole, unless that would move them before their home slot
+    for (std::size_t slot = (hole + 1) & mask; keys[slot] != emptyKey;
+         slot = (slot + 1) & mask) {
+        const std::size_t home = homeSlot(keys[slot]);
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            keys[hole] = keys[slot];
+            items[hole] = items[slot];
+            hole = slot;
+        }
+    }
+
+    keys[hole] = emptyKey;
+    numEntries--;
+}
+
+template <typename Item>
+void
+SnoopFilterTable<Item>::grow()
+{
+    std::vector<Addr> old_keys(keys.size() * 2, emptyKey);
+    std::vector<Item> old_items(items.size() * 2);
+    old_keys.swap(keys);
+    old_items.swap(items);
+    slotBits++;
+
+    for (std::size_t i = 0; i < old_keys.size(); i++) {
+        if (old_keys[i] != emptyKey) {
+            const std::size_t slot = probe(old_keys[i]);
+            keys[slot] = old_keys[i];
+            items[slot] = old_items[i];
+        }
+    }
+}
+
+} // namespace gem5
+
+#endif // __MEM_SNOOP_FILTER_TABLE_HH__
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "base/gtest/logging.hh"
+#include "mem/snoop_filter_table.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct TestItem
+{
+    int value = 0;
+};
+
+typedef SnoopFilterTable<TestItem> TestTable;
+
+/** Find line addresses that all hash to the same slot of a table. */
+std::vector<Addr>
+collidingLines(const TestTable &table, std::size_t slot, unsigned count)
+{
+    std::vector<Addr> lines;
+    for (Addr line_addr = 0; lines.size() < count; line_addr += 64) {
+        if (table.homeSlot(line_addr) == slot)
+            lines.push_back(line_addr);
+    }
+    return lines;
+}
+
+} // anonymous namespace
+
+TEST(SnoopFilterTableTest, FindOrInsert)
+{
+    TestTable table(1 << 16);
+    EXPECT_EQ(0u, table.size());
+    EXPECT_EQ(nullptr, table.find(0x1000));
+
+    table.findOrInsert(0x1000).value = 1;
+    table.findOrInsert(0x2040).value = 2;
+    EXPECT_EQ(2u, table.size());
+
+    ASSERT_NE(nullptr, table.find(0x1000));
+    EXPECT_EQ(1, table.find(0x1000)->value);
+    ASSERT_NE(nullptr, table.find(0x2040));
+    EXPECT_EQ(2, table.find(0x2040)->value);
+    EXPECT_EQ(nullptr, table.find(0x1040));
+
+    // Inserting a tracked line returns its item
+    EXPECT_EQ(1, table.findOrInsert(0x1000).value);
+    EXPECT_EQ(2u, table.size());
+}
+
+TEST(SnoopFilterTableTest, StatusBitsAreDistinctLines)
+{
+    TestTable table(1 << 16);
+    table.findOrInsert(0x1000).value = 1;
+    table.findOrInsert(0x1001).value = 2;
+    EXPECT_EQ(2u, table.size());
+    EXPECT_EQ(1, table.find(0x1000)->value);
+    EXPECT_EQ(2, table.find(0x1001)->value);
+}
+
+TEST(SnoopFilterTableTest, EraseShiftsCollidingLinesBack)
+{
+    TestTable table(1 << 16);
+    const auto lines = collidingLines(table, 7, 4);
+    for (int i = 0; i < 4; i++)
+        table.findOrInsert(lines[i]).value = i;
+
+    // Erasing the head of the probe sequence must keep the lines
+    // behind it reachable, without leaving a tombstone in between
+    table.erase(table.find(lines[0]));
+    EXPECT_EQ(3u, table.size());
+    EXPECT_EQ(nullptr, table.find(lines[0]));
+    for (int i = 1; i < 4; i++) {
+        ASSERT_NE(nullptr, table.find(lines[i]));
+        EXPECT_EQ(i, table.find(lines[i])->value);
+    }
+
+    table.erase(table.find(lines[2]));
+    EXPECT_EQ(2u, table.size());
+    EXPECT_EQ(1, table.find(lines[1])->value);
+    EXPECT_EQ(3, table.find(lines[3])->value);
+
+    // The freed slots are reused
+    table.findOrInsert(lines[0]).value = 4;
+    EXPECT_EQ(3u, table.size());
+    EXPECT_EQ(4, table.find(lines[0])->value);
+}
+
+TEST(SnoopFilterTableTest, EraseDoesNotMoveLinesBeforeTheirHome)
+{
+    TestTable table(1 << 16);
+    const auto first = collidingLines(table, 20, 2);
+    const auto second = collidingLines(table, 21, 1);
+
+    // The line of slot 21 is pushed to slot 22 by the second line of
+    // slot 20, and may only move back to 21 once that is erased
+    table.findOrInsert(first[0]).value = 1;
+    table.findOrInsert(first[1]).value = 2;
+    table.findOrInsert(second[0]).value = 3;
+
+    table.erase(table.find(first[0]));
+    EXPECT_EQ(2, table.find(first[1])->value);
+    EXPECT_EQ(3, table.find(second[0])->value);
+
+    table.erase(table.find(first[1]));
+    EXPECT_EQ(nullptr, table.find(first[1]));
+    EXPECT_EQ(3, table.find(second[0])->value);
+    EXPECT_EQ(1u, table.size());
+}
+
+TEST(SnoopFilterTableTest, ProbingWrapsAround)
+{
+    TestTable table(1 << 16);
+    const auto lines = collidingLines(table, table.slots() - 1, 3);
+    for (int i = 0; i < 3; i++)
+        table.findOrInsert(lines[i]).value = i;
+
+    table.erase(table.find(lines[0]));
+    EXPECT_EQ(nullptr, table.find(lines[0]));
+    EXPECT_EQ(1, table.find(lines[1])->value);
+    EXPECT_EQ(2, table.find(lines[2])->value);
+}
+
+TEST(SnoopFilterTableTest, GrowsAndRehashes)
+{
+    TestTable table(1 << 16);
+    EXPECT_EQ(TestTable::initialSlots, table.slots());
+
+    const unsigned num_lines = 3 * TestTable::initialSlots;
+    for (unsigned i = 0; i < num_lines; i++)
+        table.findOrInsert(Addr(i) * 64).value = i;
+
+    // The load factor stays at or below one half
+    EXPECT_EQ(num_lines, table.size());
+    EXPECT_GE(table.slots(), 2 * num_lines);
+    for (unsigned i = 0; i < num_lines; i++) {
+        ASSERT_NE(nullptr, table.find(Addr(i) * 64));
+        EXPECT_EQ(int(i), table.find(Addr(i) * 64)->value);
+    }
+}
+
+TEST(SnoopFilterTableTest, SizeIsBounded)
+{
+    // A small filter starts small and grows to twice its capacity
+    TestTable table(16);
+    EXPECT_EQ(32u, table.slots());
+
+    for (unsigned i = 0; i < 31; i++)
+        table.findOrInsert(Addr(i) * 64);
+    EXPECT_EQ(32u, table.slots());
+
+    // There is always an empty slot left to terminate probing
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(table.findOrInsert(Addr(31) * 64));
+}
+
+TEST(SnoopFilterTableTest, MatchesReference)
+{
+    TestTable table(1 << 12);
+    std::unordered_map<Addr, int> reference;
+    std::mt19937 rng(1);
+
+    // Few distinct lines in a table that grows, so that inserts and
+    // erases of colliding lines interleave
+    for (int i = 0; i < 100000; i++) {
+        const Addr line_addr = Addr(rng() % 3000) * 64;
+        if (rng() % 2) {
+            table.findOrInsert(line_addr).value = i;
+            reference[line_addr] = i;
+        } else if (TestItem *item = table.find(line_addr)) {
+            table.erase(item);
+            reference.erase(line_addr);
+        } else {
+            EXPECT_EQ(0u, reference.count(line_addr));
+        }
+    }
+
+    EXPECT_EQ(reference.size(), table.size());
+    for (const auto &[line_addr, value] : reference) {
+        ASSERT_NE(nullptr, table.find(line_addr));
+        EXPECT_EQ(value, table.find(line_addr)->value);
+    }
+}
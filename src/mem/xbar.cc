@@ -45,9 +45,12 @@
 
 #include "mem/xbar.hh"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -64,6 +67,10 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       responseLatency(p.response_latency),
       headerLatency(p.header_latency),
       width(p.width),
+      routeCache(p.route_cache_entries),
+      routeCacheIndexBits(p.route_cache_entries ?
+                          floorLog2(p.route_cache_entries) : 0),
+      routeGranuleShift(0), routeCacheEnabled(false),
       gotAddrRanges(p.port_default_connection_count +
                           p.port_mem_side_ports_connection_count, false),
       gotAllAddrRanges(false), defaultPortID(InvalidPortID),
@@ -76,6 +83,13 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       ADD_STAT(pktSize, statistics::units::Byte::get(),
                "Cumulative packet size per connected requestor and responder")
 {
+    fatal_if(p.route_cache_entries && !isPowerOf2(p.route_cache_entries),
+             "%s: the number of route cache entries must be a power of 2",
+             name());
+
+    // crossbars are shared by objects that may live on different
+    // event queues, so keep a copy of the stats per queue
+    shardStats();
 }
 
 BaseXBar::~BaseXBar()
@@ -337,6 +351,65 @@ BaseXBar::findPort(AddrRange addr_range, PacketPtr pkt)
     // ranges of all connected CPU-side-port modules
     assert(gotAllAddrRanges);
 
+    // Only packets that do not straddle a granule can use the cache, as
+    // the route is only known to be uniform within a granule
+    const Addr granule = addr_range.start() >> routeGranuleShift;
+    if (!routeCacheEnabled || addr_range.end() <= addr_range.start() ||
+        granule != (addr_range.end() - 1) >> routeGranuleShift) {
+        return lookupPort(addr_range, pkt);
+    }
+
+    std::atomic<uint64_t> &entry =
+        routeCache[granule & mask(routeCacheIndexBits)];
+    const uint64_t tag = granule >> routeCacheIndexBits;
+    const uint64_t cached = entry.load(std::memory_order_relaxed);
+    if (cached && (cached >> 16) == tag) {
+        return PortID((cached & mask(16)) - 1);
+    }
+
+    const PortID port_id = lookupPort(addr_range, pkt);
+    entry.store((tag << 16) | uint16_t(port_id + 1),
+                std::memory_order_relaxed);
+    return port_id;
+}
+
+void
+BaseXBar::resetRouteCache()
+{
+    // The granule must not cross the boundaries of any range, nor the
+    // stripes of interleaved ranges
+    unsigned shift = 63;
+    auto align_to = [&shift](const AddrRange &r) {
+        shift = std::min<unsigned>(shift, ctz64(r.start()));
+        shift = std::min<unsigned>(shift, ctz64(r.end()));
+        if (r.interleaved()) {
+            shift = std::min<unsigned>(shift, floorLog2(r.granularity()));
+        }
+    };
+    for (const auto &r : portMap) {
+        align_to(r.first);
+    }
+    if (useDefaultRange && defaultRange.valid()) {
+        align_to(defaultRange);
+    }
+    routeGranuleShift = shift;
+
+    // The tag of an entry only has 48 bits, next to the 16-bit port ID
+    routeCacheEnabled = !routeCache.empty() &&
+        routeGranuleShift + routeCacheIndexBits >= 16;
+
+    for (auto &entry : routeCache) {
+        entry.store(0, std::memory_order_relaxed);
+    }
+
+    DPRINTF(AddrRanges, "Route cache %s, granule of %d bytes\n",
+            routeCacheEnabled ? "enabled" : "disabled",
+            1ULL << routeGranuleShift);
+}
+
+PortID
+BaseXBar::lookupPort(AddrRange addr_range, PacketPtr pkt)
+{
     // Check the address map interval tree
     auto i = portMap.contains(addr_range);
     if (i != portMap.end()) {
@@ -443,6 +516,9 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
         }
     }
 
+    // the routing decisions may have changed with the ranges
+    resetRouteCache();
+
     // if we have received ranges from all our neighbouring CPU-side-port
     // modules, go ahead and tell our connected memory-side-port modules in
     // turn, this effectively assumes a tree structure of the system
@@ -46,8 +46,11 @@
 #ifndef __MEM_XBAR_HH__
 #define __MEM_XBAR_HH__
 
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <unordered_map>
+#include <vector>
 
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
@@ -318,6 +321,45 @@ class BaseXBar : public ClockedObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /**
+     * Direct-mapped cache of routing decisions in front of portMap. The
+     * address space is cut into granules that are aligned with the
+     * boundaries of all ranges and interleaving stripes, so that every
+     * address of a granule is routed to the same port. A packet that
+     * fits in a granule is routed by looking up the granule number,
+     * without searching the ranges or decoding the interleaving bits.
+     *
+     * Each entry packs the granule tag with the port ID plus one, so that
+     * entries can be read and written atomically by crossbar users on
+     * different event queues. Zero marks an empty entry.
+     */
+    std::vector<std::atomic<uint64_t>> routeCache;
+
+    /** Log2 of the number of route cache entries. */
+    const unsigned routeCacheIndexBits;
+
+    /** Log2 of the size of a routing granule. */
+    unsigned routeGranuleShift;
+
+    /** Whether the route cache can be used with the current ranges. */
+    bool routeCacheEnabled;
+
+    /**
+     * Recompute the routing granule from the current ranges and empty
+     * the route cache. Must be called whenever the ranges change.
+     */
+    void resetRouteCache();
+
+    /**
+     * Find the port for a range by searching the address map, without
+     * going through the route cache.
+     *
+     * @param addr_range Address range to find port for.
+     * @param pkt Packet that containing the address range.
+     * @return id of port that the packet should be sent out of.
+     */
+    PortID lookupPort(AddrRange addr_range, PacketPtr pkt);
+
     /**
      * Remember where request packets came from so that we can route
      * responses to the appropriate port. This relies on the fact that
@@ -37,51 +37,156 @@
 
 #include "proto/protoio.hh"
 
+#include <zlib.h>
+
+#include <limits>
 #include <string>
 
 #include "base/logging.hh"
 
 using namespace google::protobuf;
 
-ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
+namespace
+{
+
+const uint64_t noKey = std::numeric_limits<uint64_t>::max();
+
+/// Subfield IDs of the index entries and of the index trailer
+const char chunkIndexId[2] = { 'g', 'c' };
+const char indexTrailerId[2] = { 'g', 'i' };
+
+void
+putLittleEndian16(std::string& out, uint16_t val)
+{
+    out.push_back(char(val));
+    out.push_back(char(val >> 8));
+}
+
+void
+putLittleEndian64(std::string& out, uint64_t val)
+{
+    for (int i = 0; i < 8; ++i)
+        out.push_back(char(val >> (8 * i)));
+}
+
+uint16_t
+getLittleEndian16(const unsigned char* in)
+{
+    return in[0] | (in[1] << 8);
+}
+
+uint64_t
+getLittleEndian64(const unsigned char* in)
+{
+    uint64_t val = 0;
+    for (int i = 7; i >= 0; --i)
+        val = (val << 8) | in[i];
+    return val;
+}
+
+bool
+isCompressed(const std::string& filename)
+{
+    return filename.find_last_of('.') != std::string::npos &&
+        filename.substr(filename.find_last_of('.') + 1) == "gz";
+}
+
+/**
+ * Write an empty gzip member carrying data in an extra subfield.
+ */
+void
+writeExtraMember(std::ostream& out, const char* id, const std::string& data)
+{
+    std::string member = {
+        '\x1f', '\x8b', 8, 4, 0, 0, 0, 0, 0, '\xff' };
+    putLittleEndian16(member, data.size() + 4);
+    member.append(id, 2);
+    putLittleEndian16(member, data.size());
+    member += data;
+    // An empty final block of fixed codes, followed by the CRC and
+    // size of the (empty) data
+    member.append({ 3, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+    out.write(member.data(), member.size());
+}
+
+/**
+ * Read an empty gzip member written by writeExtraMember.
+ *
+ * @return False if the stream isn't at such a member
+ */
+bool
+readExtraMember(std::istream& in, const char* id, std::string& data)
+{
+    unsigned char header[16];
+    if (!in.read((char*)header, sizeof(header)) ||
+        header[0] != 0x1f || header[1] != 0x8b || header[3] != 4 ||
+        header[12] != (unsigned char)id[0] ||
+        header[13] != (unsigned char)id[1]) {
+        return false;
+    }
+
+    const uint16_t size = getLittleEndian16(&header[14]);
+    if (getLittleEndian16(&header[10]) != size + 4)
+        return false;
+
+    data.resize(size);
+    char trailer[10];
+    return in.read(&data[0], size) && in.read(trailer, sizeof(trailer)) &&
+        trailer[0] == 3 && trailer[1] == 0;
+}
+
+} // anonymous namespace
+
+ProtoOutputStream::ProtoOutputStream(const std::string& filename,
+                                     size_t chunk_size) :
     fileStream(filename.c_str(),
             std::ios::out | std::ios::binary | std::ios::trunc),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    chunkSize(isCompressed(filename) ? std::max<size_t>(chunk_size, 1) : 0),
+    chunk{0, 0, noKey, 0},
+    wrappedFileStream(NULL), zeroCopyStream(NULL)
 {
     if (!fileStream.good())
         panic("Could not open %s for writing\n", filename);
 
-    // Wrap the output file in a zero copy stream, that in turn is
-    // wrapped in a gzip stream if the filename ends with .gz. The
-    // latter stream is in turn wrapped in a coded stream
-    wrappedFileStream = new io::OstreamOutputStream(&fileStream);
-    if (filename.find_last_of('.') != std::string::npos &&
-        filename.substr(filename.find_last_of('.') + 1) == "gz") {
-        gzipStream = new io::GzipOutputStream(wrappedFileStream);
-        zeroCopyStream = gzipStream;
+    // Compressed files are written in chunks of messages that are
+    // buffered in a string, uncompressed files through a zero copy
+    // stream wrapping the output file
+    if (chunkSize) {
+        io::StringOutputStream stringStream(&chunkBuffer);
+        zeroCopyStream = &stringStream;
+        writeMagic();
+        zeroCopyStream = NULL;
     } else {
+        wrappedFileStream = new io::OstreamOutputStream(&fileStream);
         zeroCopyStream = wrappedFileStream;
+        writeMagic();
     }
 
-    // Write the magic number to the file
-    io::CodedOutputStream codedStream(zeroCopyStream);
-    codedStream.WriteLittleEndian32(magicNumber);
-
     // Note that each type of stream (packet, instruction etc) should
     // add its own header and perform the appropriate checks
 }
 
 ProtoOutputStream::~ProtoOutputStream()
 {
-    // As the compression is optional, see if the stream exists
-    if (gzipStream != NULL)
-        delete gzipStream;
+    if (chunkSize) {
+        if (!chunkBuffer.empty() || index.empty())
+            writeChunk();
+        writeIndex();
+    }
+
     delete wrappedFileStream;
     fileStream.close();
 }
 
 void
-ProtoOutputStream::write(const Message& msg)
+ProtoOutputStream::writeMagic()
+{
+    io::CodedOutputStream codedStream(zeroCopyStream);
+    codedStream.WriteLittleEndian32(magicNumber);
+}
+
+void
+ProtoOutputStream::writeMessage(const Message& msg)
 {
     // Due to the byte limit of the coded stream we create it for
     // every single mesage (based on forum discussions around the size
@@ -100,9 +205,87 @@ ProtoOutputStream::write(const Message& msg)
     msg.SerializeWithCachedSizes(&codedStream);
 }
 
+void
+ProtoOutputStream::write(const Message& msg)
+{
+    if (!chunkSize) {
+        writeMessage(msg);
+        return;
+    }
+
+    {
+        io::StringOutputStream stringStream(&chunkBuffer);
+        zeroCopyStream = &stringStream;
+        writeMessage(msg);
+        zeroCopyStream = NULL;
+    }
+
+    // End the first chunk after the header so that readers can seek
+    // past it, and the others once they are large enough
+    ++chunk.messages;
+    if (index.empty() || chunkBuffer.size() >= chunkSize)
+        writeChunk();
+}
+
+void
+ProtoOutputStream::write(const Message& msg, uint64_t key)
+{
+    chunk.firstKey = std::min(chunk.firstKey, key);
+    chunk.lastKey = std::max(chunk.lastKey, key);
+    write(msg);
+}
+
+void
+ProtoOutputStream::writeChunk()
+{
+    z_stream zs = {};
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        panic("Could not initialize the trace compression\n");
+    }
+
+    std::string compressed(deflateBound(&zs, chunkBuffer.size()), '\0');
+    zs.next_in = (Bytef*)chunkBuffer.data();
+    zs.avail_in = chunkBuffer.size();
+    zs.next_out = (Bytef*)&compressed[0];
+    zs.avail_out = compressed.size();
+    const int ret = deflate(&zs, Z_FINISH);
+    panic_if(ret != Z_STREAM_END, "Could not compress a trace chunk\n");
+    deflateEnd(&zs);
+
+    fileStream.write(compressed.data(), zs.total_out);
+
+    index.push_back(chunk);
+    chunk = {chunk.offset + zs.total_out, 0, noKey, 0};
+    chunkBuffer.clear();
+}
+
+void
+ProtoOutputStream::writeIndex()
+{
+    const size_t max_entries = (0xffff - 4) / chunkEntrySize;
+
+    for (size_t first = 0; first < index.size(); first += max_entries) {
+        const size_t last = std::min(index.size(), first + max_entries);
+        std::string entries;
+        for (size_t i = first; i < last; ++i) {
+            putLittleEndian64(entries, index[i].offset);
+            putLittleEndian64(entries, index[i].messages);
+            putLittleEndian64(entries, index[i].firstKey);
+            putLittleEndian64(entries, index[i].lastKey);
+        }
+        writeExtraMember(fileStream, chunkIndexId, entries);
+    }
+
+    std::string trailer;
+    putLittleEndian64(trailer, chunk.offset);
+    putLittleEndian64(trailer, index.size());
+    writeExtraMember(fileStream, indexTrailerId, trailer);
+}
+
 ProtoInputStream::ProtoInputStream(const std::string& filename) :
     fileStream(filename.c_str(), std::ios::in | std::ios::binary),
-    fileName(filename), useGzip(false),
+    fileName(filename), useGzip(false), indexOffset(0),
     wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
 {
     if (!fileStream.good())
@@ -113,6 +296,9 @@ ProtoInputStream::ProtoInputStream(const std::string& filename) :
     fileStream.read((char*) bytes, 2);
     useGzip = fileStream.good() && bytes[0] == 0x1f && bytes[1] == 0x8b;
 
+    if (useGzip)
+        readIndex();
+
     // seek to the start of the input file and clear any flags
     fileStream.clear();
     fileStream.seekg(0, std::ifstream::beg);
@@ -121,7 +307,52 @@ ProtoInputStream::ProtoInputStream(const std::string& filename) :
 }
 
 void
-ProtoInputStream::createStreams()
+ProtoInputStream::readIndex()
+{
+    // Compressed traces written before the index was introduced, or
+    // by other tools, simply have no index
+    fileStream.clear();
+    fileStream.seekg(0, std::ifstream::end);
+    const uint64_t size = fileStream.tellg();
+    if (size < indexTrailerSize)
+        return;
+
+    std::string trailer;
+    fileStream.seekg(size - indexTrailerSize, std::ifstream::beg);
+    if (!readExtraMember(fileStream, indexTrailerId, trailer) ||
+        trailer.size() != 16) {
+        return;
+    }
+
+    const auto* data = (const unsigned char*)trailer.data();
+    const uint64_t offset = getLittleEndian64(&data[0]);
+    const uint64_t num_chunks = getLittleEndian64(&data[8]);
+
+    std::vector<Chunk> chunks;
+    fileStream.seekg(offset, std::ifstream::beg);
+    while (chunks.size() < num_chunks) {
+        std::string entries;
+        if (!readExtraMember(fileStream, chunkIndexId, entries) ||
+            entries.size() % chunkEntrySize) {
+            warn("Ignoring the corrupted chunk index of %s\n", fileName);
+            return;
+        }
+
+        data = (const unsigned char*)entries.data();
+        for (size_t i = 0; i < entries.size(); i += chunkEntrySize) {
+            chunks.push_back({getLittleEndian64(&data[i]),
+                              getLittleEndian64(&data[i + 8]),
+                              getLittleEndian64(&data[i + 16]),
+                              getLittleEndian64(&data[i + 24])});
+        }
+    }
+
+    index = std::move(chunks);
+    indexOffset = offset;
+}
+
+void
+ProtoInputStream::createStreams(bool check_magic)
 {
     // All streams should be NULL at this point
     assert(wrappedFileStream == NULL && gzipStream == NULL &&
@@ -138,6 +369,9 @@ ProtoInputStream::createStreams()
         zeroCopyStream = wrappedFileStream;
     }
 
+    if (!check_magic)
+        return;
+
     uint32_t magic_check;
     io::CodedInputStream codedStream(zeroCopyStream);
     if (!codedStream.ReadLittleEndian32(&magic_check) ||
@@ -178,6 +412,35 @@ ProtoInputStream::reset()
     createStreams();
 }
 
+void
+ProtoInputStream::seekChunk(size_t chunk)
+{
+    panic_if(chunk > index.size(), "Seeking to chunk %d of %s which only "
+             "has %d chunks.\n", chunk, fileName, index.size());
+
+    destroyStreams();
+    fileStream.clear();
+    fileStream.seekg(chunk < index.size() ? index[chunk].offset :
+                     indexOffset, std::ifstream::beg);
+    createStreams(chunk == 0);
+}
+
+bool
+ProtoInputStream::seek(uint64_t key)
+{
+    if (index.empty())
+        return false;
+
+    // The first chunk only holds the header
+    size_t chunk = 1;
+    while (chunk < index.size() && index[chunk].firstKey != noKey &&
+           index[chunk].lastKey < key) {
+        ++chunk;
+    }
+    seekChunk(chunk);
+    return true;
+}
+
 bool
 ProtoInputStream::read(Message& msg)
 {
@@ -49,20 +49,60 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <cstdint>
 #include <fstream>
+#include <string>
+#include <vector>
 
 /**
  * A ProtoStream provides the shared functionality of the input and
- * output streams. At the moment this is limited to magic number.
+ * output streams: the magic number and the layout of chunked traces.
+ *
+ * Compressed traces are written in chunks, each compressed as an
+ * independent gzip member, so that a reader can start decompressing
+ * at any chunk. The first chunk holds the magic number and the first
+ * message, which is the header of the trace, and the others a number
+ * of whole messages. The chunks are followed by an index, stored in
+ * the extra field of empty gzip members: members with the subfield
+ * ID "gc" hold the index entries, and a final member of a fixed size
+ * with the subfield ID "gi" holds the offset of the first of these
+ * members and the number of chunks. As the index members decompress
+ * to nothing, a chunked trace is a valid gzip file and can be read
+ * from the start by any gzip reader.
  */
 class ProtoStream
 {
 
+  public:
+
+    /**
+     * An entry of the chunk index. Messages written with a key, such
+     * as their tick, set the range of keys of their chunk, which lets
+     * readers find the chunk to start reading at.
+     */
+    struct Chunk
+    {
+        /// Offset of the chunk in the file
+        uint64_t offset;
+        /// Number of messages in the chunk
+        uint64_t messages;
+        /// Smallest key of the messages, or UINT64_MAX if none had one
+        uint64_t firstKey;
+        /// Largest key of the messages, or 0 if none had one
+        uint64_t lastKey;
+    };
+
   protected:
 
     /// Use the ASCII characters gem5 as our magic number
     static const uint32_t magicNumber = 0x356d6567;
 
+    /// Size of an encoded index entry
+    static const size_t chunkEntrySize = 32;
+
+    /// Size of the gzip member that locates the index
+    static const size_t indexTrailerSize = 42;
+
     /**
      * Create a ProtoStream.
      */
@@ -94,11 +134,14 @@ class ProtoOutputStream : public ProtoStream
 
     /**
      * Create an output stream for a given file name. If the filename
-     * ends with .gz then the file will be compressed accordinly.
+     * ends with .gz then the file will be compressed accordinly, in
+     * chunks of about chunk_size bytes of messages.
      *
      * @param filename Path to the file to create or truncate
+     * @param chunk_size Uncompressed size of the chunks
      */
-    ProtoOutputStream(const std::string& filename);
+    ProtoOutputStream(const std::string& filename,
+                      size_t chunk_size = 1 << 20);
 
     /**
      * Destruct the output stream, and also flush and close the
@@ -114,18 +157,58 @@ class ProtoOutputStream : public ProtoStream
      */
     void write(const google::protobuf::Message& msg);
 
+    /**
+     * Write a message to the stream with a key, e.g. its tick, that
+     * readers can seek to. Keys should not decrease from one message
+     * to the next.
+     *
+     * @param msg Message to write to the stream
+     * @param key Key of the message
+     */
+    void write(const google::protobuf::Message& msg, uint64_t key);
+
   private:
 
+    /**
+     * Write the magic number to the zero copy stream.
+     */
+    void writeMagic();
+
+    /**
+     * Write a message and its size to the zero copy stream.
+     */
+    void writeMessage(const google::protobuf::Message& msg);
+
+    /**
+     * Compress the buffered messages into a chunk, and add the chunk
+     * to the index.
+     */
+    void writeChunk();
+
+    /**
+     * Write the index after the last chunk.
+     */
+    void writeIndex();
+
     /// Underlying file output stream
     std::ofstream fileStream;
 
+    /// Uncompressed size a chunk is written at, 0 if not chunked
+    const size_t chunkSize;
+
+    /// Messages of the chunk being built
+    std::string chunkBuffer;
+
+    /// Index entry of the chunk being built
+    Chunk chunk;
+
+    /// Index entries of the chunks written so far
+    std::vector<Chunk> index;
+
     /// Zero Copy stream wrapping the STL output stream
     google::protobuf::io::OstreamOutputStream* wrappedFileStream;
 
-    /// Optional Gzip stream to wrap the Zero Copy stream
-    google::protobuf::io::GzipOutputStream* gzipStream;
-
-    /// Top-level zero-copy stream, either with compression or not
+    /// Top-level zero-copy stream, either the file or the chunk buffer
     google::protobuf::io::ZeroCopyOutputStream* zeroCopyStream;
 
 };
@@ -169,12 +252,45 @@ class ProtoInputStream : public ProtoStream
      */
     void reset();
 
+    /**
+     * Get the chunks of a chunked trace.
+     *
+     * @return The chunk index, empty if the trace has none
+     */
+    const std::vector<Chunk>& chunks() const { return index; }
+
+    /**
+     * Continue reading at the start of a chunk. Seeking to the number
+     * of chunks moves to the end of the trace.
+     *
+     * @param chunk Index of the chunk
+     */
+    void seekChunk(size_t chunk);
+
+    /**
+     * Continue reading at the first chunk that may contain messages
+     * with a key of at least the given one, skipping the header. The
+     * messages of that chunk before the key still have to be skipped
+     * by the caller.
+     *
+     * @param key Key to seek to
+     * @return False if the trace has no index
+     */
+    bool seek(uint64_t key);
+
   private:
 
     /**
      * Create the internal streams that are wrapping the input file.
+     *
+     * @param check_magic Read and check the magic number
+     */
+    void createStreams(bool check_magic=true);
+
+    /**
+     * Read the chunk index, if the file has one.
      */
-    void createStreams();
+    void readIndex();
 
     /**
      * Destroy the internal streams that are wrapping the input file.
@@ -190,6 +306,12 @@ class ProtoInputStream : public ProtoStream
     /// Boolean flag to remember whether we use gzip or not
     bool useGzip;
 
+    /// Index entries of a chunked trace
+    std::vector<Chunk> index;
+
+    /// Offset of the end of the last chunk
+    uint64_t indexOffset;
+
     /// Zero Copy stream wrapping the STL input stream
     google::protobuf::io::IstreamInputStream* wrappedFileStream;
 
@@ -301,6 +301,15 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-format",
+        metavar="{text,binary}",
+        choices=["text", "binary"],
+        default="text",
+        help="Format of the debug output. Binary output is written by a "
+        "separate thread and decoded with util/decode_debug_trace.py "
+        "[Default: %default]",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -610,7 +619,7 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    trace.output(options.debug_file, options.debug_format == "binary")
 
     for activate in options.debug_activate:
         _check_tracing()
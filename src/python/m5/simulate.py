@@ -321,7 +321,15 @@ def memInvalidate(root):
         obj.memInvalidate()
 
 
-def checkpoint(dir):
+def checkpoint(dir, binary=False):
+    """Write a checkpoint of the simulated system to dir.
+
+    If binary is set, the checkpoint is written as a memory-mappable
+    m5.cpt.bin file instead of the text m5.cpt file. Binary checkpoints
+    are restored without parsing, and only the sections that are
+    unserialized are decoded. Existing text checkpoints can be converted
+    with util/cpt_binary.py.
+    """
     root = objects.Root.getInstance()
     if not isinstance(root, objects.Root):
         raise TypeError("Checkpoint must be called on a root object.")
@@ -333,7 +341,7 @@ def checkpoint(dir):
     os.makedirs(dir, exist_ok=True)
 
     print("Writing checkpoint")
-    _m5.core.serializeAll(dir)
+    _m5.core.serializeAll(dir, binary)
 
 
 def _changeMemoryMode(system, mode):
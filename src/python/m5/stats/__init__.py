@@ -190,6 +190,32 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["bin"])
+def _columnarFactory(fn, desc=True, delta=False):
+    """Output stats in a columnar binary format.
+
+    The names of the stats are written once and every dump is appended
+    as a single row of doubles. This makes it well suited for periodic
+    dumps, where it is a lot smaller and faster than the text format.
+    Use util/stats_columnar.py to convert the files to CSV or to load
+    them in pandas.
+
+    In delta mode, only the stats that changed since the previous dump
+    are written, together with a bitmap of the changed columns. This
+    is much smaller when few stats change between periodic dumps.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+      * delta (bool): Only write the stats that changed (default: False)
+
+    Example:
+      bin://stats.bin?desc=False;delta=True
+
+    """
+
+    return _m5.stats.initColumnar(fn, desc, delta)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -257,22 +283,6 @@ def initSimStats():
     _m5.stats.registerPythonStatsHandlers()
 
 
-def _visit_groups(visitor, root=None):
-    if root is None:
-        root = Root.getInstance()
-    for group in root.getStatGroups().values():
-        visitor(group)
-        _visit_groups(visitor, root=group)
-
-
-def _visit_stats(visitor, root=None):
-    def for_each_stat(g):
-        for stat in g.getStats():
-            visitor(g, stat)
-
-    _visit_groups(for_each_stat, root=root)
-
-
 def _bindStatHierarchy(root):
     def _bind_obj(name, obj):
         if isNullPointer(obj):
@@ -313,74 +323,34 @@ def enable():
     enabled, all statistics must be created and initialized and once
     the package is enabled, no more statistics can be created."""
 
-    def check_stat(group, stat):
-        if not stat.check() or not stat.baseCheck():
-            fatal(
-                "statistic '%s' (%d) was not properly initialized "
-                "by a regStats() function\n",
-                stat.name,
-                stat.id,
-            )
-
-        if not (stat.flags & flags.display):
-            stat.name = "__Stat%06d" % stat.id
+    # The stats are checked, enabled and flattened for the dumps in
+    # C++, which is much faster than walking the hierarchy from here.
+    _m5.stats.enableAll()
 
-    # Legacy stat
+    # Legacy stats, sorted by name when they were enabled
     global stats_list
     stats_list = list(_m5.stats.statsList())
-
-    for stat in stats_list:
-        check_stat(None, stat)
-
-    stats_list.sort(key=lambda s: s.name.split("."))
     for stat in stats_list:
         stats_dict[stat.name] = stat
-        stat.enable()
-
-    # New stats
-    _visit_stats(check_stat)
-    _visit_stats(lambda g, s: s.enable())
-
-    _m5.stats.enable()
 
 
 def prepare():
     """Prepare all stats for data access.  This must be done before
     dumping and serialization."""
 
-    # Legacy stats
-    for stat in stats_list:
-        stat.prepare()
-
-    # New stats
-    _visit_stats(lambda g, s: s.prepare())
+    _m5.stats.prepareAll()
 
 
 def _dump_to_visitor(visitor, roots=None):
-    # New stats
-    def dump_group(group):
-        for stat in group.getStats():
-            stat.visit(visitor)
-        for n, g in group.getStatGroups().items():
-            visitor.beginGroup(n)
-            dump_group(g)
-            visitor.endGroup()
-
     if roots:
         # New stats from selected subroots.
         for root in roots:
-            for p in root.path_list():
-                visitor.beginGroup(p)
-            dump_group(root)
-            for p in reversed(root.path_list()):
-                visitor.endGroup()
+            _m5.stats.dumpGroup(
+                visitor, root.getCCObject(), list(root.path_list())
+            )
     else:
-        # New stats starting from root.
-        dump_group(Root.getInstance())
-
-        # Legacy stats
-        for stat in stats_list:
-            stat.visit(visitor)
+        # New stats starting from root, followed by the legacy stats.
+        _m5.stats.dumpAll(visitor)
 
 
 lastDump = 0
@@ -333,7 +333,8 @@ pybind_init_core(py::module_ &m_native)
      * Serialization helpers
      */
     m_core
-        .def("serializeAll", &SimObject::serializeAll)
+        .def("serializeAll", &SimObject::serializeAll,
+             py::arg("cpt_dir"), py::arg("binary") = false)
         .def("getCheckpoint", [](const std::string &cpt_dir) {
             SimObject::setSimObjectResolver(&pybindSimObjectResolver);
             return new CheckpointIn(cpt_dir);
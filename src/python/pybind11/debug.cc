@@ -45,6 +45,7 @@
 #include <map>
 #include <vector>
 
+#include "base/binary_logger.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
@@ -57,14 +58,20 @@ namespace gem5
 {
 
 static void
-output(const char *filename)
+output(const char *filename, bool binary)
 {
     OutputStream *file_stream = simout.find(filename);
 
     if (!file_stream)
-        file_stream = simout.create(filename);
-
-    trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
+        file_stream = simout.create(filename, binary);
+
+    if (binary) {
+        trace::setDebugLogger(
+            new trace::BinaryLogger(*file_stream->stream()));
+    } else {
+        trace::setDebugLogger(
+            new trace::OstreamLogger(*file_stream->stream()));
+    }
 }
 
 static void
@@ -128,7 +135,8 @@ pybind_init_debug(py::module_ &m_native)
 
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
-        .def("output", &output)
+        .def("output", &output, py::arg("filename"),
+             py::arg("binary") = false)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
@@ -42,6 +42,7 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -111,6 +112,8 @@ pybind_init_stats(py::module_ &m_native)
         .def("initSimStats", &statistics::initSimStats)
         .def("initText", &statistics::initText,
             py::return_value_policy::reference)
+        .def("initColumnar", &statistics::initColumnar,
+            py::return_value_policy::reference)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
@@ -122,6 +125,10 @@ pybind_init_stats(py::module_ &m_native)
         .def("processResetQueue", &statistics::processResetQueue)
         .def("processDumpQueue", &statistics::processDumpQueue)
         .def("enable", &statistics::enable)
+        .def("enableAll", &statistics::enableAll)
+        .def("prepareAll", &statistics::prepareAll)
+        .def("dumpAll", &statistics::dumpAll)
+        .def("dumpGroup", &statistics::dumpGroup)
         .def("enabled", &statistics::enabled)
         .def("statsList", &statistics::statsList)
         ;
@@ -49,6 +49,29 @@ class MemoryMode(Enum):
     vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
 
 
+class HostHugePages(ScopedEnum):
+    """
+    none: back guest memory with regular host pages
+    transparent: advise the host kernel to use transparent huge pages
+    hugetlb: map guest memory from the host hugetlb pool, falling back
+             to transparent huge pages if that is not possible
+    """
+
+    vals = ["none", "transparent", "hugetlb"]
+
+
+class HostNumaPolicy(ScopedEnum):
+    """
+    local: leave the placement to the host kernel, which puts pages on
+           the node of the thread that first touches them
+    bind: bind each backing store to one of the given host nodes, in
+          turn, so that consecutive ranges end up on different nodes
+    interleave: interleave every backing store across the given nodes
+    """
+
+    vals = ["local", "bind", "interleave"]
+
+
 class System(SimObject):
     type = "System"
     cxx_header = "sim/system.hh"
@@ -104,6 +127,56 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    # Large guest memories benefit from being backed by huge pages on
+    # the host, as functional accesses otherwise miss in the host TLB
+    # all the time. On NUMA hosts the backing stores can also be
+    # placed on specific nodes, e.g. close to the threads of the event
+    # queues using them.
+    mem_backing_huge_pages = Param.HostHugePages(
+        "none", "Host page size used for the backing store"
+    )
+    mem_backing_numa_policy = Param.HostNumaPolicy(
+        "local", "Host NUMA placement of the backing store"
+    )
+    mem_backing_numa_nodes = VectorParam.Unsigned(
+        [], "Host NUMA nodes used by the bind and interleave policies"
+    )
+
+    # Memory checkpoints are written as a single gzip stream by
+    # default. With a non-zero chunk size they are split in chunks that
+    # are compressed independently on a pool of host threads, which is
+    # much faster for large memories. Both formats can be restored.
+    mem_checkpoint_chunk_size = Param.MemorySize(
+        "0",
+        "Size of independently compressed chunks in memory "
+        "checkpoints, 0 to use a single gzip stream",
+    )
+    mem_checkpoint_threads = Param.Unsigned(
+        0,
+        "Host threads used to compress and decompress chunked memory "
+        "checkpoints, 0 to use one thread per host core",
+    )
+    mem_checkpoint_lazy_restore = Param.Bool(
+        False,
+        "Restore chunked memory checkpoints on demand, filling each "
+        "chunk when it is first accessed",
+    )
+    # Delta checkpoints only store the chunks that changed since the
+    # previous checkpoint taken or restored in this run, and refer to
+    # that checkpoint for the rest. The whole chain of checkpoints has
+    # to be kept to restore the last one.
+    mem_checkpoint_delta = Param.Bool(
+        False,
+        "Write chunked memory checkpoints as deltas against the "
+        "previous checkpoint",
+    )
+    mem_checkpoint_delta_max_chain = Param.Unsigned(
+        8,
+        "Longest chain of delta memory checkpoints, including the full "
+        "checkpoint at its base; a full checkpoint is written rather "
+        "than a delta that would exceed it",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
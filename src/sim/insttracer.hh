@@ -156,6 +156,16 @@ class InstRecord
      */
     bool faulting = false;
 
+    /**
+     * Was the instruction redecoded by the CPU to execute as another op
+     * class than its static one?
+     * @see redecoded_op_class
+     */
+    bool redecoded = false;
+
+    /** The op class a redecoded instruction executed as. */
+    OpClass redecoded_op_class = No_OpClass;
+
   public:
     InstRecord(Tick _when, ThreadContext *_thread,
                const StaticInstPtr _staticInst, const PCStateBase &_pc,
@@ -260,6 +270,13 @@ class InstRecord
 
     void setFaulting(bool val) { faulting = val; }
 
+    void
+    setRedecoded(OpClass op_class)
+    {
+        redecoded_op_class = op_class;
+        redecoded = true;
+    }
+
     virtual void dump() = 0;
 
   public:
@@ -285,6 +302,9 @@ class InstRecord
     bool getCpSeqValid() const { return cp_seq_valid; }
 
     bool getFaulting() const { return faulting; }
+
+    bool getRedecoded() const { return redecoded; }
+    OpClass getRedecodedOpClass() const { return redecoded_op_class; }
 };
 
 /**
@@ -45,9 +45,11 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <cassert>
 #include <cerrno>
+#include <utility>
 
 #include "base/trace.hh"
 #include "debug/Checkpoint.hh"
@@ -92,6 +94,10 @@ Serializable::generateCheckpointOut(const std::string &cpt_dir,
     if (mkdir(dir.c_str(), 0775) == -1 && errno != EEXIST)
             fatal("couldn't mkdir %s\n", dir);
 
+    // Do not leave a stale binary checkpoint next to the new one, as it
+    // would otherwise be restored instead
+    unlink((dir + CheckpointIn::binaryFilename).c_str());
+
     std::string cpt_file = dir + CheckpointIn::baseFilename;
     outstream = std::ofstream(cpt_file.c_str());
     time_t t = time(NULL);
@@ -100,6 +106,22 @@ Serializable::generateCheckpointOut(const std::string &cpt_dir,
     outstream << "## checkpoint generated: " << ctime(&t);
 }
 
+void
+Serializable::generateBinaryCheckpointOut(const std::string &cpt_dir,
+        BinaryIniFile::Writer &writer)
+{
+    std::string dir = CheckpointIn::setDir(cpt_dir);
+    if (mkdir(dir.c_str(), 0775) == -1 && errno != EEXIST)
+            fatal("couldn't mkdir %s\n", dir);
+
+    // Do not leave a stale text checkpoint next to the new one
+    unlink((dir + CheckpointIn::baseFilename).c_str());
+
+    std::string cpt_file = dir + CheckpointIn::binaryFilename;
+    fatal_if(!writer.open(cpt_file), "Unable to write binary checkpoint: "
+             "%s\n", writer.error());
+}
+
 Serializable::ScopedCheckpointSection::~ScopedCheckpointSection()
 {
     assert(!path.empty());
@@ -136,6 +158,8 @@ Serializable::currentSection()
 
 const char *CheckpointIn::baseFilename = "m5.cpt";
 
+const char *CheckpointIn::binaryFilename = "m5.cpt.bin";
+
 std::string CheckpointIn::currentDirectory;
 
 std::string
@@ -162,7 +186,36 @@ CheckpointIn::dir()
 CheckpointIn::CheckpointIn(const std::string &cpt_dir)
     : db(), _cptDir(setDir(cpt_dir))
 {
+    std::string bin_file = getCptDir() + "/" + CheckpointIn::binaryFilename;
     std::string filename = getCptDir() + "/" + CheckpointIn::baseFilename;
+
+    // Writing a checkpoint removes the file of the other format, but
+    // both can still be present after converting or upgrading one of
+    // them by hand. In that case the one written last is the current
+    // checkpoint; on a tie, prefer the binary one, which is mapped
+    // rather than parsed.
+    struct stat bin_st, text_st;
+    bool use_bin = stat(bin_file.c_str(), &bin_st) == 0;
+    if (use_bin && stat(filename.c_str(), &text_st) == 0) {
+        use_bin = std::make_pair(bin_st.st_mtim.tv_sec,
+                                 bin_st.st_mtim.tv_nsec) >=
+                  std::make_pair(text_st.st_mtim.tv_sec,
+                                 text_st.st_mtim.tv_nsec);
+        warn("Checkpoint %s holds both %s and %s, restoring the newer %s\n",
+             getCptDir(), CheckpointIn::baseFilename,
+             CheckpointIn::binaryFilename,
+             use_bin ? CheckpointIn::binaryFilename :
+                       CheckpointIn::baseFilename);
+    }
+
+    if (use_bin) {
+        binDb = std::make_unique<BinaryIniFile>();
+        if (!binDb->load(bin_file))
+            fatal("Can't load binary checkpoint file '%s'\n", bin_file);
+        DPRINTF(Checkpoint, "Mapped binary checkpoint %s\n", bin_file);
+        return;
+    }
+
     if (!db.load(filename)) {
         fatal("Can't load checkpoint file '%s'\n", filename);
     }
@@ -180,6 +233,8 @@ CheckpointIn::CheckpointIn(const std::string &cpt_dir)
 bool
 CheckpointIn::entryExists(const std::string &section, const std::string &entry)
 {
+    if (binDb)
+        return binDb->entryExists(section, entry);
     return db.entryExists(section, entry);
 }
 /**
@@ -196,12 +251,23 @@ bool
 CheckpointIn::find(const std::string &section, const std::string &entry,
         std::string &value)
 {
+    if (binDb)
+        return binDb->find(section, entry, value);
     return db.find(section, entry, value);
 }
 
+bool
+CheckpointIn::findArray(const std::string &section, const std::string &entry,
+        std::vector<int64_t> &values)
+{
+    return binDb && binDb->findArray(section, entry, values);
+}
+
 bool
 CheckpointIn::sectionExists(const std::string &section)
 {
+    if (binDb)
+        return binDb->sectionExists(section);
     return db.sectionExists(section);
 }
 
@@ -209,7 +275,10 @@ void
 CheckpointIn::visitSection(const std::string &section,
     IniFile::VisitSectionCallback cb)
 {
-    db.visitSection(section, cb);
+    if (binDb)
+        binDb->visitSection(section, cb);
+    else
+        db.visitSection(section, cb);
 }
 
 } // namespace gem5
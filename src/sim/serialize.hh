@@ -50,12 +50,15 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <stack>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+#include "base/binary_inifile.hh"
 #include "base/inifile.hh"
 #include "base/logging.hh"
 #include "sim/serialize_handlers.hh"
@@ -70,6 +73,9 @@ class CheckpointIn
   private:
     IniFile db;
 
+    /** Memory-mapped binary checkpoint, used instead of db if present. */
+    std::unique_ptr<BinaryIniFile> binDb;
+
     const std::string _cptDir;
 
   public:
@@ -87,6 +93,17 @@ class CheckpointIn
     bool find(const std::string &section, const std::string &entry,
               std::string &value);
 
+    /**
+     * Look up an integer array stored as a typed value in a binary
+     * checkpoint. Returns false for text checkpoints and untyped values,
+     * in which case the caller should fall back to find().
+     */
+    bool findArray(const std::string &section, const std::string &entry,
+                   std::vector<int64_t> &values);
+
+    /** Whether this checkpoint was restored from the binary format. */
+    bool isBinary() const { return binDb != nullptr; }
+
     bool entryExists(const std::string &section, const std::string &entry);
     bool sectionExists(const std::string &section);
     void visitSection(const std::string &section,
@@ -130,6 +147,9 @@ class CheckpointIn
 
     // Filename for base checkpoint file within directory.
     static const char *baseFilename;
+
+    // Filename for the binary base checkpoint file within directory.
+    static const char *binaryFilename;
 };
 
 /**
@@ -311,6 +331,19 @@ class Serializable
     static void generateCheckpointOut(const std::string &cpt_dir,
         std::ofstream &outstream);
 
+    /**
+     * Open a binary checkpoint file so that the serialization can be
+     * routed to it through the writer. Any text checkpoint file left in
+     * the directory is removed, so that it cannot be mistaken for the
+     * current checkpoint.
+     *
+     * @param cpt_dir The dir at which the cpt file will be created.
+     * @param writer The writer to open on the binary cpt file.
+     * @ingroup api_serialize
+     */
+    static void generateBinaryCheckpointOut(const std::string &cpt_dir,
+        BinaryIniFile::Writer &writer);
+
   private:
     static std::stack<std::string> path;
 };
@@ -442,6 +475,33 @@ arrayParamIn(CheckpointIn &cp, const std::string &name,
              InsertIterator inserter, ssize_t fixed_size=-1)
 {
     const std::string &section = Serializable::currentSection();
+
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        // Binary checkpoints store integer arrays in typed form, so they
+        // can be restored without going through their text form.
+        std::vector<int64_t> ints;
+        if (cp.findArray(section, name, ints)) {
+            fatal_if(fixed_size >= 0 && ints.size() != fixed_size,
+                     "Array size mismatch on %s:%s (Got %u, expected %u)'\n",
+                     section, name, ints.size(), fixed_size);
+
+            for (const auto &i: ints) {
+                // Mirror the range checks done by to_number().
+                bool ok;
+                if constexpr (std::is_signed_v<T>) {
+                    ok = i >= std::numeric_limits<T>::lowest() &&
+                        i <= std::numeric_limits<T>::max();
+                } else {
+                    ok = (unsigned long long)i <=
+                        std::numeric_limits<T>::max();
+                }
+                fatal_if(!ok, "Could not parse \"%d\".", i);
+                *inserter = static_cast<T>(i);
+            }
+            return;
+        }
+    }
+
     std::string str;
     fatal_if(!cp.find(section, name, str),
         "Can't unserialize '%s:%s'.", section, name);
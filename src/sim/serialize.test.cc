@@ -40,6 +40,7 @@
 #include <list>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -897,6 +898,124 @@ TEST_F(SerializeFixture, ArrayParamOutIn)
     }
 }
 
+/**
+ * Test that a binary checkpoint restores scalars and arrays, including
+ * integer arrays stored in typed form, to the same values as the text
+ * checkpoint they were converted from.
+ */
+TEST_F(SerializeFixture, BinaryCheckpointOutIn)
+{
+    const int integer[] = {5, -10, 15};
+    std::vector<uint64_t> uint64 = {12751928501, 13, 0};
+    std::deque<uint8_t> uint8 = {17, 42, 255};
+    std::vector<std::string> str = {"a", "string", "test"};
+    std::array<double, 2> real = {0.1, 1e+10};
+
+    BinaryIniFile::Writer writer;
+    Serializable::generateBinaryCheckpointOut(getDirName(), writer);
+    {
+        std::ostream cp(&writer);
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        paramOut(cp, "Scalar", std::string("some text"));
+        arrayParamOut(cp, "Param1", integer);
+        arrayParamOut(cp, "Param2", uint64);
+        arrayParamOut(cp, "Param3", uint8);
+        arrayParamOut(cp, "Param4", str);
+        arrayParamOut(cp, "Param5", real);
+    }
+    ASSERT_TRUE(writer.close()) << writer.error();
+
+    CheckpointIn cpt(getDirName());
+    ASSERT_TRUE(cpt.isBinary());
+    ASSERT_TRUE(cpt.sectionExists("Section1"));
+
+    int unserialized_integer[3];
+    std::vector<uint64_t> unserialized_uint64;
+    std::deque<uint8_t> unserialized_uint8;
+    std::vector<std::string> unserialized_str;
+    std::array<double, 2> unserialized_real;
+    std::string scalar;
+
+    Serializable::ScopedCheckpointSection scs(cpt, "Section1");
+
+    std::vector<int64_t> ints;
+    ASSERT_TRUE(cpt.findArray("Section1", "Param1", ints));
+    ASSERT_FALSE(cpt.findArray("Section1", "Param4", ints));
+
+    paramIn(cpt, "Scalar", scalar);
+    ASSERT_EQ(scalar, "some text");
+
+    arrayParamIn(cpt, "Param1", unserialized_integer, 3);
+    ASSERT_THAT(unserialized_integer, testing::ElementsAre(5, -10, 15));
+
+    arrayParamIn(cpt, "Param2", unserialized_uint64);
+    ASSERT_EQ(uint64, unserialized_uint64);
+
+    arrayParamIn(cpt, "Param3", unserialized_uint8);
+    ASSERT_EQ(uint8, unserialized_uint8);
+
+    arrayParamIn(cpt, "Param4", unserialized_str);
+    ASSERT_EQ(str, unserialized_str);
+
+    arrayParamIn(cpt, "Param5", unserialized_real.data(),
+        unserialized_real.size());
+    ASSERT_EQ(real, unserialized_real);
+}
+
+/**
+ * Test that writing a checkpoint in one format removes a checkpoint file
+ * of the other format left in the same directory, so that restoring
+ * never picks up stale state.
+ */
+TEST_F(SerializeFixture, CheckpointFormatSwitch)
+{
+    // Binary checkpoint first
+    {
+        BinaryIniFile::Writer writer;
+        Serializable::generateBinaryCheckpointOut(getDirName(), writer);
+        std::ostream cp(&writer);
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        paramOut(cp, "Value", 1);
+        ASSERT_TRUE(writer.close()) << writer.error();
+    }
+
+    // A later text checkpoint into the same directory replaces it
+    {
+        std::ofstream cp;
+        Serializable::generateCheckpointOut(getDirName(), cp);
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        paramOut(cp, "Value", 2);
+    }
+    {
+        CheckpointIn cpt(getDirName());
+        ASSERT_FALSE(cpt.isBinary());
+        Serializable::ScopedCheckpointSection scs(cpt, "Section1");
+        int value = 0;
+        paramIn(cpt, "Value", value);
+        ASSERT_EQ(value, 2);
+    }
+
+    // And so does a later binary checkpoint
+    {
+        BinaryIniFile::Writer writer;
+        Serializable::generateBinaryCheckpointOut(getDirName(), writer);
+        std::ostream cp(&writer);
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        paramOut(cp, "Value", 3);
+        ASSERT_TRUE(writer.close()) << writer.error();
+    }
+    {
+        std::ifstream text(getCptPath());
+        ASSERT_FALSE(text.good());
+        CheckpointIn cpt(getDirName());
+        ASSERT_TRUE(cpt.isBinary());
+        Serializable::ScopedCheckpointSection scs(cpt, "Section1");
+        int value = 0;
+        paramIn(cpt, "Value", value);
+        ASSERT_EQ(value, 3);
+    }
+}
+
 /**
  * Test arrayParamOut and arrayParamIn for strings with spaces.
  * @todo This is broken because spaces are delimiters between array
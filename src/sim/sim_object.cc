@@ -129,10 +129,16 @@ SimObject::getPort(const std::string &if_name, PortID idx)
 // static function: serialize all SimObjects.
 //
 void
-SimObject::serializeAll(const std::string &cpt_dir)
+SimObject::serializeAll(const std::string &cpt_dir, bool binary)
 {
-    std::ofstream cp;
-    Serializable::generateCheckpointOut(cpt_dir, cp);
+    std::ofstream file;
+    BinaryIniFile::Writer writer;
+    std::ostream binary_stream(&writer);
+    if (binary)
+        Serializable::generateBinaryCheckpointOut(cpt_dir, writer);
+    else
+        Serializable::generateCheckpointOut(cpt_dir, file);
+    CheckpointOut &cp = binary ? binary_stream : file;
 
     SimObjectList::reverse_iterator ri = simObjectList.rbegin();
     SimObjectList::reverse_iterator rend = simObjectList.rend();
@@ -143,6 +149,11 @@ SimObject::serializeAll(const std::string &cpt_dir)
         // since we are at the top level.
         obj->serializeSection(cp, obj->name());
    }
+
+    if (binary) {
+        fatal_if(!writer.close(), "Unable to write binary checkpoint: %s\n",
+                 writer.error());
+    }
 }
 
 SimObject *
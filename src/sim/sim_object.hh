@@ -326,8 +326,13 @@ class SimObject : public EventManager, public Serializable, public Drainable,
      * in its own section. As such, the serialization functions should not
      * be called on sim objects anywhere else; otherwise, these objects
      * would be needlessly serialized more than once.
+     *
+     * @param cpt_dir The checkpoint directory.
+     * @param binary Write a memory-mappable binary checkpoint
+     *        (m5.cpt.bin) instead of the text m5.cpt file.
      */
-    static void serializeAll(const std::string &cpt_dir);
+    static void serializeAll(const std::string &cpt_dir,
+                             bool binary=false);
 
     /**
      * Find the SimObject with the given name and return a pointer to
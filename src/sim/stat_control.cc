@@ -51,8 +51,10 @@
 
 #include "base/callback.hh"
 #include "base/statistics.hh"
+#include "base/stats/hierarchy.hh"
 #include "base/time.hh"
 #include "sim/global_event.hh"
+#include "sim/root.hh"
 
 namespace gem5
 {
@@ -62,6 +64,9 @@ namespace statistics
 
 GlobalEvent *dumpEvent;
 
+// The stat hierarchy, flattened when the statistics are enabled
+Hierarchy hierarchy;
+
 void
 initSimStats()
 {
@@ -158,5 +163,32 @@ updateEvents()
     }
 }
 
+void
+enableAll()
+{
+    // stats are sharded per event queue, as each one has its own thread
+    hierarchy.build(Root::root(), statsList(), numMainEventQueues);
+    enable();
+}
+
+void
+prepareAll()
+{
+    hierarchy.prepare();
+}
+
+void
+dumpAll(Output &output)
+{
+    hierarchy.dump(output);
+}
+
+void
+dumpGroup(Output &output, const Group &root,
+          const std::vector<std::string> &path)
+{
+    hierarchy.dump(output, root, path);
+}
+
 } // namespace statistics
 } // namespace gem5
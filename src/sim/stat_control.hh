@@ -41,6 +41,9 @@
 #ifndef __SIM_STAT_CONTROL_HH__
 #define __SIM_STAT_CONTROL_HH__
 
+#include <string>
+#include <vector>
+
 #include "base/compiler.hh"
 #include "base/types.hh"
 #include "sim/cur_tick.hh"
@@ -81,6 +84,38 @@ void schedStatEvent(bool dump, bool reset, Tick when = curTick(),
  * @param period The period at which the dumping should occur.
  */
 void periodicStatDump(Tick period = 0);
+
+class Group;
+struct Output;
+
+/**
+ * Check and enable all statistics. The stat hierarchy below the
+ * simulation root is flattened once here, so that it does not have to
+ * be walked again for every dump.
+ */
+void enableAll();
+
+/**
+ * Prepare all statistics for data access. This must be done before
+ * dumping and serialization.
+ */
+void prepareAll();
+
+/**
+ * Dump all statistics to an output.
+ * @param output Output to visit the statistics with.
+ */
+void dumpAll(Output &output);
+
+/**
+ * Dump the statistics below a group to an output.
+ * @param output Output to visit the statistics with.
+ * @param root Group to dump.
+ * @param path Names of the groups leading from the simulation root to
+ *             the group.
+ */
+void dumpGroup(Output &output, const Group &root,
+               const std::vector<std::string> &path);
 } // namespace statistics
 } // namespace gem5
 
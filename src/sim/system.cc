@@ -171,7 +171,12 @@ System::System(const Params &p)
       physProxy(_systemPort, p.cache_line_size),
       workload(p.workload),
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore, p.auto_unlink_shared_backstore),
+              p.shared_backstore, p.auto_unlink_shared_backstore,
+              p.mem_checkpoint_chunk_size, p.mem_checkpoint_threads,
+              p.mem_checkpoint_lazy_restore, p.mem_checkpoint_delta,
+              p.mem_checkpoint_delta_max_chain,
+              p.mem_backing_huge_pages, p.mem_backing_numa_policy,
+              p.mem_backing_numa_nodes),
       ShadowRomRanges(p.shadow_rom_ranges.begin(),
                       p.shadow_rom_ranges.end()),
       memoryMode(p.mem_mode),
@@ -181,6 +186,7 @@ System::System(const Params &p)
       _m5opRange(p.m5ops_base ?
                  RangeSize(p.m5ops_base, 0x10000) :
                  AddrRange(1, 0)), // Create an empty range if disabled
+      backingStoreStats(*this),
       redirectPaths(p.redirect_paths)
 {
     panic_if(!workload, "No workload set for system %s "
@@ -357,6 +363,21 @@ System::unserialize(CheckpointIn &cp)
     physmem.unserializeSection(cp, "physmem");
 }
 
+System::BackingStoreStats::BackingStoreStats(System &sys)
+    : statistics::Group(&sys, "backingStore"),
+      ADD_STAT(bytes, statistics::units::Byte::get(),
+               "Size of the host backing store"),
+      ADD_STAT(hugePageBytes, statistics::units::Byte::get(),
+               "Backing store backed by huge pages on the host"),
+      ADD_STAT(numaPlacedBytes, statistics::units::Byte::get(),
+               "Backing store placed on the requested host NUMA nodes")
+{
+    const memory::PhysicalMemory &physmem = sys.getPhysMem();
+    bytes.functor([&physmem] { return physmem.totalSize(); });
+    hugePageBytes.functor([&physmem] { return physmem.hugePageBacked(); });
+    numaPlacedBytes.functor([&physmem] { return physmem.numaPlaced(); });
+}
+
 void
 System::regStats()
 {
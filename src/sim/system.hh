@@ -580,6 +580,20 @@ class System : public SimObject, public PCEventScope
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
+  private:
+    /**
+     * Host backing store of the guest memory. The group is not called
+     * physmem, since configs commonly have a memory child of that name.
+     */
+    struct BackingStoreStats : public statistics::Group
+    {
+        BackingStoreStats(System &sys);
+
+        statistics::Value bytes;
+        statistics::Value hugePageBytes;
+        statistics::Value numaPlacedBytes;
+    } backingStoreStats;
+
   public:
     std::map<std::pair<uint32_t, uint32_t>, Tick>  lastWorkItemStarted;
     std::map<uint32_t, statistics::Histogram*> workItemStats;
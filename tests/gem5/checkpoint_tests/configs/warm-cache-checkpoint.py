@@ -0,0 +1,173 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This gem5 test script checks that classic caches restore their warm
+state from a checkpoint. Two traffic generators, each with a private L1,
+share an L2. Without --restore, they access a common footprint, and a
+checkpoint of the warm caches is saved. With --restore, the checkpoint is
+restored into an L2 of a different size and associativity, and each
+generator reads half of the footprint exactly once. Caches that start
+cold would see no hits at all, so the script fails unless both L1s and the
+L2 hit.
+"""
+
+import argparse
+import os
+import re
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument(
+    "--checkpoint-path",
+    type=str,
+    required=False,
+    default="warm-cache-test-checkpoint/",
+    help="The directory to store or restore the checkpoint.",
+)
+parser.add_argument(
+    "--restore",
+    action="store_true",
+    help="Restore the checkpoint instead of taking it.",
+)
+
+args = parser.parse_args()
+
+footprint = 128 * 1024
+block_size = 64
+
+
+class L1(Cache):
+    size = "32KiB"
+    assoc = 2
+    tag_latency = 1
+    data_latency = 1
+    response_latency = 1
+    mshrs = 4
+    tgts_per_mshr = 8
+    warm_checkpoint = True
+
+
+class L2(Cache):
+    # The restored L2 is smaller and less associative than the one
+    # that was checkpointed, so its blocks are replayed into a new
+    # geometry
+    size = "128KiB" if args.restore else "256KiB"
+    assoc = 4 if args.restore else 8
+    tag_latency = 10
+    data_latency = 10
+    response_latency = 10
+    mshrs = 16
+    tgts_per_mshr = 8
+    warm_checkpoint = True
+
+
+system = System(
+    clk_domain=SrcClockDomain(clock="1GHz", voltage_domain=VoltageDomain()),
+    mem_ranges=[AddrRange("32MiB")],
+    cache_line_size=block_size,
+)
+
+system.cpu = [PyTrafficGen() for i in range(2)]
+system.l1cache = [L1() for i in range(2)]
+system.l2bus = L2XBar()
+system.l2 = L2()
+system.membus = SystemXBar()
+system.physmem = SimpleMemory(range=system.mem_ranges[0])
+
+for cpu, l1 in zip(system.cpu, system.l1cache):
+    cpu.port = l1.cpu_side
+    l1.mem_side = system.l2bus.cpu_side_ports
+system.l2.cpu_side = system.l2bus.mem_side_ports
+system.l2.mem_side = system.membus.cpu_side_ports
+system.physmem.port = system.membus.mem_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+if not args.restore:
+    m5.instantiate()
+
+    # Reads and writes over the whole footprint from both generators,
+    # so that blocks end up both shared and writable
+    duration = 10 * 1000 * 1000
+    for cpu in system.cpu:
+        cpu.start(
+            [
+                cpu.createRandom(
+                    duration, 0, footprint - 1, block_size, 1000, 1000, 50, 0
+                )
+            ]
+        )
+    m5.simulate(duration)
+
+    m5.checkpoint(args.checkpoint_path)
+    print("Done taking checkpoint")
+    exit(0)
+
+m5.instantiate(args.checkpoint_path)
+
+# Each line is read once, so only a warm cache can hit
+duration = 100 * 1000 * 1000
+half = footprint // 2
+for i, cpu in enumerate(system.cpu):
+    cpu.start(
+        [
+            cpu.createLinear(
+                duration,
+                i * half,
+                (i + 1) * half - 1,
+                block_size,
+                1000,
+                1000,
+                100,
+                half,
+            )
+        ]
+    )
+m5.simulate(duration)
+m5.stats.dump()
+
+with open(os.path.join(m5.options.outdir, "stats.txt")) as stats_file:
+    stats = stats_file.read()
+
+
+def overall_hits(cache):
+    match = re.search(
+        rf"^system\.{cache}\.overallHits::total\s+(\d+)", stats, re.MULTILINE
+    )
+    return int(match.group(1)) if match else 0
+
+
+hits = {cache: overall_hits(cache) for cache in ("l1cache0", "l1cache1", "l2")}
+print("Hits after restoring the checkpoint: {}".format(hits))
+if not all(hits.values()):
+    m5.fatal("Caches were not restored warm")
+print("Restored warm caches")
@@ -200,6 +200,54 @@ gem5_verify_config(
     length=constants.quick_tag,
 )
 
+warm_cache_restore_verifier = verifier.MatchRegex(
+    re.compile(r"Restored warm caches")
+)
+
+gem5_verify_config(
+    name="test-checkpoint-warm-cache-save-checkpoint",
+    fixtures=(),
+    verifiers=(save_checkpoint_verifier,),
+    config=joinpath(
+        config.base_dir,
+        "tests",
+        "gem5",
+        "checkpoint_tests",
+        "configs",
+        "warm-cache-checkpoint.py",
+    ),
+    config_args=[
+        "--checkpoint-path",
+        joinpath(resource_path, "warm-cache-test-checkpoint"),
+    ],
+    valid_isas=(constants.all_compiled_tag,),
+    valid_hosts=constants.supported_hosts,
+    length=constants.quick_tag,
+)
+
+# Restores the checkpoint saved above into a different L2 geometry
+gem5_verify_config(
+    name="test-checkpoint-warm-cache-restore-checkpoint",
+    fixtures=(),
+    verifiers=(warm_cache_restore_verifier,),
+    config=joinpath(
+        config.base_dir,
+        "tests",
+        "gem5",
+        "checkpoint_tests",
+        "configs",
+        "warm-cache-checkpoint.py",
+    ),
+    config_args=[
+        "--checkpoint-path",
+        joinpath(resource_path, "warm-cache-test-checkpoint"),
+        "--restore",
+    ],
+    valid_isas=(constants.all_compiled_tag,),
+    valid_hosts=constants.supported_hosts,
+    length=constants.quick_tag,
+)
+
 # There is a bug in sparc isa that causes the checkpoints to fail
 # GitHub issue: https://github.com/gem5/gem5/issues/197
 # gem5_verify_config(
@@ -24,12 +24,26 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import argparse
+import os
+import re
+
 import m5
 from m5.objects import *
 
 m5.util.addToPath("../../../configs/")
 from common.Caches import *
 
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--snoop-filter-assoc",
+    type=int,
+    default=0,
+    help="Make the L2 crossbar snoop filter finite, with sets of this many "
+    "ways, and too small for the L1s so that it back-invalidates lines.",
+)
+args = parser.parse_args()
+
 # MAX CORES IS 8 with the fals sharing method
 nb_cores = 8
 cpus = [MemTest(max_loads=1e5, progress_interval=1e4) for i in range(nb_cores)]
@@ -49,6 +63,10 @@ system.cpu_clk_domain = SrcClockDomain(
 )
 
 system.toL2Bus = L2XBar(clk_domain=system.cpu_clk_domain)
+if args.snoop_filter_assoc:
+    system.toL2Bus.snoop_filter = SnoopFilter(
+        lookup_latency=0, max_capacity="16KiB", assoc=args.snoop_filter_assoc
+    )
 system.l2c = L2Cache(clk_domain=system.cpu_clk_domain, size="64kB", assoc=8)
 system.l2c.cpu_side = system.toL2Bus.mem_side_ports
 
@@ -80,3 +98,16 @@ m5.instantiate()
 exit_event = m5.simulate()
 if exit_event.getCause() != "maximum number of loads reached":
     exit(1)
+
+if args.snoop_filter_assoc:
+    # the testers check the data they read, so the back-invalidations
+    # kept the caches coherent, but make sure there were some
+    m5.stats.dump()
+    with open(os.path.join(m5.options.outdir, "stats.txt")) as stats_file:
+        match = re.search(
+            r"^system\.toL2Bus\.snoop_filter\.backInvalidations\s+(\d+)",
+            stats_file.read(),
+            re.MULTILINE,
+        )
+    if not match or int(match.group(1)) == 0:
+        exit(1)
@@ -70,6 +70,15 @@ gem5_verify_config(
     length=constants.long_tag,
 )
 
+gem5_verify_config(
+    name="memtest-finite-snoop-filter",
+    verifiers=(),  # No need for verfiers this will return non-zero on fail
+    config=joinpath(getcwd(), "memtest-run.py"),
+    config_args=["--snoop-filter-assoc=4"],
+    valid_isas=(constants.null_tag,),
+    length=constants.long_tag,
+)
+
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ * Standalone benchmark of the cache line compressors. Lines are read from
+ * raw dumps (consecutive block-sized records, e.g., captured from a
+ * memory checkpoint), or synthesized if no dump is given, and then
+ * compressed repeatedly by every compressor, reporting the throughput and
+ * the achieved compression.
+ *
+ * Build gem5 as a library, and then this benchmark, with something like:
+ *
+ *     scons --without-python build/ALL/libgem5_opt.so
+ *     cd util/compressor_bench && make
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mem/cache/cache_probe_arg.hh"
+#include "mem/cache/compressors/base.hh"
+#include "mem/cache/compressors/base_delta.hh"
+#include "mem/cache/compressors/cpack.hh"
+#include "mem/cache/compressors/fpc.hh"
+#include "mem/cache/compressors/fpcd.hh"
+#include "mem/cache/compressors/frequent_values.hh"
+#include "mem/cache/compressors/repeated_qwords.hh"
+#include "mem/cache/compressors/zero.hh"
+#include "mem/cache/replacement_policies/lfu_rp.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "params/Base16Delta8.hh"
+#include "params/Base32Delta16.hh"
+#include "params/Base32Delta8.hh"
+#include "params/Base64Delta16.hh"
+#include "params/Base64Delta32.hh"
+#include "params/Base64Delta8.hh"
+#include "params/CPack.hh"
+#include "params/FPC.hh"
+#include "params/FPCD.hh"
+#include "params/FrequentValuesCompressor.hh"
+#include "params/LFURP.hh"
+#include "params/RepeatedQwordsCompressor.hh"
+#include "params/SetAssociative.hh"
+#include "params/ZeroCompressor.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+void
+usage(const std::string &prog_name)
+{
+    std::cerr << "Usage: " << prog_name << (
+        " [ <option> ] [ <dump> ... ]\n\n"
+        "Compresses the cache lines of the given raw dumps, or a synthetic\n"
+        "mix of lines if no dump is given, with every compressor.\n\n"
+        "OPTIONS:\n"
+        "    -b <bytes>      -- cache line size (default 64)\n"
+        "    -i <count>      -- passes over the lines (default 16)\n"
+        "    -n <count>      -- number of synthetic lines (default 65536)\n"
+        "\n"
+        );
+
+    std::exit(EXIT_FAILURE);
+}
+
+/**
+ * Fill the parameters shared by all dictionary based compressors. The
+ * latencies are irrelevant for the benchmark, so every chunk is handled
+ * in a single cycle.
+ */
+template <class Params>
+Params
+makeParams(const std::string &name, unsigned block_size,
+    unsigned chunk_size_bits, int dictionary_size)
+{
+    Params p;
+    p.name = name;
+    p.eventq_index = 0;
+    p.block_size = block_size;
+    p.chunk_size_bits = chunk_size_bits;
+    p.size_threshold_percentage = 100;
+    p.comp_chunks_per_cycle = (block_size * 8) / chunk_size_bits;
+    p.comp_extra_latency = Cycles(0);
+    p.decomp_chunks_per_cycle = (block_size * 8) / chunk_size_bits;
+    p.decomp_extra_latency = Cycles(0);
+    p.dictionary_size = dictionary_size;
+    return p;
+}
+
+/** Add a compressor whose parameters are all common ones. */
+template <class Compressor, class Params>
+void
+addCompressor(std::vector<std::unique_ptr<compression::Base>> &compressors,
+    const std::string &name, unsigned block_size, unsigned chunk_size_bits,
+    int dictionary_size)
+{
+    compressors.emplace_back(new Compressor(makeParams<Params>(name,
+        block_size, chunk_size_bits, dictionary_size)));
+}
+
+/** The probe arguments need an accessor, but there is no cache around. */
+struct NoCacheAccessor : CacheAccessor
+{
+    bool inCache(Addr addr, bool is_secure) const override { return false; }
+
+    bool
+    hasBeenPrefetched(Addr addr, bool is_secure) const override
+    {
+        return false;
+    }
+
+    bool
+    hasBeenPrefetched(Addr addr, bool is_secure,
+        RequestorID requestor) const override
+    {
+        return false;
+    }
+
+    bool
+    inMissQueue(Addr addr, bool is_secure) const override
+    {
+        return false;
+    }
+
+    bool coalesce() const override { return false; }
+};
+
+/**
+ * Add a FrequentValues compressor, with the defaults of its Python
+ * configuration. It only compresses once it has sampled enough values
+ * and generated their codes, which it normally learns from the data
+ * updates of its cache. Instead, it is notified of fills of the lines to
+ * be compressed, and the event queue is run until code generation is
+ * over. Its value table policies are kept alive by sim_objects.
+ */
+void
+addFrequentValues(std::vector<std::unique_ptr<compression::Base>> &compressors,
+    std::vector<std::unique_ptr<SimObject>> &sim_objects,
+    unsigned block_size, const std::vector<uint64_t> &lines)
+{
+    const unsigned vft_assoc = 16;
+    const unsigned vft_entries = 1024;
+
+    SetAssociativeParams indexing_params;
+    indexing_params.name = "FrequentValues.vft_indexing_policy";
+    indexing_params.eventq_index = 0;
+    indexing_params.size = vft_entries;
+    indexing_params.entry_size = 1;
+    indexing_params.assoc = vft_assoc;
+    auto *indexing_policy = new SetAssociative(indexing_params);
+    sim_objects.emplace_back(indexing_policy);
+
+    LFURPParams replacement_params;
+    replacement_params.name = "FrequentValues.vft_replacement_policy";
+    replacement_params.eventq_index = 0;
+    auto *replacement_policy = new replacement_policy::LFU(
+        replacement_params);
+    sim_objects.emplace_back(replacement_policy);
+
+    const std::size_t words_per_line = block_size / sizeof(uint64_t);
+    FrequentValuesCompressorParams p;
+    p.name = "FrequentValues";
+    p.eventq_index = 0;
+    p.block_size = block_size;
+    p.chunk_size_bits = 32;
+    p.size_threshold_percentage = 100;
+    p.comp_chunks_per_cycle = 1;
+    p.comp_extra_latency = Cycles(1);
+    p.decomp_chunks_per_cycle = 1;
+    p.decomp_extra_latency = Cycles(0);
+    p.code_generation_ticks = 10000;
+    p.counter_bits = 18;
+    p.max_code_length = 18;
+    p.num_samples = std::min<std::size_t>(100000,
+        lines.size() * 64 / p.chunk_size_bits);
+    p.check_saturation = false;
+    p.vft_assoc = vft_assoc;
+    p.vft_entries = vft_entries;
+    p.vft_indexing_policy = indexing_policy;
+    p.vft_replacement_policy = replacement_policy;
+    auto *compressor = new compression::FrequentValues(p);
+    compressors.emplace_back(compressor);
+
+    NoCacheAccessor accessor;
+    for (std::size_t line = 0; line * words_per_line < lines.size();
+         line++) {
+        CacheDataUpdateProbeArg data_update(line * block_size, false,
+            Request::invldRequestorId, accessor);
+        const auto words = lines.begin() + line * words_per_line;
+        data_update.newData.assign(words, words + words_per_line);
+        compressor->probeNotify(data_update);
+    }
+
+    getEventQueue(0)->serviceEvents(curTick() + p.code_generation_ticks);
+}
+
+/**
+ * Generate a mix of lines resembling common memory contents: zeroed lines,
+ * arrays of small integers, pointers into a common region, repeated
+ * values, and random (incompressible) data.
+ */
+std::vector<uint64_t>
+synthesizeLines(std::size_t num_lines, unsigned block_size)
+{
+    const std::size_t words_per_line = block_size / sizeof(uint64_t);
+    std::vector<uint64_t> lines(num_lines * words_per_line);
+    std::mt19937_64 rng(0);
+
+    for (std::size_t line = 0; line < num_lines; line++) {
+        uint64_t *words = &lines[line * words_per_line];
+        const uint64_t base = rng();
+        const uint64_t kind = rng() % 5;
+        for (std::size_t w = 0; w < words_per_line; w++) {
+            switch (kind) {
+              case 0:
+                words[w] = 0;
+                break;
+              case 1:
+                words[w] = (rng() % 256) | ((rng() % 256) << 32);
+                break;
+              case 2:
+                words[w] = 0x00007f0000000000ULL + (base % 4096) +
+                    (rng() % 1024) * 8;
+                break;
+              case 3:
+                words[w] = base;
+                break;
+              default:
+                words[w] = rng();
+                break;
+            }
+        }
+    }
+
+    return lines;
+}
+
+/** Append all complete lines of a raw dump file. */
+void
+readDump(const std::string &file_name, unsigned block_size,
+    std::vector<uint64_t> &lines)
+{
+    std::ifstream dump(file_name, std::ios::binary);
+    if (!dump) {
+        std::cerr << "Can't open dump file: " << file_name << '\n';
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::vector<uint64_t> line(block_size / sizeof(uint64_t));
+    while (dump.read(reinterpret_cast<char*>(line.data()), block_size)) {
+        lines.insert(lines.end(), line.begin(), line.end());
+    }
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const std::string prog_name(argv[0]);
+    unsigned block_size = 64;
+    unsigned iterations = 16;
+    std::size_t num_synthetic_lines = 65536;
+    std::vector<std::string> dumps;
+
+    for (int arg = 1; arg < argc; arg++) {
+        const std::string option(argv[arg]);
+        if (option == "-b" || option == "-i" || option == "-n") {
+            if (++arg == argc)
+                usage(prog_name);
+            const unsigned long value = std::strtoul(argv[arg], nullptr, 0);
+            if (option == "-b")
+                block_size = value;
+            else if (option == "-i")
+                iterations = value;
+            else
+                num_synthetic_lines = value;
+        } else if (option[0] == '-') {
+            usage(prog_name);
+        } else {
+            dumps.push_back(option);
+        }
+    }
+
+    if (block_size == 0 || block_size % sizeof(uint64_t))
+        usage(prog_name);
+
+    setClockFrequency(1000000000000);
+    fixClockFrequency();
+    curEventQueue(getEventQueue(0));
+
+    std::vector<uint64_t> lines;
+    for (const auto &dump : dumps)
+        readDump(dump, block_size, lines);
+    if (dumps.empty())
+        lines = synthesizeLines(num_synthetic_lines, block_size);
+
+    const std::size_t words_per_line = block_size / sizeof(uint64_t);
+    const std::size_t num_lines = lines.size() / words_per_line;
+    if (num_lines == 0) {
+        std::cerr << "No complete lines to compress\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::unique_ptr<SimObject>> sim_objects;
+    std::vector<std::unique_ptr<compression::Base>> compressors;
+    addCompressor<compression::Base64Delta8, Base64Delta8Params>(
+        compressors, "Base64Delta8", block_size, 64, block_size);
+    addCompressor<compression::Base64Delta16, Base64Delta16Params>(
+        compressors, "Base64Delta16", block_size, 64, block_size);
+    addCompressor<compression::Base64Delta32, Base64Delta32Params>(
+        compressors, "Base64Delta32", block_size, 64, block_size);
+    addCompressor<compression::Base32Delta8, Base32Delta8Params>(
+        compressors, "Base32Delta8", block_size, 32, block_size);
+    addCompressor<compression::Base32Delta16, Base32Delta16Params>(
+        compressors, "Base32Delta16", block_size, 32, block_size);
+    addCompressor<compression::Base16Delta8, Base16Delta8Params>(
+        compressors, "Base16Delta8", block_size, 16, block_size);
+    addCompressor<compression::CPack, CPackParams>(
+        compressors, "CPack", block_size, 32, block_size);
+    addCompressor<compression::FPCD, FPCDParams>(
+        compressors, "FPCD", block_size, 32, 2);
+    addCompressor<compression::RepeatedQwords,
+        RepeatedQwordsCompressorParams>(
+        compressors, "RepeatedQwords", block_size, 64, block_size);
+    addCompressor<compression::Zero, ZeroCompressorParams>(
+        compressors, "Zero", block_size, 64, block_size);
+
+    FPCParams fpc_params = makeParams<FPCParams>("FPC", block_size, 32, 1);
+    fpc_params.zero_run_bits = 3;
+    compressors.emplace_back(new compression::FPC(fpc_params));
+
+    addFrequentValues(compressors, sim_objects, block_size, lines);
+
+    std::cout << num_lines << " lines of " << block_size << " bytes, "
+              << iterations << " passes\n\n"
+              << std::left << std::setw(16) << "compressor"
+              << std::right << std::setw(12) << "ns/line"
+              << std::setw(12) << "MB/s"
+              << std::setw(12) << "ratio" << '\n';
+
+    for (auto &compressor : compressors) {
+        uint64_t compressed_bits = 0;
+        Cycles comp_lat, decomp_lat;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned pass = 0; pass < iterations; pass++) {
+            for (std::size_t line = 0; line < num_lines; line++) {
+                const auto comp_data = compressor->compress(
+                    &lines[line * words_per_line], comp_lat, decomp_lat);
+                if (pass == 0)
+                    compressed_bits += comp_data->getSizeBits();
+            }
+        }
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        const double compressed_lines = double(num_lines) * iterations;
+        const double ns_per_line = elapsed.count() / compressed_lines;
+        std::cout << std::left << std::setw(16) << compressor->name()
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << ns_per_line
+                  << std::setw(12) << (block_size * 1e3) / ns_per_line
+                  << std::setprecision(3) << std::setw(12)
+                  << (compressed_bits ?
+                      (double(num_lines) * block_size * 8) / compressed_bits :
+                      0.0)
+                  << '\n';
+    }
+
+    return EXIT_SUCCESS;
+}
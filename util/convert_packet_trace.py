@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a protobuf packet trace into a fixed-width
+# packet trace. Fixed-width traces are memory mapped by the trace
+# generator of the traffic generator rather than parsed, which makes
+# replaying large traces considerably faster. The layout is described
+# in src/cpu/testers/traffic_gen/fixed_packet_trace.hh.
+
+import os
+import struct
+import subprocess
+import sys
+
+import protolib
+
+util_dir = os.path.dirname(os.path.realpath(__file__))
+# Make sure the proto definitions are up to date.
+subprocess.check_call(["make", "--quiet", "-C", util_dir, "packet_pb2.py"])
+import packet_pb2
+
+# Header: magic, version, record size, tick frequency, number of records
+header_fmt = struct.Struct("<8sIIQQ")
+# Record: tick, address, size, flags, command, reserved
+record_fmt = struct.Struct("<QQIIII")
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <protobuf input> <fixed-width output>")
+        exit(-1)
+
+    # Open the file in read mode
+    proto_in = protolib.openFileRd(sys.argv[1])
+
+    try:
+        fixed_out = open(sys.argv[2], "wb")
+    except OSError:
+        print("Failed to open ", sys.argv[2], " for writing")
+        exit(-1)
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4).decode()
+
+    if magic_number != "gem5":
+        print("Unrecognized file", sys.argv[1])
+        exit(-1)
+
+    header = packet_pb2.PacketHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    # Leave room for the header, which is written once the number of
+    # records is known
+    fixed_out.write(bytes(header_fmt.size))
+
+    num_packets = 0
+    last_tick = 0
+    packet = packet_pb2.Packet()
+
+    while protolib.decodeMessage(proto_in, packet):
+        if packet.tick < last_tick:
+            print("Packet", num_packets, "goes back in time, the trace must")
+            print("be sorted by tick")
+            exit(-1)
+        last_tick = packet.tick
+        flags = packet.flags if packet.HasField("flags") else 0
+        fixed_out.write(
+            record_fmt.pack(
+                packet.tick, packet.addr, packet.size, flags, packet.cmd, 0
+            )
+        )
+        num_packets += 1
+
+    fixed_out.seek(0)
+    fixed_out.write(
+        header_fmt.pack(
+            b"gem5fpkt",
+            1,
+            record_fmt.size,
+            header.tick_freq,
+            num_packets,
+        )
+    )
+
+    print("Converted packets:", num_packets)
+
+    fixed_out.close()
+    proto_in.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Convert gem5 checkpoints between the text and binary formats.
+
+Text checkpoints (m5.cpt) are INI files that have to be parsed in full
+when a checkpoint is restored. Binary checkpoints (m5.cpt.bin) are mapped
+by the simulator and only the sections that are actually unserialized are
+decoded. Checkpoints written by the simulator only hold one of the two
+files. When both are present, e.g., after a conversion, the simulator
+restores the one modified last.
+
+Upgrade existing checkpoints with util/cpt_upgrader.py first, since the
+upgrader only operates on text checkpoints.
+
+Usage:
+    cpt_binary.py [-r] CHECKPOINT_DIR          # m5.cpt -> m5.cpt.bin
+    cpt_binary.py --to-text CHECKPOINT_DIR     # m5.cpt.bin -> m5.cpt
+
+The binary layout is documented in src/base/binary_inifile.hh.
+"""
+
+import argparse
+import os
+import os.path as osp
+import struct
+import sys
+
+MAGIC = b"gem5cptb"
+VERSION = 1
+HEADER = struct.Struct("=8sIIQQ")
+ENTRY = struct.Struct("=BII")
+DIR_ENTRY = struct.Struct("=QQ")
+
+TYPE_STRING = 0
+TYPE_INT_ARRAY = 1
+
+INT64_MIN = -(2**63)
+INT64_MAX = 2**63 - 1
+
+
+def load_text(path):
+    """Parse a text checkpoint the same way gem5's IniFile does."""
+    sections = {}
+    section = None
+    with open(path) as f:
+        for line in f:
+            line = line.strip(" \t\r\n\v\f").rstrip(" ")
+            if not line:
+                continue
+            if line[0] == "[" and line[-1] == "]":
+                section = sections.setdefault(line[1:-1].strip(" "), {})
+                continue
+            if section is None:
+                continue
+            key, sep, value = line.partition("=")
+            if not sep:
+                raise ValueError(f"Can't parse .ini line {line}")
+            append = key.endswith("+")
+            if append:
+                key = key[:-1]
+            key = key.strip(" ")
+            value = value.strip(" ")
+            if append and key in section:
+                section[key] += " " + value
+            else:
+                section[key] = value
+    return sections
+
+
+def parse_int_array(value):
+    """Return the integers in value if it renders back identically."""
+    if not value:
+        return None
+    ints = []
+    for tok in value.split(" "):
+        digits = tok[1:] if tok.startswith("-") else tok
+        if not digits.isdigit() or not digits.isascii():
+            return None
+        if tok == "-0" or (len(digits) > 1 and digits[0] == "0"):
+            return None
+        i = int(tok)
+        if i < INT64_MIN or i > INT64_MAX:
+            return None
+        ints.append(i)
+    return ints
+
+
+def write_binary(sections, path):
+    names = sorted(sections)
+    body = bytearray()
+    directory = bytearray()
+    offset = HEADER.size
+    for name in names:
+        entries = sorted(sections[name].items())
+        sec = bytearray(struct.pack("=I", len(entries)))
+        for key, value in entries:
+            key_b = key.encode()
+            ints = parse_int_array(value)
+            if ints is None:
+                value_b = value.encode()
+                sec += ENTRY.pack(TYPE_STRING, len(key_b), len(value_b))
+                sec += key_b + value_b
+            else:
+                sec += ENTRY.pack(TYPE_INT_ARRAY, len(key_b), len(ints))
+                sec += key_b + struct.pack(f"={len(ints)}q", *ints)
+        name_b = name.encode()
+        directory += struct.pack("=I", len(name_b)) + name_b
+        directory += DIR_ENTRY.pack(offset, len(sec))
+        body += sec
+        offset += len(sec)
+
+    with open(path, "wb") as f:
+        f.write(
+            HEADER.pack(MAGIC, VERSION, len(names), offset, len(directory))
+        )
+        f.write(body)
+        f.write(directory)
+
+
+def load_binary(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, version, num_sections, dir_offset, dir_size = HEADER.unpack_from(
+        data
+    )
+    if magic != MAGIC or version != VERSION:
+        raise ValueError(f"{path} is not a version {VERSION} checkpoint")
+
+    sections = {}
+    pos = dir_offset
+    for _ in range(num_sections):
+        (name_len,) = struct.unpack_from("=I", data, pos)
+        pos += 4
+        name = data[pos : pos + name_len].decode()
+        pos += name_len
+        sec_offset, _ = DIR_ENTRY.unpack_from(data, pos)
+        pos += DIR_ENTRY.size
+
+        entries = {}
+        (num_entries,) = struct.unpack_from("=I", data, sec_offset)
+        epos = sec_offset + 4
+        for _ in range(num_entries):
+            kind, key_len, count = ENTRY.unpack_from(data, epos)
+            epos += ENTRY.size
+            key = data[epos : epos + key_len].decode()
+            epos += key_len
+            if kind == TYPE_STRING:
+                value = data[epos : epos + count].decode()
+                epos += count
+            elif kind == TYPE_INT_ARRAY:
+                ints = struct.unpack_from(f"={count}q", data, epos)
+                value = " ".join(str(i) for i in ints)
+                epos += 8 * count
+            else:
+                raise ValueError(f"Unknown value type {kind} in {path}")
+            entries[key] = value
+        sections[name] = entries
+    return sections
+
+
+def write_text(sections, path):
+    with open(path, "w") as f:
+        f.write("## checkpoint converted from binary\n")
+        for name in sorted(sections):
+            f.write(f"\n[{name}]\n")
+            for key, value in sorted(sections[name].items()):
+                f.write(f"{key}={value}\n")
+
+
+def convert(cpt_dir, to_text):
+    text = osp.join(cpt_dir, "m5.cpt")
+    binary = osp.join(cpt_dir, "m5.cpt.bin")
+    if to_text:
+        print(f"Converting {binary} to {text}")
+        write_text(load_binary(binary), text)
+    else:
+        print(f"Converting {text} to {binary}")
+        write_binary(load_text(text), binary)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description=__doc__.split("\n\n")[0],
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+    )
+    parser.add_argument("checkpoint", help="checkpoint directory")
+    parser.add_argument(
+        "-r",
+        "--recurse",
+        action="store_true",
+        help="convert all checkpoints below the given directory",
+    )
+    parser.add_argument(
+        "--to-text",
+        action="store_true",
+        help="convert m5.cpt.bin back to a text m5.cpt",
+    )
+    args = parser.parse_args()
+
+    path = osp.expandvars(osp.expanduser(args.checkpoint))
+    src = "m5.cpt.bin" if args.to_text else "m5.cpt"
+    if args.recurse:
+        for root, dirs, files in os.walk(path):
+            if src in files:
+                convert(root, args.to_text)
+    elif osp.isfile(osp.join(path, src)):
+        convert(path, args.to_text)
+    else:
+        print(f"Error: {src} not found in {path}")
+        sys.exit(1)
@@ -0,0 +1,474 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Decode binary gem5 commit traces.
+
+The simulator writes these traces when a CPU uses the BinaryExeTracer
+instead of the ExeTracer, see src/cpu/binary_exetrace.hh for the
+layout. This script turns them into the text the ExeTracer would have
+written for a given set of Exec debug flags.
+
+Usage:
+    decode_commit_trace.py m5out/system.cpu.tracer.ctrace
+    decode_commit_trace.py trace.ctrace --debug-flags=ExecAll,-ExecAsid
+    decode_commit_trace.py trace.ctrace --dictionary
+    decode_commit_trace.py trace.ctrace --redecoded
+"""
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b"gem5ctrc"
+VERSIONS = (1, 2)
+
+RECORD_NAME = 1
+RECORD_CONTEXT = 2
+RECORD_ENTRY = 3
+RECORD_COMMIT = 4
+RECORD_REDECODE = 5
+
+OPTION_OP_CLASS = 0x1
+OPTION_MACHINE_CODE = 0x2
+OPTION_FULL_SYSTEM = 0x4
+OPTION_REDECODE = 0x8
+
+ENTRY_MICROOP = 0x1
+ENTRY_FIRST_MICROOP = 0x2
+ENTRY_LAST_MICROOP = 0x4
+ENTRY_HAS_MACROOP = 0x8
+
+COMMIT_PREDICATED_FALSE = 0x1
+COMMIT_USER_MODE = 0x2
+COMMIT_FAULTING = 0x4
+COMMIT_MEM_VALID = 0x8
+COMMIT_FETCH_SEQ_VALID = 0x10
+COMMIT_CP_SEQ_VALID = 0x20
+COMMIT_INT_DATA = 0x40
+COMMIT_REG_DATA = 0x80
+
+HEADER = struct.Struct("=8sIBQ")
+U8 = struct.Struct("=B")
+
+# The debug flags that change the ExeTracer output, from
+# src/cpu/SConscript
+EXEC_FLAGS = [
+    "ExecEnable",
+    "ExecCPSeq",
+    "ExecEffAddr",
+    "ExecFaulting",
+    "ExecFetchSeq",
+    "ExecOpClass",
+    "ExecRegDelta",
+    "ExecResult",
+    "ExecSymbol",
+    "ExecThread",
+    "ExecMicro",
+    "ExecMacro",
+    "ExecUser",
+    "ExecKernel",
+    "ExecAsid",
+    "ExecFlags",
+]
+COMPOUND_FLAGS = {
+    "ExecAll": EXEC_FLAGS,
+    "Exec": [
+        "ExecEnable",
+        "ExecOpClass",
+        "ExecThread",
+        "ExecEffAddr",
+        "ExecResult",
+        "ExecSymbol",
+        "ExecMicro",
+        "ExecMacro",
+        "ExecFaulting",
+        "ExecUser",
+        "ExecKernel",
+    ],
+    "ExecNoTicks": ["Exec", "FmtTicksOff"],
+}
+FORMAT_FLAGS = ["FmtTicksOff", "FmtFlag"]
+
+
+def parse_flags(spec):
+    """Expand a --debug-flags style list into a set of flags."""
+
+    flags = set()
+
+    def expand(name):
+        if name in COMPOUND_FLAGS:
+            result = set()
+            for sub in COMPOUND_FLAGS[name]:
+                result |= expand(sub)
+            return result
+        if name in EXEC_FLAGS or name in FORMAT_FLAGS:
+            return {name}
+        raise ValueError(f"unknown debug flag {name}")
+
+    for name in spec.split(","):
+        name = name.strip()
+        if not name:
+            continue
+        if name.startswith("-"):
+            flags -= expand(name[1:])
+        else:
+            flags |= expand(name)
+    return flags
+
+
+def hex_alt(value):
+    """Format a value like cprintf's %#x."""
+    return f"{value:#x}" if value else "0"
+
+
+class Entry:
+    """A dictionary entry of a trace."""
+
+    def __init__(self, pc, upc, bits):
+        self.pc = pc
+        self.upc = upc
+        self.bits = bits
+        self.macro = None
+        self.op_class = None
+        self.code = None
+        self.disassembly = ""
+        self.symbol = ""
+        self.offset = 0
+        self.flags = ""
+
+    @property
+    def microop(self):
+        return bool(self.bits & ENTRY_MICROOP)
+
+
+class Reader:
+    def __init__(self, f):
+        self.f = f
+
+    def read(self, size):
+        data = self.f.read(size)
+        if len(data) != size:
+            raise ValueError("truncated trace")
+        return data
+
+    def unpack(self, st):
+        return st.unpack(self.read(st.size))
+
+    def u8(self):
+        return self.read(1)[0]
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.read(1)[0]
+            value |= (byte & 0x7F) << shift
+            if byte < 0x80:
+                return value
+            shift += 7
+
+    def delta(self, last):
+        value = self.varint()
+        delta = (value >> 1) ^ -(value & 1)
+        return (last + delta) & 0xFFFFFFFFFFFFFFFF
+
+    def bytes(self):
+        return self.read(self.varint())
+
+    def string(self):
+        return self.bytes().decode("latin-1")
+
+
+class Decoder:
+    def __init__(self, flags, out, redecoded=False):
+        self.flags = flags
+        self.out = out
+        self.redecoded = redecoded
+        self.options = 0
+        self.op_classes = []
+        self.names = {}
+        self.entries = {}
+        self.context = ("", 0, 0)
+        self.warned = False
+
+    def line(self, tick, entry, commit_bits, fields, ran):
+        flags = self.flags
+        name, tid, asid = self.context
+        user = commit_bits & COMMIT_USER_MODE
+
+        text = []
+        if "ExecAsid" in flags:
+            text.append(f"A{asid} ")
+        if "ExecThread" in flags:
+            text.append(f"T{tid} : ")
+
+        text.append(hex_alt(entry.pc))
+        full_system = self.options & OPTION_FULL_SYSTEM
+        if (
+            "ExecSymbol" in flags
+            and (not full_system or not user)
+            and entry.symbol
+        ):
+            if entry.offset:
+                text.append(f" @{entry.symbol}+{entry.offset}")
+            else:
+                text.append(f" @{entry.symbol}")
+
+        if entry.microop:
+            text.append(f".{entry.upc:2d}")
+        else:
+            text.append("   ")
+
+        text.append(" : ")
+        text.append(entry.disassembly.ljust(26))
+
+        if ran:
+            text.append(" : ")
+
+            if "ExecOpClass" in flags:
+                if entry.op_class is None:
+                    if not self.warned:
+                        sys.stderr.write(
+                            "warning: op classes weren't recorded\n"
+                        )
+                        self.warned = True
+                else:
+                    text.append(f"{self.op_classes[entry.op_class]} : ")
+
+            if "ExecResult" in flags:
+                if commit_bits & COMMIT_PREDICATED_FALSE:
+                    text.append("Predicated False")
+                if commit_bits & COMMIT_REG_DATA:
+                    text.append(f" D={fields['data']}")
+                elif commit_bits & COMMIT_INT_DATA:
+                    text.append(f" D={fields['data']:#018x}")
+
+            if "ExecEffAddr" in flags and commit_bits & COMMIT_MEM_VALID:
+                text.append(f" A=0x{fields['addr']:x}")
+
+            if (
+                "ExecFetchSeq" in flags
+                and commit_bits & COMMIT_FETCH_SEQ_VALID
+            ):
+                text.append(f"  FetchSeq={fields['fetch_seq']}")
+
+            if "ExecCPSeq" in flags and commit_bits & COMMIT_CP_SEQ_VALID:
+                text.append(f"  CPSeq={fields['cp_seq']}")
+
+            if self.redecoded and "redecode" in fields:
+                text.append(
+                    f"  Redecoded={self.op_classes[fields['redecode']]}"
+                )
+
+            if "ExecFlags" in flags:
+                text.append(f"  flags=({entry.flags})")
+
+        text.append("\n")
+
+        prefix = []
+        if "FmtTicksOff" not in flags:
+            prefix.append(f"{tick:7d}: ")
+        if "FmtFlag" in flags:
+            prefix.append("ExecEnable: ")
+        if name:
+            prefix.append(f"{name}: ")
+
+        self.out.write("".join(prefix + text))
+
+    def commit(self, tick, entry, commit_bits, fields):
+        """Write the lines ExeTracerRecord::dump() would have written."""
+
+        flags = self.flags
+        if "ExecEnable" not in flags:
+            return
+        if commit_bits & COMMIT_FAULTING and "ExecFaulting" not in flags:
+            return
+        if commit_bits & COMMIT_USER_MODE:
+            if "ExecUser" not in flags:
+                return
+        elif "ExecKernel" not in flags:
+            return
+
+        micro = "ExecMicro" in flags
+        if (
+            "ExecMacro" in flags
+            and entry.microop
+            and entry.macro is not None
+            and (
+                (micro and entry.bits & ENTRY_FIRST_MICROOP)
+                or (not micro and entry.bits & ENTRY_LAST_MICROOP)
+            )
+        ):
+            self.line(
+                tick, self.entries[entry.macro], commit_bits, fields, False
+            )
+        if micro or not entry.microop:
+            self.line(tick, entry, commit_bits, fields, True)
+
+    def dictionary(self, eid, entry):
+        """Write a dictionary entry."""
+
+        text = [f"{eid}: {hex_alt(entry.pc)}.{entry.upc}"]
+        if entry.macro is not None:
+            text.append(f" macro={entry.macro}")
+        if entry.op_class is not None:
+            text.append(f" {self.op_classes[entry.op_class]}")
+        if entry.code is not None:
+            text.append(f" code={entry.code.hex()}")
+        if entry.symbol:
+            text.append(f" @{entry.symbol}+{entry.offset}")
+        text.append(f" : {entry.disassembly} : ({entry.flags})\n")
+        self.out.write("".join(text))
+
+    def decode(self, path, dictionary=False):
+        with open(path, "rb") as f:
+            gzipped = f.read(2) == b"\x1f\x8b"
+        with (gzip.open if gzipped else open)(path, "rb") as f:
+            reader = Reader(f)
+            magic, version, self.options, _ = reader.unpack(HEADER)
+            if magic != MAGIC:
+                raise ValueError(f"{path} is not a binary commit trace")
+            if version not in VERSIONS:
+                raise ValueError(f"{path}: unsupported version {version}")
+
+            if self.options & (OPTION_OP_CLASS | OPTION_REDECODE):
+                count = reader.varint()
+                self.op_classes = [reader.string() for _ in range(count)]
+
+            tick = addr = fetch_seq = cp_seq = 0
+            redecode = None
+            while True:
+                rtype = f.read(1)
+                if not rtype:
+                    break
+                rtype = rtype[0]
+
+                if rtype == RECORD_NAME:
+                    nid = reader.varint()
+                    self.names[nid] = reader.string()
+                elif rtype == RECORD_CONTEXT:
+                    nid = reader.varint()
+                    tid = reader.varint()
+                    asid = reader.varint()
+                    self.context = (self.names[nid], tid, asid)
+                elif rtype == RECORD_ENTRY:
+                    eid = reader.varint()
+                    pc = reader.varint()
+                    upc = reader.varint()
+                    entry = Entry(pc, upc, reader.u8())
+                    if entry.bits & ENTRY_HAS_MACROOP:
+                        entry.macro = reader.varint()
+                    if self.options & OPTION_OP_CLASS:
+                        entry.op_class = reader.u8()
+                    if self.options & OPTION_MACHINE_CODE:
+                        entry.code = reader.bytes()
+                    entry.disassembly = reader.string()
+                    entry.symbol = reader.string()
+                    if entry.symbol:
+                        entry.offset = reader.varint()
+                    entry.flags = reader.string()
+                    self.entries[eid] = entry
+                    if dictionary:
+                        self.dictionary(eid, entry)
+                elif rtype == RECORD_REDECODE:
+                    redecode = reader.u8()
+                elif rtype == RECORD_COMMIT:
+                    bits = reader.u8()
+                    entry = self.entries[reader.varint()]
+                    tick = reader.delta(tick)
+                    fields = {}
+                    if redecode is not None:
+                        fields["redecode"] = redecode
+                        redecode = None
+                    if bits & COMMIT_REG_DATA:
+                        fields["data"] = reader.string()
+                    elif bits & COMMIT_INT_DATA:
+                        fields["data"] = reader.varint()
+                    if bits & COMMIT_MEM_VALID:
+                        addr = reader.delta(addr)
+                        fields["addr"] = addr
+                        fields["size"] = reader.varint()
+                    if bits & COMMIT_FETCH_SEQ_VALID:
+                        fetch_seq = reader.delta(fetch_seq)
+                        fields["fetch_seq"] = fetch_seq
+                    if bits & COMMIT_CP_SEQ_VALID:
+                        cp_seq = reader.delta(cp_seq)
+                        fields["cp_seq"] = cp_seq
+                    if not dictionary:
+                        self.commit(tick, entry, bits, fields)
+                else:
+                    raise ValueError(f"{path}: unknown record type {rtype}")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert binary gem5 commit traces to ExeTracer text"
+    )
+    parser.add_argument("file", help="Binary commit trace")
+    parser.add_argument(
+        "-o", "--output", help="Text file to write (default: stdout)"
+    )
+    parser.add_argument(
+        "--debug-flags",
+        default="Exec",
+        help="Comma separated Exec debug flags to format the trace "
+        "for, as with gem5's --debug-flags (default: Exec)",
+    )
+    parser.add_argument(
+        "--dictionary",
+        action="store_true",
+        help="List the dictionary entries instead of the instructions",
+    )
+    parser.add_argument(
+        "--redecoded",
+        action="store_true",
+        help="Append the op class redecoded instructions executed as, "
+        "which the ExeTracer doesn't print",
+    )
+    args = parser.parse_args()
+
+    try:
+        flags = parse_flags(args.debug_flags)
+    except ValueError as e:
+        parser.error(str(e))
+
+    if args.output:
+        out = open(args.output, "w", encoding="latin-1", newline="")
+    else:
+        out = open(
+            sys.stdout.fileno(), "w", encoding="latin-1", closefd=False
+        )
+    with out:
+        Decoder(flags, out, args.redecoded).decode(
+            args.file, args.dictionary
+        )
+
+
+if __name__ == "__main__":
+    main()
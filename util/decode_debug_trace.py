@@ -0,0 +1,539 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Decode binary gem5 debug traces.
+
+The simulator writes these traces when it is run with
+--debug-format=binary. Messages are stored with their format string
+and unformatted arguments, see src/base/binary_logger.hh for the
+layout. This script formats them the way cprintf does, giving the
+same text as the default debug output.
+
+Usage:
+    decode_debug_trace.py m5out/trace.bin             # text on stdout
+    decode_debug_trace.py m5out/trace.bin -o trace.txt
+"""
+
+import argparse
+import gzip
+import math
+import struct
+import sys
+
+MAGIC = b"gem5dlog"
+VERSION = 1
+MAX_TICK = 2**64 - 1
+
+RECORD_STRING = 1
+RECORD_MESSAGE = 2
+RECORD_TEXT = 3
+
+FORMAT_TICKS_OFF = 0x1
+FORMAT_SHOW_FLAG = 0x2
+
+# The argument types of trace::RawArg
+(
+    BOOL,
+    CHAR,
+    SCHAR,
+    UCHAR,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    DOUBLE,
+    STRING,
+    POINTER,
+) = range(1, 14)
+
+# The encoding of the fixed size argument types. The host char is
+# assumed to be signed, as it is on x86.
+ARG_STRUCTS = {
+    BOOL: struct.Struct("=B"),
+    CHAR: struct.Struct("=b"),
+    SCHAR: struct.Struct("=b"),
+    UCHAR: struct.Struct("=B"),
+    INT16: struct.Struct("=h"),
+    UINT16: struct.Struct("=H"),
+    INT32: struct.Struct("=i"),
+    UINT32: struct.Struct("=I"),
+    INT64: struct.Struct("=q"),
+    UINT64: struct.Struct("=Q"),
+    DOUBLE: struct.Struct("=d"),
+    POINTER: struct.Struct("=Q"),
+}
+INT_BITS = {
+    INT16: 16,
+    UINT16: 16,
+    INT32: 32,
+    UINT32: 32,
+    INT64: 64,
+    UINT64: 64,
+}
+SIGNED = {BOOL, CHAR, SCHAR, UCHAR, INT16, INT32, INT64}
+CHARS = {CHAR, SCHAR, UCHAR}
+
+HEADER = struct.Struct("=8sI")
+STRING_DEF = struct.Struct("=II")
+MESSAGE = struct.Struct("=BQIIIH")
+TEXT = struct.Struct("=BQIII")
+U8 = struct.Struct("=B")
+U32 = struct.Struct("=I")
+
+
+class Format:
+    """A conversion specification, as parsed by cp::Print."""
+
+    def __init__(self):
+        self.alternate = False
+        self.flush_left = False
+        self.print_sign = False
+        self.fill_zero = False
+        self.uppercase = False
+        self.base = 10
+        self.format = None
+        self.float_format = "g"
+        self.precision = -1
+        self.width = 0
+        self.get_precision = False
+        self.get_width = False
+
+
+def pad(text, width, fill, left):
+    if width <= len(text):
+        return text
+    if left:
+        return text + fill * (width - len(text))
+    return fill * (width - len(text)) + text
+
+
+def format_double(value, precision, conversion="g", uppercase=False):
+    """Stream a double, as printf would with the stream's precision."""
+
+    if math.isnan(value):
+        text = "-nan" if math.copysign(1, value) < 0 else "nan"
+    elif math.isinf(value):
+        text = "-inf" if value < 0 else "inf"
+    else:
+        text = f"%.{precision}{conversion}" % value
+    return text.upper() if uppercase else text
+
+
+def format_pointer(value):
+    return f"0x{value:x}" if value else "0"
+
+
+class Printer:
+    """Formats one message, like a cp::Print on a fresh ostringstream."""
+
+    def __init__(self, fmt):
+        self.fmt = fmt
+        self.pos = 0
+        self.cont = False
+        self.out = []
+        # the stream precision is only restored after the last argument
+        self.precision = 6
+        self.spec = Format()
+
+    def text(self, stop_at_spec):
+        fmt = self.fmt
+        while self.pos < len(fmt):
+            c = fmt[self.pos]
+            if c == "%":
+                if fmt[self.pos + 1 : self.pos + 2] != "%":
+                    if stop_at_spec:
+                        self.parse_spec()
+                        return
+                    self.out.append("<extra arg>")
+                self.out.append("%")
+                self.pos += 2
+            elif c == "\n":
+                self.out.append("\n")
+                self.pos += 1
+            elif c == "\r":
+                self.pos += 1
+                if fmt[self.pos : self.pos + 1] != "\n":
+                    self.out.append("\n")
+            else:
+                end = self.pos
+                while end < len(fmt) and fmt[end] not in "%\n\r":
+                    end += 1
+                self.out.append(fmt[self.pos : end])
+                self.pos = end
+
+    def parse_spec(self):
+        spec = self.spec
+        fmt = self.fmt
+        done = False
+        end_number = False
+        have_precision = False
+        number = 0
+
+        while not done:
+            self.pos += 1
+            c = fmt[self.pos] if self.pos < len(fmt) else "\0"
+            if "0" <= c <= "9":
+                if end_number:
+                    continue
+            elif number > 0:
+                end_number = True
+
+            if c == "s":
+                spec.format = "s"
+                done = True
+            elif c == "c":
+                spec.format = "c"
+                done = True
+            elif c == "l":
+                continue
+            elif c == "p":
+                spec.format = "i"
+                spec.base = 16
+                spec.alternate = True
+                done = True
+            elif c in "xX":
+                spec.uppercase = spec.uppercase or c == "X"
+                spec.base = 16
+                spec.format = "i"
+                done = True
+            elif c == "o":
+                spec.base = 8
+                spec.format = "i"
+                done = True
+            elif c in "diu":
+                spec.format = "i"
+                done = True
+            elif c in "gG":
+                spec.uppercase = spec.uppercase or c == "G"
+                spec.format = "f"
+                spec.float_format = "g"
+                done = True
+            elif c in "eE":
+                spec.uppercase = spec.uppercase or c == "E"
+                spec.format = "f"
+                spec.float_format = "e"
+                done = True
+            elif c == "f":
+                spec.format = "f"
+                spec.float_format = "f"
+                done = True
+            elif c == "n":
+                self.out.append("we don't do %n!!!\n")
+                done = True
+            elif c == "#":
+                spec.alternate = True
+            elif c == "-":
+                spec.flush_left = True
+            elif c == "+":
+                spec.print_sign = True
+            elif c == " ":
+                pass
+            elif c == ".":
+                spec.width = number
+                spec.precision = 0
+                have_precision = True
+                number = 0
+                end_number = False
+            elif c == "0" and number == 0:
+                spec.fill_zero = True
+            elif "0" <= c <= "9":
+                number = number * 10 + int(c)
+            elif c == "*":
+                if have_precision:
+                    spec.get_precision = True
+                else:
+                    spec.get_width = True
+            else:
+                done = True
+
+            if end_number:
+                if have_precision:
+                    spec.precision = number
+                else:
+                    spec.width = number
+                end_number = False
+                number = 0
+
+            if done:
+                if spec.format == "i" and have_precision:
+                    spec.width = spec.precision
+                    spec.fill_zero = True
+                elif (
+                    spec.format == "f"
+                    and not have_precision
+                    and spec.fill_zero
+                ):
+                    spec.precision = spec.width
+
+        self.pos += 1
+
+    def add(self, atype, value):
+        if not self.cont:
+            self.spec = Format()
+            self.text(True)
+
+        spec = self.spec
+        if spec.get_width:
+            spec.get_width = False
+            self.cont = True
+            spec.width = value if atype == INT32 else 0
+            return
+        if spec.get_precision:
+            spec.get_precision = False
+            self.cont = True
+            spec.precision = value if atype == INT32 else 0
+            return
+
+        if spec.format == "c":
+            self.format_char(atype, value)
+        elif spec.format == "i":
+            self.format_integer(atype, value)
+        elif spec.format == "f":
+            self.format_float(atype, value)
+        elif spec.format == "s":
+            self.format_string(atype, value)
+        else:
+            self.out.append("<bad format>")
+
+    def finish(self):
+        self.text(False)
+        return "".join(self.out)
+
+    def stream(self, atype, value, precision):
+        """What `out << value` gives with no formatting flags set."""
+
+        if atype in CHARS:
+            return chr(value & 0xFF)
+        if atype == DOUBLE:
+            return format_double(value, precision)
+        if atype == STRING:
+            return value
+        if atype == POINTER:
+            return format_pointer(value)
+        return str(int(value))
+
+    def format_char(self, atype, value):
+        if atype in INT_BITS or atype in CHARS:
+            self.out.append(chr(value & 0xFF))
+        else:
+            self.out.append("<bad arg type for char format>")
+
+    def format_integer(self, atype, value):
+        spec = self.spec
+        fill = " "
+        width = spec.width
+        prefix = ""
+        if spec.alternate and spec.fill_zero:
+            if spec.base == 16:
+                prefix = "0x"
+                width -= 2
+            elif spec.base == 8:
+                prefix = "0"
+                width -= 1
+        showbase = spec.alternate and not spec.fill_zero
+        if spec.fill_zero:
+            fill = "0"
+        left = spec.flush_left and not spec.fill_zero
+
+        if atype == DOUBLE:
+            text = format_double(
+                value, self.precision, uppercase=spec.uppercase
+            )
+            if spec.print_sign and not text.startswith("-"):
+                text = "+" + text
+        elif atype == STRING:
+            text = value
+        elif atype == POINTER:
+            text = format_pointer(value)
+        else:
+            text = self.integer_digits(atype, value, showbase)
+
+        self.out.append(prefix + pad(text, width, fill, left))
+
+    def integer_digits(self, atype, value, showbase):
+        spec = self.spec
+        bits = INT_BITS.get(atype, 32)
+        if atype in CHARS or atype == BOOL:
+            atype = INT32
+        if spec.base == 10:
+            if value < 0:
+                return "-" + str(-value)
+            sign = "+" if spec.print_sign and atype in SIGNED else ""
+            return sign + str(value)
+
+        # hex and octal show the two's complement of negative values
+        value &= (1 << bits) - 1
+        if spec.base == 16:
+            text = f"{value:x}"
+            if showbase and value:
+                text = "0x" + text
+        else:
+            text = f"{value:o}"
+            if showbase and value:
+                text = "0" + text
+        return text.upper() if spec.uppercase else text
+
+    def format_float(self, atype, value):
+        if atype != DOUBLE:
+            self.out.append("<bad arg type for float format>")
+            return
+
+        spec = self.spec
+        conversion = "g"
+        width = spec.width
+        if spec.float_format == "e":
+            if spec.precision != -1:
+                if spec.precision == 0:
+                    spec.precision = 1
+                else:
+                    conversion = "e"
+                self.precision = spec.precision
+        elif spec.float_format == "f":
+            if spec.precision != -1:
+                conversion = "f"
+                self.precision = spec.precision
+        elif spec.precision != -1:
+            self.precision = spec.precision
+
+        uppercase = spec.uppercase and spec.float_format == "e"
+        text = format_double(value, self.precision, conversion, uppercase)
+        fill = "0" if spec.fill_zero else " "
+        self.out.append(pad(text, width, fill, False))
+
+    def format_string(self, atype, value):
+        spec = self.spec
+        if spec.width > 0:
+            # measured with a fresh stream, with the default precision
+            text = self.stream(atype, value, 6)
+            if spec.width > len(text):
+                self.out.append(pad(text, spec.width, " ", spec.flush_left))
+                return
+        self.out.append(self.stream(atype, value, self.precision))
+
+
+class Reader:
+    def __init__(self, f):
+        self.f = f
+
+    def read(self, size):
+        data = self.f.read(size)
+        if len(data) != size:
+            raise ValueError("truncated trace")
+        return data
+
+    def unpack(self, st):
+        return st.unpack(self.read(st.size))
+
+    def string(self, length):
+        return self.read(length).decode("latin-1")
+
+
+def decode(path, out):
+    """Write the text of a binary trace to a text stream."""
+
+    with open(path, "rb") as f:
+        gzipped = f.read(2) == b"\x1f\x8b"
+    with (gzip.open if gzipped else open)(path, "rb") as f:
+        reader = Reader(f)
+        magic, version = reader.unpack(HEADER)
+        if magic != MAGIC:
+            raise ValueError(f"{path} is not a binary debug trace")
+        if version != VERSION:
+            raise ValueError(f"{path}: unsupported version {version}")
+
+        strings = {}
+        while True:
+            rtype = f.read(1)
+            if not rtype:
+                break
+            rtype = rtype[0]
+
+            if rtype == RECORD_STRING:
+                sid, length = reader.unpack(STRING_DEF)
+                strings[sid] = reader.string(length)
+                continue
+
+            if rtype == RECORD_MESSAGE:
+                fmt_bits, when, fmt_id, name_id, flag_id, nargs = (
+                    reader.unpack(MESSAGE)
+                )
+                printer = Printer(strings[fmt_id])
+                for _ in range(nargs):
+                    (atype,) = reader.unpack(U8)
+                    if atype == STRING:
+                        (length,) = reader.unpack(U32)
+                        value = reader.string(length)
+                    elif atype in ARG_STRUCTS:
+                        (value,) = reader.unpack(ARG_STRUCTS[atype])
+                    else:
+                        raise ValueError(f"{path}: bad argument {atype}")
+                    printer.add(atype, value)
+                message = printer.finish()
+            elif rtype == RECORD_TEXT:
+                fmt_bits, when, name_id, flag_id, length = reader.unpack(
+                    TEXT
+                )
+                message = reader.string(length)
+            else:
+                raise ValueError(f"{path}: unknown record type {rtype}")
+
+            name, flag = strings[name_id], strings[flag_id]
+            if not fmt_bits & FORMAT_TICKS_OFF and when != MAX_TICK:
+                out.write(f"{when:7d}: ")
+            if fmt_bits & FORMAT_SHOW_FLAG and flag:
+                out.write(f"{flag}: ")
+            if name:
+                out.write(f"{name}: ")
+            out.write(message)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert binary gem5 debug traces to text"
+    )
+    parser.add_argument("file", help="Binary debug trace")
+    parser.add_argument(
+        "-o", "--output", help="Text file to write (default: stdout)"
+    )
+    args = parser.parse_args()
+
+    if args.output:
+        with open(args.output, "w", encoding="latin-1", newline="") as out:
+            decode(args.file, out)
+    else:
+        out = open(
+            sys.stdout.fileno(), "w", encoding="latin-1", closefd=False
+        )
+        decode(args.file, out)
+        out.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Read columnar binary gem5 stat files.
+
+The simulator writes these files when a stats output is added with a
+bin:// URL, e.g. --stats-file=bin://stats.bin. The names of the stats
+are stored once and every dump is a row of doubles, see
+src/base/stats/columnar.hh for the layout.
+
+Usage:
+    stats_columnar.py stats.bin                # CSV on stdout
+    stats_columnar.py stats.bin -o stats.csv
+    stats_columnar.py --list stats.bin         # names and descriptions
+
+From Python, load() returns a pandas DataFrame with one row per dump:
+    from stats_columnar import load
+    df = load("m5out/stats.bin")
+"""
+
+import argparse
+import array
+import csv
+import struct
+import sys
+
+MAGIC = b"gem5stat"
+VERSION = 1
+HEADER = struct.Struct("=8sII")
+RECORD = struct.Struct("=IIQ")
+U32 = struct.Struct("=I")
+
+RECORD_SCHEMA = 1
+RECORD_ROW = 2
+RECORD_DELTA = 3
+
+
+def read(path):
+    """Iterate over the dumps in a file.
+
+    Yields a (names, descriptions, values) tuple per dump, where the
+    names and descriptions are shared by all dumps with the same
+    schema.
+    """
+
+    with open(path, "rb") as f:
+        data = f.read()
+
+    magic, version, _ = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError(f"{path} is not a columnar stat file")
+    if version != VERSION:
+        raise ValueError(f"{path}: unsupported version {version}")
+
+    names, descs = [], []
+    values = None
+    pos = HEADER.size
+    while pos < len(data):
+        rtype, _, size = RECORD.unpack_from(data, pos)
+        pos += RECORD.size
+        payload = memoryview(data)[pos : pos + size]
+        pos += size
+
+        if rtype == RECORD_SCHEMA:
+            (num_columns,) = U32.unpack_from(payload, 0)
+            offset = U32.size
+            names, descs = [], []
+            for _ in range(num_columns):
+                for strings in (names, descs):
+                    (length,) = U32.unpack_from(payload, offset)
+                    offset += U32.size
+                    strings.append(
+                        bytes(payload[offset : offset + length]).decode()
+                    )
+                    offset += length
+        elif rtype == RECORD_ROW:
+            values = array.array("d")
+            values.frombytes(payload)
+            if len(values) != len(names):
+                raise ValueError(f"{path}: row does not match its schema")
+            yield names, descs, values
+        elif rtype == RECORD_DELTA:
+            # only the columns that changed since the last dump are
+            # stored, after a bitmap of those columns
+            if values is None or len(values) != len(names):
+                raise ValueError(f"{path}: delta without a previous row")
+            values = array.array("d", values)
+            changed = array.array("d")
+            bitmap_size = (len(names) + 7) // 8
+            changed.frombytes(payload[bitmap_size:])
+            bitmap = payload[:bitmap_size]
+            next_value = 0
+            for byte_idx, byte in enumerate(bitmap):
+                while byte:
+                    bit = (byte & -byte).bit_length() - 1
+                    byte &= byte - 1
+                    values[byte_idx * 8 + bit] = changed[next_value]
+                    next_value += 1
+            yield names, descs, values
+        else:
+            raise ValueError(f"{path}: unknown record type {rtype}")
+
+
+def columns(path):
+    """Get the names of all the columns in a file, in order."""
+
+    seen = {}
+    for names, _, _ in read(path):
+        for name in names:
+            seen.setdefault(name, None)
+    return list(seen)
+
+
+def load(path):
+    """Load a file as a pandas DataFrame with one row per dump."""
+
+    import pandas as pd
+
+    rows = [dict(zip(names, values)) for names, _, values in read(path)]
+    return pd.DataFrame(rows, columns=columns(path))
+
+
+def write_csv(path, out):
+    header = columns(path)
+    writer = csv.writer(out)
+    writer.writerow(header)
+    for names, _, values in read(path):
+        row = dict(zip(names, values))
+        writer.writerow([row.get(name, "") for name in header])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert columnar gem5 stat files to CSV"
+    )
+    parser.add_argument("file", help="Columnar stat file")
+    parser.add_argument(
+        "-o", "--output", help="CSV file to write (default: stdout)"
+    )
+    parser.add_argument(
+        "--list",
+        action="store_true",
+        help="List the stats and their descriptions",
+    )
+    args = parser.parse_args()
+
+    if args.list:
+        listed = set()
+        for names, descs, _ in read(args.file):
+            for name, desc in zip(names, descs):
+                if name not in listed:
+                    listed.add(name)
+                    print(f"{name}\t{desc}" if desc else name)
+    elif args.output:
+        with open(args.output, "w", newline="") as out:
+            write_csv(args.file, out)
+    else:
+        write_csv(args.file, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()